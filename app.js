@@ -5,6 +5,7 @@
 class AppState {
     constructor() {
         this.wasmModule = null;
+        this.profilerModule = null;
         this.systemProfiler = null;
         this.currentProcessingMode = 'auto';
         this.apiConfig = {
@@ -14,6 +15,7 @@ class AppState {
         };
         this.fullInputData = null;
         this.fullResultsData = null;
+        this.wasmPackColumns = null;
         this.benchmarkResults = [];
         this.currentJobId = null;
         this.jobPollingInterval = null;
@@ -31,15 +33,12 @@ class SystemProfiler {
         this.batteryLevel = 1.0;
         this.isCharging = true;
         this.cpuScore = 0;
-        this.memoryBandwidth = 0;
+        this.costModel = null;
     }
 
     async initialize() {
         await this.initializeBatteryAPI();
         await this.runNetworkTest();
-        if (appState.wasmModule && appState.systemProfiler) {
-            this.runCPUMemoryTest();
-        }
     }
 
     async initializeBatteryAPI() {
@@ -117,65 +116,52 @@ class SystemProfiler {
 
     runCPUMemoryTest() {
         try {
+            // Plans a small calibration workload per strategy and fits the device cost model
             const results = appState.systemProfiler.profileSystem();
             this.cpuScore = results.cpuScore;
-            this.memoryBandwidth = results.memoryBandwidthMbps;
+            this.costModel = results.costModel;
         } catch (error) {
-            console.log(`CPU/Memory test failed: ${error.message}`);
-            this.cpuScore = 5; // Default fallback
-            this.memoryBandwidth = 1000;
+            console.log(`Planner calibration failed: ${error.message}`);
+            this.cpuScore = 0;
+            this.costModel = null;
         }
     }
 
-    calculateRecommendation() {
-        const weights = {
-            cpu: 0.3,
-            memory: 0.25,
-            networkLatency: 0.2,
-            networkBandwidth: 0.15,
-            battery: 0.1
+    calculateRecommendation(pending = null) {
+        const details = {
+            cpuScore: this.cpuScore,
+            networkLatency: this.networkLatency,
+            networkBandwidth: this.networkBandwidth,
+            batteryLevel: this.batteryLevel,
+            isCharging: this.isCharging
         };
 
-        const cpuNorm = Math.min(this.cpuScore / 10.0, 1.0);
-        const memoryNorm = Math.min(this.memoryBandwidth / 10000.0, 1.0);
-        const latencyNorm = Math.max(0, 1.0 - (this.networkLatency / 1000.0));
-        const bandwidthNorm = Math.min(this.networkBandwidth / 100.0, 1.0);
-        const batteryNorm = this.batteryLevel;
-
-        const overallScore =
-            cpuNorm * weights.cpu +
-            memoryNorm * weights.memory +
-            latencyNorm * weights.networkLatency +
-            bandwidthNorm * weights.networkBandwidth +
-            batteryNorm * weights.battery;
-
-        let decision;
-        if (overallScore > 0.7) {
-            decision = 'wasm';
-        } else if (overallScore > 0.4) {
-            decision = 'hybrid';
-        } else {
+        if (!appState.systemProfiler || !this.costModel) {
+            // Not calibrated yet (the profiler module loads after the planner): plan locally if possible
+            return { decision: appState.wasmModule ? 'hybrid' : 'api', confidence: 0.0, details: details };
+        }
+
+        // Without a pending request only the fixed costs are compared
+        const itemCount = pending ? pending.itemCount : 0;
+        const strategyType = pending ? pending.strategyType : 0;
+        const route = appState.systemProfiler.routePlan(
+            itemCount, strategyType, this.networkLatency, this.networkBandwidth);
+
+        let decision = { CLIENT_PREFERRED: 'wasm', SERVER_PREFERRED: 'api' }[route.recommendation] || 'hybrid';
+        // Spare a draining battery unless the client is clearly faster
+        if (decision === 'hybrid' && !this.isCharging && this.batteryLevel < 0.2) {
             decision = 'api';
         }
 
-        return {
-            decision: decision,
-            confidence: overallScore,
-            details: {
-                cpuScore: this.cpuScore,
-                memoryBandwidth: this.memoryBandwidth,
-                networkLatency: this.networkLatency,
-                networkBandwidth: this.networkBandwidth,
-                batteryLevel: this.batteryLevel,
-                isCharging: this.isCharging
-            }
-        };
+        details.predictedClientMs = route.predictedClientMs;
+        details.predictedServerMs = route.predictedServerMs;
+        details.itemCount = itemCount;
+        return { decision: decision, confidence: route.confidenceScore, details: details };
     }
 
     getProfileSummary() {
         return {
             cpuScore: this.cpuScore.toFixed(2),
-            memoryBandwidth: this.memoryBandwidth.toFixed(2),
             networkLatency: this.networkLatency.toFixed(2),
             networkBandwidth: this.networkBandwidth.toFixed(2),
             batteryLevel: (this.batteryLevel * 100).toFixed(1),
@@ -188,23 +174,70 @@ const systemProfiler = new SystemProfiler();
 
 // WASM Module Loader
 class WASMLoader {
+    // Smallest module using a v128 instruction; validate() fails without SIMD support
+    static supportsSimd() {
+        try {
+            return WebAssembly.validate(new Uint8Array([
+                0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0,
+                10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+            ]));
+        } catch {
+            return false;
+        }
+    }
+
     static async loadModule() {
         try {
             updateStatus('Loading WASM module...', 'loading');
             
-            const wasmModule = await import('./pack_planner_wasm.js');
+            // Prefer the SIMD128 build when the engine can validate SIMD code
+            const moduleUrl = WASMLoader.supportsSimd()
+                ? './pack_planner_wasm_simd.js'
+                : './pack_planner_wasm.js';
+            let wasmModule;
+            try {
+                wasmModule = await import(moduleUrl);
+            } catch (error) {
+                // The SIMD variant is optional at build time
+                console.warn(`Falling back to scalar WASM module: ${error.message}`);
+                wasmModule = await import('./pack_planner_wasm.js');
+            }
             appState.wasmModule = await wasmModule.default();
-            appState.systemProfiler = new appState.wasmModule.SystemProfiler();
+
+            // Parallel plans need SharedArrayBuffer (cross-origin isolation)
+            if (self.crossOriginIsolated) {
+                appState.wasmModule.prewarmWorkers();
+            }
             
-            console.log('WASM module loaded successfully');
+            console.log(`WASM module loaded successfully (SIMD128: ${appState.wasmModule.simdEnabled()})`);
             return true;
         } catch (error) {
             console.error('WASM loading error:', error);
             return false;
         }
     }
+
+    // Load the profiler/benchmark module once, on first use
+    static loadProfiler() {
+        if (!WASMLoader.profilerPromise) {
+            WASMLoader.profilerPromise = import('./pack_planner_profiler.js')
+                .then(profilerModule => profilerModule.default())
+                .then(instance => {
+                    appState.profilerModule = instance;
+                    appState.systemProfiler = new instance.SystemProfiler();
+                    return instance;
+                })
+                .catch(error => {
+                    WASMLoader.profilerPromise = null;
+                    throw error;
+                });
+        }
+        return WASMLoader.profilerPromise;
+    }
 }
 
+WASMLoader.profilerPromise = null;
+
 // API Client
 class APIClient {
     static async testConnection() {
@@ -264,7 +297,8 @@ class APIClient {
                 weight: item[3]
             })),
             configuration: {
-                sortOrder: ['NATURAL', 'SHORT_TO_LONG', 'LONG_TO_SHORT'][parseInt(sortOrder)],
+                sortOrder: ['NATURAL', 'SHORT_TO_LONG', 'LONG_TO_SHORT', 'HEAVY_TO_LIGHT',
+                            'SHORT_TO_LONG_HEAVY_FIRST', 'LONG_TO_SHORT_HEAVY_FIRST'][parseInt(sortOrder)],
                 maxItemsPerPack: maxItems,
                 maxWeightPerPack: maxWeight,
                 strategyType: parseInt(strategyType) === 0 ? 'BLOCKING' : 'PARALLEL',
@@ -332,7 +366,7 @@ class APIClient {
 
 // WASM Client
 class WASMClient {
-    static runPacking() {
+    static readPackingInput() {
         const maxItems = parseInt(document.getElementById('maxItems').value);
         const maxWeight = parseFloat(document.getElementById('maxWeight').value);
         const sortOrder = parseInt(document.getElementById('sortOrder').value);
@@ -347,35 +381,156 @@ class WASMClient {
             items = JSON.parse(itemsText);
         }
 
+        return { items, maxItems, maxWeight, sortOrder, strategyType, threadCount };
+    }
+
+    static runPacking() {
+        const { items, maxItems, maxWeight, sortOrder, strategyType, threadCount } = this.readPackingInput();
+
         const planner = new appState.wasmModule.PackPlanner();
-        
-        // Get planning stats
-        const stats = planner.getPlanningStats(
-            items, maxItems, maxWeight, sortOrder, strategyType, threadCount
-        );
+        const { ids, lengths, quantities, weights } = this.toItemColumns(items);
 
-        // Get packed results
-        const packedResults = planner.packItems(
-            items, maxItems, maxWeight, sortOrder, strategyType, threadCount
+        // Plan once: stats plus the packs as typed-array columns over WASM memory
+        const planned = planner.planColumnar(
+            ids, lengths, quantities, weights, maxItems, maxWeight, sortOrder, strategyType, threadCount
         );
+        const result = this.copyPlan(planned);
 
         // Clean up
         planner.delete();
 
-        return { stats, packedResults };
+        return result;
     }
 
-    static runBenchmark(size, sortOrder, strategy, threads) {
-        const planner = new appState.wasmModule.PackPlanner();
-        const result = planner.runBenchmark(size, sortOrder, strategy, threads);
-        planner.delete();
+    // Plan in ~frame-sized slices so the page keeps rendering during large plans
+    static async runPackingSliced(onProgress) {
+        const { items, maxItems, maxWeight, sortOrder } = this.readPackingInput();
+        const { ids, lengths, quantities, weights } = this.toItemColumns(items);
+
+        const buffer = new appState.wasmModule.ItemBuffer();
+        buffer.assign(ids, lengths, quantities, weights);
+        const session = new appState.wasmModule.PlanningSession(buffer, maxItems, maxWeight, sortOrder);
+        buffer.delete();
+
+        try {
+            let status;
+            do {
+                status = session.step(WASMClient.SLICE_BUDGET_MS);
+                onProgress(status.progress);
+                await new Promise(resolve => requestAnimationFrame(resolve));
+            } while (!status.done);
+
+            return this.copyPlan(session.result());
+        } finally {
+            session.delete();
+        }
+    }
+
+    // Plan on the WASM worker pool; the main thread only polls once per frame
+    static async runPackingInBackground() {
+        const { items, maxItems, maxWeight, sortOrder, strategyType, threadCount } = this.readPackingInput();
+        const { ids, lengths, quantities, weights } = this.toItemColumns(items);
+
+        const buffer = new appState.wasmModule.ItemBuffer();
+        buffer.assign(ids, lengths, quantities, weights);
+        const job = new appState.wasmModule.BackgroundPlan(
+            buffer, maxItems, maxWeight, sortOrder, strategyType, threadCount
+        );
+        buffer.delete();
+
+        try {
+            while (!job.isDone()) {
+                await new Promise(resolve => requestAnimationFrame(resolve));
+            }
+            return this.copyPlan(job.result());
+        } finally {
+            job.delete();
+        }
+    }
+
+    // The views die with the planner/session, so take one bulk copy of each column
+    static copyPlan(planned) {
+        const stats = {
+            sortingTime: planned.sortingTime,
+            packingTime: planned.packingTime,
+            totalTime: planned.totalTime,
+            totalItems: planned.totalItems,
+            utilizationPercent: planned.utilizationPercent,
+            strategyName: planned.strategyName,
+            packCount: planned.packCount
+        };
+
+        const packs = {
+            count: planned.packCount,
+            offsets: planned.packOffsets.slice(),
+            numbers: planned.packNumbers.slice(),
+            lengths: planned.packLengths.slice(),
+            weights: planned.packWeights.slice(),
+            itemIds: planned.itemIds.slice(),
+            itemLengths: planned.itemLengths.slice(),
+            itemQuantities: planned.itemQuantities.slice(),
+            itemWeights: planned.itemWeights.slice()
+        };
+
+        return { stats, packs };
+    }
+
+    // Format pack i of the columnar result like pack::to_string()
+    static formatPack(packs, i) {
+        const lines = [`Pack Number: ${packs.numbers[i]}`];
+        for (let k = packs.offsets[i]; k < packs.offsets[i + 1]; k++) {
+            lines.push(`${packs.itemIds[k]},${packs.itemLengths[k]},${packs.itemQuantities[k]},${packs.itemWeights[k].toFixed(3)}`);
+        }
+        lines.push(`Pack Length: ${packs.lengths[i]}, Pack Weight: ${packs.weights[i].toFixed(2)}`);
+        return lines.join('\n');
+    }
+
+    // Split [[id, length, quantity, weight], ...] rows into typed-array columns
+    static toItemColumns(items) {
+        const count = items.length;
+        const ids = new Int32Array(count);
+        const lengths = new Int32Array(count);
+        const quantities = new Int32Array(count);
+        const weights = new Float64Array(count);
+        for (let i = 0; i < count; i++) {
+            const row = items[i];
+            ids[i] = row[0];
+            lengths[i] = row[1];
+            quantities[i] = row[2];
+            weights[i] = row[3];
+        }
+        return { ids, lengths, quantities, weights };
+    }
+
+    static async runBenchmark(size, sortOrder, strategy, threads) {
+        const profiler = await WASMLoader.loadProfiler();
+        const bench = new profiler.Benchmark();
+        const result = bench.runBenchmark(size, sortOrder, strategy, threads);
+        bench.delete();
         return result;
     }
 }
 
+// Inputs above this size are planned in time slices on the main thread
+WASMClient.SLICED_THRESHOLD = 100000;
+WASMClient.SLICE_BUDGET_MS = 12;
+
 // Processing Mode Manager
 class ProcessingModeManager {
-    static async determineProcessingMode() {
+    // Size and strategy of the request about to be planned, for cost-based routing
+    static pendingRequest() {
+        let itemCount = appState.fullInputData ? appState.fullInputData.length : 0;
+        if (itemCount === 0) {
+            try {
+                itemCount = JSON.parse(document.getElementById('itemsInput').value.trim()).length || 0;
+            } catch (e) {
+                itemCount = 0;
+            }
+        }
+        return { itemCount, strategyType: parseInt(document.getElementById('strategyType').value) };
+    }
+
+    static async determineProcessingMode(pending = null) {
         const selectedMode = document.querySelector('input[name="processingMode"]:checked').value;
         
         if (selectedMode === 'wasm') {
@@ -384,7 +539,7 @@ class ProcessingModeManager {
             return 'api';
         } else {
             // Auto mode - use profiler
-            const recommendation = systemProfiler.calculateRecommendation();
+            const recommendation = systemProfiler.calculateRecommendation(pending);
             appState.systemProfile = recommendation;
             
             // Update UI with profiler results
@@ -406,11 +561,11 @@ class ProcessingModeManager {
         const profile = systemProfiler.getProfileSummary();
         
         profilerOutput.innerHTML = `
-            <div><strong>CPU Score:</strong> ${profile.cpuScore} MOPS</div>
-            <div><strong>Memory Bandwidth:</strong> ${profile.memoryBandwidth} MB/s</div>
+            <div><strong>Planning Throughput:</strong> ${profile.cpuScore} M items/s</div>
             <div><strong>Network Latency:</strong> ${profile.networkLatency} ms</div>
             <div><strong>Network Bandwidth:</strong> ${profile.networkBandwidth} MB/s</div>
             <div><strong>Battery:</strong> ${profile.batteryLevel}% ${profile.isCharging ? '(charging)' : '(not charging)'}</div>
+            ${recommendation.details.predictedClientMs !== undefined ? `<div><strong>Predicted (${recommendation.details.itemCount.toLocaleString()} items):</strong> WASM ${recommendation.details.predictedClientMs.toFixed(1)} ms, server ${recommendation.details.predictedServerMs.toFixed(1)} ms</div>` : ''}
             <div><strong>Recommendation:</strong> ${recommendation.decision.toUpperCase()}</div>
             <div><strong>Confidence:</strong> ${(recommendation.confidence * 100).toFixed(1)}%</div>
         `;
@@ -577,6 +732,16 @@ function downloadInputData() {
 }
 
 function downloadResults() {
+    // WASM results stay columnar until a download actually needs the text
+    if (appState.wasmPackColumns) {
+        const packs = appState.wasmPackColumns;
+        appState.fullResultsData = [];
+        for (let i = 0; i < packs.count; i++) {
+            appState.fullResultsData.push(`Pack ${i + 1}:\n${WASMClient.formatPack(packs, i)}`);
+        }
+        appState.wasmPackColumns = null;
+    }
+
     if (!appState.fullResultsData || appState.fullResultsData.length === 0) {
         alert('No full results data available to download');
         return;
@@ -597,15 +762,13 @@ function downloadResults() {
 // Result Display Functions
 function displayWASMResults(result, processingTime) {
     const resultsEl = document.getElementById('results');
-    const { stats, packedResults } = result;
+    const { stats, packs } = result;
 
-    if (packedResults && packedResults.size() > 0) {
-        appState.fullResultsData = [];
-        for (let i = 0; i < packedResults.size(); i++) {
-            appState.fullResultsData.push(`Pack ${i + 1}:\n${packedResults.get(i)}`);
-        }
+    if (packs && packs.count > 0) {
+        appState.fullResultsData = null;
+        appState.wasmPackColumns = packs;
 
-        const totalPacks = packedResults.size();
+        const totalPacks = packs.count;
         const packsToShow = Math.min(100, totalPacks);
 
         let summaryHtml = `
@@ -637,7 +800,7 @@ function displayWASMResults(result, processingTime) {
         for (let i = 0; i < packsToShow; i++) {
             const packDiv = document.createElement('div');
             packDiv.className = 'pack';
-            const packData = packedResults.get(i);
+            const packData = WASMClient.formatPack(packs, i);
             packDiv.innerHTML = `<strong>Pack ${i + 1}:</strong><br>${packData}`;
             resultsEl.appendChild(packDiv);
         }
@@ -662,6 +825,7 @@ function displayAPIResults(result, processingTime) {
     const resultsEl = document.getElementById('results');
 
     if (result.success && result.packs && result.packs.length > 0) {
+        appState.wasmPackColumns = null;
         const totalPacks = result.packs.length;
         const packsToShow = Math.min(100, totalPacks);
 
@@ -786,7 +950,7 @@ async function runPacking() {
         updateStatus('Determining processing mode...', 'loading');
         await new Promise(resolve => setTimeout(resolve, 100));
 
-        const processingMode = await ProcessingModeManager.determineProcessingMode();
+        const processingMode = await ProcessingModeManager.determineProcessingMode(ProcessingModeManager.pendingRequest());
         ProcessingModeManager.updateCurrentModeDisplay(processingMode);
 
         updateStep(3, 'complete');
@@ -801,7 +965,21 @@ async function runPacking() {
                 throw new Error('WASM module not available');
             }
             updateStatus('Processing with WASM...', 'loading');
-            const result = WASMClient.runPacking();
+            const inputCount = appState.fullInputData ? appState.fullInputData.length : 0;
+            const strategyType = parseInt(document.getElementById('strategyType').value);
+            let result;
+            if (strategyType === 1 && self.crossOriginIsolated) {
+                // Parallel plans run on the pre-warmed worker pool
+                result = await WASMClient.runPackingInBackground();
+            } else if (inputCount > WASMClient.SLICED_THRESHOLD) {
+                // Large blocking plans are sliced so the page stays responsive
+                result = await WASMClient.runPackingSliced(progress => {
+                    updateProgress(60 + progress * 40);
+                    updateStatus(`Processing with WASM... ${(progress * 100).toFixed(0)}%`, 'loading');
+                });
+            } else {
+                result = WASMClient.runPacking();
+            }
             const endTime = performance.now();
             
             updateStep(4, 'complete');
@@ -969,12 +1147,12 @@ async function runSingleBenchmark() {
         const strategy = parseInt(document.getElementById('benchStrategy').value);
         const threads = parseInt(document.getElementById('benchThreads').value);
 
-        const processingMode = await ProcessingModeManager.determineProcessingMode();
+        const processingMode = await ProcessingModeManager.determineProcessingMode({ itemCount: size, strategyType: strategy });
         const startTime = performance.now();
 
         let result;
         if (processingMode === 'wasm' && appState.wasmModule) {
-            result = WASMClient.runBenchmark(size, sortOrder, strategy, threads);
+            result = await WASMClient.runBenchmark(size, sortOrder, strategy, threads);
             result.processingMode = 'WASM';
         } else {
             const config = {
@@ -1030,7 +1208,7 @@ async function runFullBenchmark() {
             for (const sortOrder of sortOrders) {
                 for (const strategy of strategies) {
                     const threads = strategy === 0 ? 1 : 4;
-                    const processingMode = await ProcessingModeManager.determineProcessingMode();
+                    const processingMode = await ProcessingModeManager.determineProcessingMode({ itemCount: size, strategyType: strategy });
 
                     benchStatusEl.innerHTML = `<div class="spinner"></div>Running benchmark ${completedTests + 1}/${totalTests}: ${size.toLocaleString()} items, ${strategy === 0 ? 'Blocking' : 'Parallel'}, ${sortOrder === 0 ? 'Natural' : sortOrder === 1 ? 'Short-to-Long' : 'Long-to-Short'} (${processingMode.toUpperCase()})`;
 
@@ -1040,7 +1218,7 @@ async function runFullBenchmark() {
                     let result;
 
                     if (processingMode === 'wasm' && appState.wasmModule) {
-                        result = WASMClient.runBenchmark(size, sortOrder, strategy, threads);
+                        result = await WASMClient.runBenchmark(size, sortOrder, strategy, threads);
                         result.processingMode = 'WASM';
                     } else {
                         const config = {
@@ -1170,8 +1348,12 @@ async function initializeApplication() {
     const wasmLoaded = await WASMLoader.loadModule();
     
     if (wasmLoaded) {
-        // Run CPU/Memory tests now that WASM is loaded
-        systemProfiler.runCPUMemoryTest();
+        // Calibrate routing once the page is usable; the first plan does not wait for it
+        setTimeout(() => {
+            WASMLoader.loadProfiler()
+                .then(() => systemProfiler.runCPUMemoryTest())
+                .catch(error => console.log(`Profiler module unavailable: ${error.message}`));
+        }, 0);
     }
 
     // Test API connection if needed
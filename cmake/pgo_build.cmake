@@ -0,0 +1,151 @@
+# Two-stage profile-guided optimization build, run by the `pgo` target:
+#   1. configure BINARY_DIR with PACK_PLANNER_PGO=GENERATE and build pack_planner
+#   2. run the training workloads (benchmark profiles and the sample manifest)
+#   3. reconfigure the same directory with PACK_PLANNER_PGO=USE and rebuild
+#   4. benchmark the PGO binary against the regular build (BASELINE)
+#
+# Both stages share one build directory because GCC keys profile files by the
+# path of the object they belong to.
+#
+# Inputs (-D): SOURCE_DIR, BINARY_DIR, BASELINE, GENERATOR, BUILD_TYPE,
+# CXX_COMPILER, CXX_COMPILER_ID, CXX_FLAGS, CLI11_DIR, TRAIN_MAX_SIZE,
+# COMPARE_MAX_SIZE, COMPARE_RUNS
+
+cmake_minimum_required(VERSION 3.20)
+
+set(PROFILE_DIR "${BINARY_DIR}/profiles")
+set(PGO_BINARY "${BINARY_DIR}/pack_planner")
+
+function(run_step description)
+    message(STATUS "[pgo] ${description}")
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result OUTPUT_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "[pgo] ${description} failed (${result})")
+    endif()
+endfunction()
+
+function(build_stage stage)
+    set(configure_args
+        -S "${SOURCE_DIR}" -B "${BINARY_DIR}" -G "${GENERATOR}"
+        "-DCMAKE_BUILD_TYPE=${BUILD_TYPE}"
+        "-DCMAKE_CXX_COMPILER=${CXX_COMPILER}"
+        "-DCMAKE_CXX_FLAGS=${CXX_FLAGS}"
+        "-DPACK_PLANNER_PGO=${stage}"
+        "-DPACK_PLANNER_PGO_DIR=${PROFILE_DIR}")
+    if(CLI11_DIR)
+        list(APPEND configure_args "-DFETCHCONTENT_SOURCE_DIR_CLI11=${CLI11_DIR}")
+    endif()
+    run_step("Configuring ${stage} stage" ${CMAKE_COMMAND} ${configure_args})
+    run_step("Building ${stage} stage" ${CMAKE_COMMAND} --build "${BINARY_DIR}" --target pack_planner --parallel)
+endfunction()
+
+# Stage 1: instrumented build and training
+file(REMOVE_RECURSE "${PROFILE_DIR}")
+file(MAKE_DIRECTORY "${PROFILE_DIR}")
+build_stage(GENERATE)
+
+run_step("Training: benchmark up to ${TRAIN_MAX_SIZE} items"
+         "${PGO_BINARY}" --benchmark --benchmark-max-size ${TRAIN_MAX_SIZE})
+foreach(strategy bff pff)
+    run_step("Training: sample manifest (${strategy})"
+             "${PGO_BINARY}" -f "${SOURCE_DIR}/input.txt" -s ${strategy} --validate)
+endforeach()
+
+if(CXX_COMPILER_ID MATCHES "Clang")
+    get_filename_component(compiler_dir "${CXX_COMPILER}" DIRECTORY)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata HINTS "${compiler_dir}")
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "[pgo] llvm-profdata not found; it is needed to merge Clang profiles")
+    endif()
+    file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+    run_step("Merging profiles" "${LLVM_PROFDATA}" merge "-output=${PROFILE_DIR}/default.profdata" ${raw_profiles})
+endif()
+
+# Stage 2: optimized rebuild from the profiles
+build_stage(USE)
+
+# Comparison: best total per benchmark row over COMPARE_RUNS alternating runs.
+# Totals are parsed as integer microseconds (the benchmark prints ms with 3 decimals).
+function(collect_totals binary prefix)
+    execute_process(COMMAND "${binary}" --benchmark --benchmark-max-size ${COMPARE_MAX_SIZE}
+                    OUTPUT_VARIABLE output RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "[pgo] Benchmark run of ${binary} failed (${result})")
+    endif()
+    string(REPLACE ";" "," output "${output}")
+    string(REPLACE "\n" ";" lines "${output}")
+    set(section "")
+    set(keys "")
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^Strategy: ([^(,]+).*Order: ([A-Z]+)")
+            string(STRIP "${CMAKE_MATCH_1}" name)
+            set(section "${name} ${CMAKE_MATCH_2}")
+        elseif(line MATCHES "^([0-9]+) +[0-9.]+ +[0-9.]+ +([0-9]+)\\.([0-9][0-9][0-9])")
+            set(key "${section}|${CMAKE_MATCH_1}")
+            math(EXPR us "${CMAKE_MATCH_2} * 1000 + 1${CMAKE_MATCH_3} - 1000")
+            string(MAKE_C_IDENTIFIER "${prefix}_${key}" var)
+            if(NOT DEFINED ${var} OR us LESS ${var})
+                set(${var} ${us} PARENT_SCOPE)
+                set(${var} ${us})
+            endif()
+            list(APPEND keys "${key}")
+        endif()
+    endforeach()
+    set(benchmark_keys "${keys}" PARENT_SCOPE)
+endfunction()
+
+message(STATUS "[pgo] Comparing against ${BASELINE} (${COMPARE_RUNS} runs, up to ${COMPARE_MAX_SIZE} items)")
+foreach(run RANGE 1 ${COMPARE_RUNS})
+    collect_totals("${BASELINE}" base)
+    collect_totals("${PGO_BINARY}" pgo)
+endforeach()
+
+# Microseconds as "ms.t", and a relative change as "+x.y%"
+function(format_ms us out)
+    math(EXPR whole "${us} / 1000")
+    math(EXPR tenth "${us} % 1000 / 100")
+    set(${out} "${whole}.${tenth}" PARENT_SCOPE)
+endfunction()
+
+function(format_change base pgo out)
+    math(EXPR permille "(${pgo} - ${base}) * 1000 / (${base} + 1)")
+    set(sign "+")
+    if(permille LESS 0)
+        set(sign "-")
+        math(EXPR permille "-${permille}")
+    endif()
+    math(EXPR whole "${permille} / 10")
+    math(EXPR tenth "${permille} % 10")
+    set(${out} "${sign}${whole}.${tenth}%" PARENT_SCOPE)
+endfunction()
+
+set(base_sum 0)
+set(pgo_sum 0)
+message("")
+string(SUBSTRING "Benchmark row (best of ${COMPARE_RUNS})                                  " 0 51 header)
+message("${header}Baseline(ms)  PGO(ms)     Change")
+message("------------------------------------------------------------------------------------")
+foreach(key IN LISTS benchmark_keys)
+    string(MAKE_C_IDENTIFIER "base_${key}" base_var)
+    string(MAKE_C_IDENTIFIER "pgo_${key}" pgo_var)
+    set(base ${${base_var}})
+    set(pgo ${${pgo_var}})
+    math(EXPR base_sum "${base_sum} + ${base}")
+    math(EXPR pgo_sum "${pgo_sum} + ${pgo}")
+
+    string(REPLACE "|" " @ " label "${key}")
+    string(SUBSTRING "${label}                                                  " 0 50 label)
+    format_ms(${base} base_ms)
+    format_ms(${pgo} pgo_ms)
+    format_change(${base} ${pgo} change)
+    string(SUBSTRING "${base_ms}              " 0 14 base_col)
+    string(SUBSTRING "${pgo_ms}            " 0 12 pgo_col)
+    message("${label} ${base_col}${pgo_col}${change}")
+endforeach()
+format_ms(${base_sum} base_ms)
+format_ms(${pgo_sum} pgo_ms)
+format_change(${base_sum} ${pgo_sum} change)
+message("------------------------------------------------------------------------------------")
+message("Total: baseline ${base_ms} ms, PGO ${pgo_ms} ms (${change})")
+message("")
+message(STATUS "[pgo] Optimized binary: ${PGO_BINARY}")
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <climits>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "pack_planner.h"
+#include "pack_spill.h"
+#include "planning_session.h"
+#include "timer.h"
+
+/**
+ * @brief A hostile planning request with the cost it must stay within
+ *
+ * Each case targets one way an input can push the next-fit loops into their
+ * safety limits (iteration cap, pack cap) or into overflow-prone arithmetic.
+ * The ceilings hold for optimized builds on ordinary hardware, with a wide
+ * margin; they exist to catch unbounded behaviour, not small regressions.
+ */
+struct adversarial_case {
+    std::string name;
+    std::string description;
+    pack_planner_config config;
+    std::vector<item> items;
+    double time_ceiling_ms;             // per plan, any engine
+    std::size_t memory_ceiling_bytes;   // packs held in memory by the result
+};
+
+/**
+ * @brief Ways of running a request that each case is checked on
+ */
+enum class adversarial_engine {
+    BLOCKING,    // pack_planner, blocking strategy
+    PARALLEL,    // pack_planner, parallel strategy with 8 threads
+    SPILLING,    // pack_planner, blocking strategy with a 1 MiB memory budget
+    SESSION      // planning_session in 1 ms steps
+};
+
+inline const char* adversarial_engine_name(adversarial_engine engine) noexcept {
+    switch (engine) {
+        case adversarial_engine::BLOCKING: return "blocking";
+        case adversarial_engine::PARALLEL: return "parallel";
+        case adversarial_engine::SPILLING: return "spilling";
+        case adversarial_engine::SESSION: return "session";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Measured cost of one case on one engine
+ */
+struct adversarial_run {
+    double elapsed_ms = 0.0;
+    std::size_t pack_count = 0;       // including spilled packs
+    std::size_t memory_bytes = 0;     // in-memory packs only
+    long long packed_units = 0;       // in-memory packs only
+
+    [[nodiscard]] bool within(const adversarial_case& c, double time_scale = 1.0) const noexcept {
+        return elapsed_ms <= c.time_ceiling_ms * time_scale && memory_bytes <= c.memory_ceiling_bytes;
+    }
+};
+
+/**
+ * @brief Build the adversarial manifests
+ * @return std::vector<adversarial_case> Cases, each with its ceilings
+ */
+inline std::vector<adversarial_case> adversarial_cases() {
+    constexpr int N = 100000;
+    constexpr std::size_t MiB = 1024 * 1024;
+    std::vector<adversarial_case> cases;
+
+    auto add = [&](std::string name, std::string description, int max_items, double max_weight,
+                   double time_ceiling_ms, std::size_t memory_ceiling_bytes, auto&& make_item, int count) {
+        adversarial_case c;
+        c.name = std::move(name);
+        c.description = std::move(description);
+        c.config.max_items_per_pack = max_items;
+        c.config.max_weight_per_pack = max_weight;
+        c.config.order = sort_order::SHORT_TO_LONG;
+        c.time_ceiling_ms = time_ceiling_ms;
+        c.memory_ceiling_bytes = memory_ceiling_bytes;
+        c.items.reserve(count);
+        for (int i = 0; i < count; ++i) c.items.push_back(make_item(i));
+        cases.push_back(std::move(c));
+    };
+
+    add("one-per-pack-huge-quantity", "max_items_per_pack = 1 and one item of 10M units",
+        1, 200.0, 50.0, 1 * MiB,
+        [](int i) { return item(i + 1, 100, 10000000, 1.0); }, 1);
+    add("one-per-pack-many-items", "max_items_per_pack = 1 and 100k items of 1000 units",
+        1, 200.0, 250.0, 4 * MiB,
+        [](int i) { return item(i + 1, i % 5000, 1000, 1.0); }, N);
+    add("weight-just-above-max", "every unit weighs the next double above max_weight",
+        100, 200.0, 250.0, 1 * MiB,
+        [](int i) { return item(i + 1, i % 5000, 50, std::nextafter(200.0, 1e9)); }, N);
+    add("weight-just-below-max", "every unit weighs the next double below max_weight",
+        100, 200.0, 250.0, 4 * MiB,
+        [](int i) { return item(i + 1, i % 5000, 50, std::nextafter(200.0, 0.0)); }, N);
+    add("zero-weight", "weightless units, so only the unit limit applies",
+        100, 200.0, 250.0, 4 * MiB,
+        [](int i) { return item(i + 1, i % 5000, 100, 0.0); }, N);
+    add("int-max-quantity", "INT_MAX units per item with max_items_per_pack = INT_MAX",
+        INT_MAX, 200.0, 50.0, 1 * MiB,
+        [](int i) { return item(i + 1, i, INT_MAX, 0.0); }, 1000);
+    add("tiny-weight-huge-quantity", "1e-9 weight and INT_MAX - 1 units: quotients beyond INT_MAX",
+        100, 200.0, 50.0, 1 * MiB,
+        [](int i) { return item(i + 1, i, INT_MAX - 1, 1e-9); }, 1000);
+    add("negative-and-degenerate-fields", "negative lengths, quantities and weights mixed in",
+        100, 200.0, 250.0, 4 * MiB,
+        [](int i) { return item(i + 1, (i % 7) - 3, (i % 11) - 4, (i % 5) - 2.0); }, N);
+
+    return cases;
+}
+
+/**
+ * @brief Plan one case on one engine and measure it
+ * @param c Case to run
+ * @param engine Engine to run it on
+ * @return adversarial_run Time, packs and memory of the result
+ */
+inline adversarial_run run_adversarial_case(const adversarial_case& c, adversarial_engine engine) {
+    pack_planner_config config = c.config;
+    config.type = engine == adversarial_engine::PARALLEL ? strategy_type::PARALLEL_FIRST_FIT
+                                                         : strategy_type::BLOCKING_FIRST_FIT;
+    config.thread_count = 8;
+    if (engine == adversarial_engine::SPILLING) config.memory_budget_bytes = 1024 * 1024;
+
+    pack_planner_result result;
+    timer run_timer;
+    run_timer.start();
+    if (engine == adversarial_engine::SESSION) {
+        planning_session session(config, c.items);
+        while (!session.step(1.0)) {}
+        result = session.result();
+    } else {
+        pack_planner planner;
+        result = planner.plan_packs(config, c.items);
+    }
+
+    adversarial_run run;
+    run.elapsed_ms = run_timer.stop();
+    run.pack_count = result.pack_count();
+    for (const auto& p : result.packs) {
+        run.memory_bytes += pack_spill::memory_footprint(p);
+        run.packed_units += p.get_total_items();
+    }
+    return run;
+}
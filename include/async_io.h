@@ -0,0 +1,115 @@
+#pragma once
+
+#include <streambuf>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace detail { class io_ring; }
+
+/**
+ * @brief Double-buffered input stream buffer over a file descriptor
+ *
+ * While the caller consumes one buffer, the read for the next one is already
+ * in flight (through io_uring on Linux), so parsing overlaps with disk or pipe
+ * I/O. Works for regular files as well as pipes, which cannot be mmapped.
+ * Prefetching stops at the first blank line (the end of a manifest), so a
+ * pipe whose writer stays open does not keep a read pending; reading past
+ * it still works, on demand.
+ * Falls back to plain blocking read(2) when io_uring is unavailable.
+ */
+class async_input_buffer : public std::streambuf {
+public:
+    /**
+     * @brief Construct a new async input buffer
+     * @param fd File descriptor to read from (not owned, not closed)
+     * @param buffer_size Size of each of the two buffers in bytes
+     */
+    explicit async_input_buffer(int fd, std::size_t buffer_size = 1 << 20);
+    ~async_input_buffer() override;
+
+    async_input_buffer(const async_input_buffer&) = delete;
+    async_input_buffer& operator=(const async_input_buffer&) = delete;
+
+    /**
+     * @brief Check whether reads are issued through io_uring
+     * @return bool True if io_uring is in use, false for the blocking fallback
+     */
+    [[nodiscard]] bool uses_io_uring() const noexcept { return m_ring != nullptr; }
+
+    /**
+     * @brief Check whether a read failed (as opposed to a clean end of file)
+     * @return bool True if an I/O error ended the stream
+     */
+    [[nodiscard]] bool has_error() const noexcept { return m_error; }
+
+protected:
+    int_type underflow() override;
+
+private:
+    void submit_read(int slot);
+    [[nodiscard]] long wait_read();
+
+    int m_fd;
+    std::vector<char> m_buffers[2];
+    int m_pending_slot = -1;     // buffer with a read in flight, -1 if none
+    int m_current_slot = 1;      // buffer being consumed
+    char m_last_char = '\n';     // last byte delivered; a leading '\n' is a blank first line
+    std::uint64_t m_offset = 0;  // next file offset for seekable inputs
+    bool m_seekable = false;
+    bool m_eof = false;
+    bool m_error = false;
+    std::unique_ptr<detail::io_ring> m_ring;
+};
+
+/**
+ * @brief Double-buffered output stream buffer over a file descriptor
+ *
+ * Formatting fills one buffer while the previous one is being written
+ * (through io_uring on Linux). Falls back to plain blocking write(2) when
+ * io_uring is unavailable.
+ */
+class async_output_buffer : public std::streambuf {
+public:
+    /**
+     * @brief Construct a new async output buffer
+     * @param fd File descriptor to write to (not owned, not closed)
+     * @param buffer_size Size of each of the two buffers in bytes
+     */
+    explicit async_output_buffer(int fd, std::size_t buffer_size = 1 << 20);
+    ~async_output_buffer() override;
+
+    async_output_buffer(const async_output_buffer&) = delete;
+    async_output_buffer& operator=(const async_output_buffer&) = delete;
+
+    /**
+     * @brief Check whether writes are issued through io_uring
+     * @return bool True if io_uring is in use, false for the blocking fallback
+     */
+    [[nodiscard]] bool uses_io_uring() const noexcept { return m_ring != nullptr; }
+
+    /**
+     * @brief Check whether a write failed
+     * @return bool True if any write failed
+     */
+    [[nodiscard]] bool has_error() const noexcept { return m_error; }
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+private:
+    void submit_current();
+    void wait_write();
+    [[nodiscard]] bool write_all(const char* data, std::size_t size) noexcept;
+
+    int m_fd;
+    std::vector<char> m_buffers[2];
+    int m_current_slot = 0;
+    int m_pending_slot = -1;        // buffer with a write in flight, -1 if none
+    std::size_t m_pending_size = 0;
+    std::size_t m_pending_done = 0;
+    bool m_error = false;
+    std::unique_ptr<detail::io_ring> m_ring;
+};
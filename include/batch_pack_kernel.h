@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "item.h"
+#include "pack.h"
+#include "pack_constraints.h"
+
+/**
+ * @brief Next-fit packing of many small orders side by side
+ *
+ * A single small order cannot fill SIMD lanes and spends most of its time in
+ * per-order setup. This kernel gives each of LANES lanes its own order: the
+ * lane holds the order's cursor (item index, units left of the item) and its
+ * open-pack state (units, weight), kept as structure-of-arrays columns. Each
+ * step computes how many units every lane can place in one lane-parallel
+ * pass over those columns (a min of the unit and weight fits, written as
+ * selects so it vectorizes), then applies the outcome per lane: append a
+ * line, open a pack or move to the next item. A lane that finishes its order
+ * is refilled with the next one, so lanes stay busy across orders of
+ * different lengths.
+ *
+ * Every order gets exactly the packs blocking_pack_strategy::pack_items
+ * gives it, including its safety caps: the pack cap from the order's size
+ * and the per-order iteration cap. Only max_items and max_weight are
+ * enforced; plans with the optional limits go through the strategy.
+ */
+namespace batch_pack {
+
+// Lanes per batch; 8 doubles fill a 512-bit register, two 256-bit or four 128-bit ones
+inline constexpr std::size_t LANES = 8;
+
+namespace detail {
+
+// Same limit as blocking_pack_strategy's safety counter
+inline constexpr int MAX_ITERATIONS = 1000000;
+
+/**
+ * @brief Lane state as columns; lane l of every array belongs to the same order
+ */
+struct lanes {
+    // Cursor
+    std::array<std::int32_t, LANES> item_index{};
+    std::array<std::int32_t, LANES> remaining{};      // units of the current item still to place
+    std::array<double, LANES> unit_weight{};          // sanitised weight per unit of the current item
+    // Open pack
+    std::array<std::int32_t, LANES> pack_units{};
+    std::array<double, LANES> pack_weight{};
+    // Bookkeeping
+    std::array<std::int32_t, LANES> pack_number{};    // packs opened so far
+    std::array<std::int32_t, LANES> pack_cap{};
+    std::array<std::int32_t, LANES> iterations{};
+    std::array<std::int32_t, LANES> take{};           // units placed by the current step
+    std::array<std::size_t, LANES> order{};           // order held by the lane
+    std::array<bool, LANES> active{};
+};
+
+/**
+ * @brief Units the open pack of every lane can take (lane-parallel, no branches)
+ *
+ * Matches default_constraints::fit: the minimum of the item-count fit, the
+ * weight fit (pack_constraint_detail::fit_by_capacity) and the units left.
+ * Inactive lanes have remaining == 0 and get 0.
+ */
+inline void compute_take(lanes& s, int max_items, double max_weight) noexcept {
+    for (std::size_t l = 0; l < LANES; ++l) {
+        const int remaining = s.remaining[l];
+        const double fit = s.unit_weight[l] == 0.0 ? remaining : (max_weight - s.pack_weight[l]) / s.unit_weight[l];
+        const int by_weight = fit >= remaining ? remaining : fit > 0.0 ? static_cast<int>(fit) : 0;
+        s.take[l] = std::min({remaining, max_items - s.pack_units[l], by_weight});
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Pack independent orders, LANES at a time
+ * @param orders Items of each order, in packing order (already sorted)
+ * @param max_items Maximum units per pack
+ * @param max_weight Maximum weight per pack
+ * @param input_lines Lines of each order before screening, sizing its pack cap (empty = the orders' sizes)
+ * @return std::vector<std::vector<pack>> Packs of each order, as blocking_pack_strategy returns them
+ */
+inline std::vector<std::vector<pack>> pack_orders(const std::vector<std::vector<item>>& orders,
+                                                  int max_items, double max_weight,
+                                                  const std::vector<std::size_t>& input_lines = {}) {
+    // SAFETY: Validate constraints to prevent infinite loops (as blocking_pack_strategy)
+    max_items = std::max(1, max_items);
+    max_weight = std::max(0.1, max_weight);
+
+    std::vector<std::vector<pack>> results(orders.size());
+    detail::lanes s;
+    std::size_t next_order = 0;
+
+    // Move a lane to its next item with units, or finish its order
+    auto next_item = [&](std::size_t l) {
+        const auto& items = orders[s.order[l]];
+        std::int32_t index = s.item_index[l] + 1;
+        // SAFETY: Skip items with non-positive quantities
+        while (index < static_cast<std::int32_t>(items.size()) && items[index].get_quantity() <= 0) ++index;
+        s.item_index[l] = index;
+        if (index == static_cast<std::int32_t>(items.size())) {
+            s.active[l] = false;
+            s.remaining[l] = 0;
+            return;
+        }
+        s.remaining[l] = items[index].get_quantity();
+        s.unit_weight[l] = std::max(0.0, items[index].get_weight());
+    };
+
+    // Give a free lane the next order; false when none are left
+    auto load_order = [&](std::size_t l) {
+        if (next_order == orders.size()) return false;
+        const std::size_t o = next_order++;
+        const std::size_t size = orders[o].size();
+        results[o].reserve(std::min<std::size_t>(size + 1, 64));
+        results[o].emplace_back(1);
+        s.order[l] = o;
+        s.item_index[l] = -1;
+        s.pack_units[l] = 0;
+        s.pack_weight[l] = 0.0;
+        s.pack_number[l] = 1;
+        const std::size_t lines = std::max(size, o < input_lines.size() ? input_lines[o] : 0);
+        s.pack_cap[l] = static_cast<std::int32_t>(std::min<std::size_t>(100000, lines / 10 + 1000));
+        s.iterations[l] = 0;
+        s.active[l] = true;
+        next_item(l);
+        return true;
+    };
+
+    std::size_t active_lanes = 0;
+    for (std::size_t l = 0; l < LANES; ++l) {
+        // Orders without units finish while loading; keep loading until one stays active
+        while (load_order(l) && !s.active[l]) {}
+        active_lanes += s.active[l];
+    }
+
+    while (active_lanes > 0) {
+        detail::compute_take(s, max_items, max_weight);
+
+        for (std::size_t l = 0; l < LANES; ++l) {
+            if (!s.active[l]) continue;
+            const auto& current = orders[s.order[l]][s.item_index[l]];
+            auto& packs = results[s.order[l]];
+
+            bool advance = false;
+            // SAFETY: Same iteration cap as blocking_pack_strategy; past it, every later item is skipped
+            if (++s.iterations[l] > detail::MAX_ITERATIONS) {
+                s.active[l] = false;
+                s.remaining[l] = 0;
+            } else if (const int take = s.take[l]; take > 0) {
+                // Totals accumulate as in pack::add_partial_item, so they match bit for bit
+                (void)packs.back().add_item(
+                    item(current.get_id(), std::max(1, current.get_length()), take, s.unit_weight[l],
+                         static_cast<float>(std::max(0.0, current.get_volume()))),
+                    std::numeric_limits<int>::max(), std::numeric_limits<double>::infinity());
+                // Read the totals back rather than accumulating a copy, which could round differently
+                s.pack_units[l] = packs.back().get_total_items();
+                s.pack_weight[l] = packs.back().get_total_weight();
+                s.remaining[l] -= take;
+                advance = s.remaining[l] == 0;
+            } else if (s.unit_weight[l] > max_weight || packs.back().is_empty() ||
+                       s.pack_number[l] >= s.pack_cap[l]) {
+                // Too heavy for any pack, or the pack cap is reached: skip the item
+                advance = true;
+            } else {
+                packs.emplace_back(++s.pack_number[l]);
+                s.pack_units[l] = 0;
+                s.pack_weight[l] = 0.0;
+            }
+            if (advance) next_item(l);
+
+            if (!s.active[l]) {
+                while (load_order(l) && !s.active[l]) {}
+                active_lanes -= !s.active[l];
+            }
+        }
+    }
+    return results;
+}
+
+/**
+ * @brief Pack independent orders under per-pack limits
+ *
+ * Plans with optional limits (length, volume) fall back to packing each order
+ * on its own with the same constraint list as blocking_pack_strategy.
+ *
+ * @param orders Items of each order, in packing order (already sorted)
+ * @param limits Per-pack limits
+ * @param input_lines Lines of each order before screening, sizing its pack cap (empty = the orders' sizes)
+ * @param pack_one Packs a single order under the given limits (used for the fallback)
+ * @return std::vector<std::vector<pack>> Packs of each order
+ */
+template <typename PackOne>
+std::vector<std::vector<pack>> pack_orders(const std::vector<std::vector<item>>& orders,
+                                           const pack_limits& limits,
+                                           const std::vector<std::size_t>& input_lines, PackOne&& pack_one) {
+    if (!limits.has_extended()) return pack_orders(orders, limits.max_items, limits.max_weight, input_lines);
+
+    std::vector<std::vector<pack>> results;
+    results.reserve(orders.size());
+    pack_limits order_limits = limits;
+    for (std::size_t o = 0; o < orders.size(); ++o) {
+        order_limits.input_lines = o < input_lines.size() ? input_lines[o] : 0;
+        results.push_back(pack_one(orders[o], order_limits));
+    }
+    return results;
+}
+
+} // namespace batch_pack
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <limits>
+#include <memory>
 #include <vector>
 #include <string>
+#include "energy_meter.h"
 #include "pack_planner.h"
 #include "timer.h"
 
@@ -16,14 +19,17 @@ struct benchmark_result {
     long long items_per_second;  // Changed from int to long long to prevent overflow
     int total_packs;
     double utilization_percent;
+    bool energy_measured = false;   // sorting/packing joules are valid
+    double sorting_joules = 0.0;
+    double packing_joules = 0.0;
 };
 
 class benchmark {
 public:
     benchmark();
     
-    // Run benchmark with different sizes and sort orders
-    void run_benchmark();
+    // Run benchmark with different sizes and sort orders, skipping sizes above max_size
+    void run_benchmark(int max_size = std::numeric_limits<int>::max());
     
     // Generate test data for benchmarking
     std::vector<item> generate_test_data(int size);
@@ -35,9 +41,23 @@ public:
     // Output benchmark results
     void output_benchmark_results(const std::vector<benchmark_result>& results);
 
+    // Meter RAPL energy around the sort and pack phases; false if the counters are unavailable
+    bool set_energy_measurement(bool enabled);
+
+    // Thread counts to run the parallel strategy with (0 = hardware concurrency)
+    void set_thread_counts(std::vector<unsigned int> thread_counts);
+
+    // Run the adversarial cases on every engine; false if any exceeds its ceilings
+    bool run_adversarial_benchmark();
+
 private:
+    // Per strategy and thread count: energy per million items over all runs
+    void output_energy_summary(const std::vector<benchmark_result>& results) const;
+
     pack_planner m_planner;
     timer m_total_timer;
+    std::unique_ptr<energy_meter> m_energy_meter;
+    std::vector<unsigned int> m_thread_counts = {0};
     
     // Default benchmark configuration
     static constexpr int MAX_ITEMS_PER_PACK = 100;
@@ -47,5 +67,4 @@ private:
     static const std::vector<int> BENCHMARK_SIZES;
     static const std::vector<sort_order> SORT_ORDERS;
     static const std::vector<strategy_type> PACKING_STRATEGIES;
-    static const std::vector<unsigned int> THREAD_COUNTS;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pack_strategy.h"
+#include "pack_spill.h"
 
 /**
  * @brief Blocking (synchronous) pack strategy
@@ -18,16 +19,107 @@ public:
     std::vector<pack> pack_items(const std::vector<item>& items,
                             int max_items,
                             double max_weight) override {
+        return pack_items_impl<default_constraints>(items, pack_limits{max_items, max_weight}, 1 << 30,
+                                                    [](std::vector<pack>&) noexcept {});
+    }
+
+    /**
+     * @brief Pack items sequentially under per-pack limits
+     * @param items Items to pack
+     * @param limits Per-pack limits, including the optional ones
+     * @return std::vector<pack> Vector of packs
+     */
+    std::vector<pack> pack_items(const std::vector<item>& items, const pack_limits& limits) override {
+        return with_pack_constraints(limits, [&](auto constraints) {
+            return pack_items_impl<decltype(constraints)>(items, limits, 1 << 30,
+                                                          [](std::vector<pack>&) noexcept {});
+        });
+    }
+
+    /**
+     * @brief Pack items sequentially within a memory budget
+     *
+     * Next-fit never revisits a pack once a new one is opened, so closed packs
+     * are final. Whenever the packs held in memory exceed the budget, all
+     * closed packs are flushed to the spill file. The output is identical to
+     * the unbudgeted overload: spilled packs followed by the returned ones.
+     *
+     * @param items Items to pack
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param memory_budget Bytes of packs to keep in memory before spilling
+     * @param spill Spill file receiving the flushed packs
+     * @return std::vector<pack> Packs still in memory, following those in the spill
+     */
+    std::vector<pack> pack_items(const std::vector<item>& items,
+                            int max_items,
+                            double max_weight,
+                            std::size_t memory_budget,
+                            pack_spill& spill) {
+        return pack_items(items, pack_limits{max_items, max_weight}, memory_budget, spill);
+    }
+
+    /**
+     * @brief Pack items sequentially under per-pack limits within a memory budget
+     * @param items Items to pack
+     * @param limits Per-pack limits, including the optional ones
+     * @param memory_budget Bytes of packs to keep in memory before spilling
+     * @param spill Spill file receiving the flushed packs
+     * @return std::vector<pack> Packs still in memory, following those in the spill
+     */
+    std::vector<pack> pack_items(const std::vector<item>& items,
+                            const pack_limits& limits,
+                            std::size_t memory_budget,
+                            pack_spill& spill) {
+        std::size_t held_bytes = 0;
+        const std::size_t reserve_cap = std::max<std::size_t>(64, memory_budget / sizeof(pack));
+
+        auto on_pack_closed = [&](std::vector<pack>& packs) {
+                // Called before a new pack is opened: every pack held is final
+                held_bytes += pack_spill::memory_footprint(packs.back());
+                if (held_bytes > memory_budget && spill.is_open()) {
+                    for (const auto& p : packs) {
+                        spill.write(p);
+                    }
+                    packs.clear();
+                    held_bytes = 0;
+                }
+            };
+        return with_pack_constraints(limits, [&](auto constraints) {
+            return pack_items_impl<decltype(constraints)>(items, limits, reserve_cap, on_pack_closed);
+        });
+    }
+
+    std::string get_name() const override {
+        return "Blocking";
+    }
+
+private:
+    /**
+     * @brief Next-fit packing loop shared by all overloads
+     * @tparam Constraints pack_constraints<...> list to enforce
+     * @param items Items to pack
+     * @param limits Per-pack limits
+     * @param reserve_cap Upper bound for the initial pack reservation
+     * @param on_pack_closed Hook run before each new pack is opened
+     * @return std::vector<pack> Packs left in memory
+     */
+    template <typename Constraints, typename OnPackClosed>
+    std::vector<pack> pack_items_impl(const std::vector<item>& items,
+                                      pack_limits limits,
+                                      std::size_t reserve_cap,
+                                      OnPackClosed&& on_pack_closed) {
         // SAFETY: Validate constraints to prevent infinite loops
-        max_items = std::max(1, max_items);
-        max_weight = std::max(0.1, max_weight);
+        limits.max_items = std::max(1, limits.max_items);
+        limits.max_weight = std::max(0.1, limits.max_weight);
 
         std::vector<pack> packs;
         // Pre-allocate based on empirical ratio to avoid reallocations
         // SAFETY: Limit initial allocation to prevent OOM with extreme values
-        const size_t max_safe_reserve = std::min<size_t>(100000, items.size() / 10 + 1000);
-        packs.reserve(std::min(max_safe_reserve,
-                    std::max<size_t>(64, static_cast<size_t>(items.size() * 0.00222) + 16)));
+        // (sized from the request's lines, so dropping invalid lines does not lower the cap)
+        const size_t max_safe_reserve = std::min<size_t>(100000, limits.cap_lines(items.size()) / 10 + 1000);
+        packs.reserve(std::min({max_safe_reserve, reserve_cap,
+                    std::max<size_t>(64, static_cast<size_t>(items.size() * 0.00222) + 16)}));
         int pack_number = 1;
         packs.emplace_back(pack_number);
 
@@ -49,16 +141,17 @@ public:
                 }
 
                 pack& current_pack = packs.back();
-                int added_quantity = current_pack.add_partial_item(
+                int added_quantity = current_pack.template add_partial_item<Constraints>(
                     item.get_id(), item.get_length(), remaining_quantity,
-                    item.get_weight(), max_items, max_weight);
+                    item.get_weight(), item.get_volume(), limits);
 
                 if (added_quantity > 0) {
                     remaining_quantity -= added_quantity;
                 } else {
-                    // Check if this item can never fit (weight exceeds max_weight)
-                    if (item.get_weight() > max_weight) {
-                        // Item is too heavy to fit in any pack, skip it
+                    // Check if this item can never fit (e.g. weight exceeds max_weight)
+                    if (!Constraints::admits(unit_offer{item.get_length(), remaining_quantity,
+                                                        item.get_weight(), item.get_volume()}, limits)) {
+                        // Item is too heavy (or long, or bulky) for any pack, skip it
                         remaining_quantity = 0;
                         break;
                     }
@@ -67,13 +160,15 @@ public:
                         remaining_quantity = 0;
                         break;
                     }
-                    
+
                     // SAFETY: Limit maximum number of packs to prevent OOM
-                    if (packs.size() >= max_safe_reserve) {
+                    // (pack_number counts every pack opened, including spilled ones)
+                    if (static_cast<size_t>(pack_number) >= max_safe_reserve) {
                         // Force exit if we've created too many packs
                         remaining_quantity = 0;
                         break;
                     }
+                    on_pack_closed(packs);
                     packs.emplace_back(++pack_number);
                 }
             }
@@ -81,8 +176,4 @@ public:
 
         return packs;
     }
-
-    std::string get_name() const override {
-        return "Blocking";
-    }
 };
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <streambuf>
+#include <vector>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Compression formats recognised by their magic bytes
+ */
+enum class compression_format {
+    NONE,
+    GZIP,
+    ZSTD
+};
+
+/**
+ * @brief Detect the compression format from the first bytes of a stream
+ * @param data Pointer to the leading bytes
+ * @param size Number of bytes available
+ * @return compression_format The detected format (NONE if not compressed)
+ */
+[[nodiscard]] compression_format detect_compression(const unsigned char* data, std::size_t size) noexcept;
+
+/**
+ * @brief Check whether support for a format was compiled in
+ * @param format The format to check
+ * @return bool True if the format can be decoded
+ */
+[[nodiscard]] bool compression_supported(compression_format format) noexcept;
+
+namespace detail { struct serial_decoder; }
+
+/**
+ * @brief Input stream buffer that transparently decompresses gzip and zstd manifests
+ *
+ * The compressed input is mmapped (regular files) or read into memory (pipes).
+ * Inputs made of independently compressed blocks - BGZF gzip (bgzip) or
+ * multi-frame zstd (zstd -T, pzstd) - are decompressed in parallel, several
+ * blocks ahead of the reader, and handed to the parser in order. Other gzip
+ * and zstd inputs are decoded as a single stream. Uncompressed input is
+ * passed through without copying.
+ */
+class compressed_input_buffer : public std::streambuf {
+public:
+    /**
+     * @brief Construct a new compressed input buffer
+     * @param fd File descriptor to read the whole input from (not owned, not closed)
+     * @param thread_count Number of blocks decompressed concurrently
+     */
+    explicit compressed_input_buffer(int fd, unsigned int thread_count = 4);
+    ~compressed_input_buffer() override;
+
+    compressed_input_buffer(const compressed_input_buffer&) = delete;
+    compressed_input_buffer& operator=(const compressed_input_buffer&) = delete;
+
+    /**
+     * @brief Get the detected input format
+     * @return compression_format The format of the input
+     */
+    [[nodiscard]] compression_format format() const noexcept { return m_format; }
+
+    /**
+     * @brief Check whether the input is decompressed block-parallel
+     * @return bool True if independent blocks are decoded concurrently
+     */
+    [[nodiscard]] bool is_parallel() const noexcept { return !m_units.empty(); }
+
+    /**
+     * @brief Check whether reading or decoding failed
+     * @return bool True if the stream ended because of an error
+     */
+    [[nodiscard]] bool has_error() const noexcept { return !m_error.empty(); }
+
+    /**
+     * @brief Get a description of the error that ended the stream
+     * @return const std::string& The error message, empty if none
+     */
+    [[nodiscard]] const std::string& error_message() const noexcept { return m_error; }
+
+protected:
+    int_type underflow() override;
+
+private:
+    /**
+     * @brief A run of consecutive independent blocks decoded by one task
+     */
+    struct unit_batch {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    [[nodiscard]] bool load_input(int fd);
+    void split_units();
+    void launch_batches();
+    [[nodiscard]] bool next_parallel_chunk();
+    [[nodiscard]] bool next_serial_chunk();
+
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    void* m_mapping = nullptr;
+    std::vector<unsigned char> m_owned;
+
+    compression_format m_format = compression_format::NONE;
+    unsigned int m_thread_count;
+    bool m_done = false;
+    std::string m_error;
+
+    // Block-parallel decoding
+    std::vector<unit_batch> m_units;
+    std::size_t m_next_batch = 0;
+    std::deque<std::future<std::vector<char>>> m_in_flight;
+
+    // Single-stream decoding
+    std::unique_ptr<detail::serial_decoder> m_serial;
+    std::vector<char> m_output;
+};
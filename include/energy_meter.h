@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One reading of every energy counter
+ */
+struct energy_sample {
+    std::vector<std::uint64_t> microjoules;   // one per energy_meter domain
+    std::chrono::steady_clock::time_point time;
+};
+
+/**
+ * @brief Package and DRAM energy from the Linux powercap RAPL counters
+ *
+ * Reads the cumulative energy_uj counters under /sys/class/powercap. The
+ * top-level zones (one per CPU package) and their "dram" subzones are summed;
+ * "core"/"uncore" subzones are skipped because the package already includes
+ * them, as is the platform-wide "psys" zone. Counter wraparound is handled
+ * using max_energy_range_uj.
+ *
+ * The counters cover the whole package, so a reading includes other work and
+ * idle power on the machine. Recent kernels make energy_uj readable by root
+ * only; without access the meter reports itself unavailable.
+ */
+class energy_meter {
+public:
+    /**
+     * @brief Discover the RAPL domains
+     * @param powercap_root powercap sysfs directory (overridable for tests)
+     */
+    explicit energy_meter(const std::string& powercap_root = "/sys/class/powercap");
+
+    /**
+     * @brief Check whether at least one counter could be read
+     * @return bool True if energy can be measured
+     */
+    [[nodiscard]] bool available() const noexcept { return !m_domains.empty(); }
+
+    /**
+     * @brief Get the names of the measured domains (e.g. "package-0", "dram")
+     * @return std::vector<std::string> Domain names, in sample order
+     */
+    [[nodiscard]] std::vector<std::string> domain_names() const;
+
+    /**
+     * @brief Read every counter
+     * @return energy_sample Current counter values
+     */
+    [[nodiscard]] energy_sample sample() const;
+
+    /**
+     * @brief Energy used between two samples, summed over all domains
+     * @param from Earlier sample
+     * @param to Later sample
+     * @return double Joules
+     */
+    [[nodiscard]] double joules(const energy_sample& from, const energy_sample& to) const noexcept;
+
+    /**
+     * @brief Average power between two samples
+     * @param from Earlier sample
+     * @param to Later sample
+     * @return double Watts (0 if no time passed)
+     */
+    [[nodiscard]] double watts(const energy_sample& from, const energy_sample& to) const noexcept;
+
+private:
+    struct domain {
+        std::string name;
+        std::string energy_path;
+        std::uint64_t max_range_uj;   // 0 if max_energy_range_uj is unreadable
+    };
+
+    std::vector<domain> m_domains;
+};
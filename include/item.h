@@ -15,9 +15,10 @@ public:
      * @param length The item length
      * @param quantity The item quantity
      * @param weight The weight per piece
+     * @param volume The volume per piece (0 if not tracked)
      */
-    item(int id, int length, int quantity, double weight) noexcept
-    : m_id(id), m_length(length), m_quantity(quantity), m_weight(weight)
+    item(int id, int length, int quantity, double weight, float volume = 0.0f) noexcept
+    : m_id(id), m_length(length), m_quantity(quantity), m_volume(volume), m_weight(weight)
     {}
 
     // Getters
@@ -45,6 +46,12 @@ public:
      */
     [[nodiscard]] double get_weight() const noexcept { return m_weight; }
 
+    /**
+     * @brief Get the volume per piece
+     * @return double The volume per piece
+     */
+    [[nodiscard]] double get_volume() const noexcept { return m_volume; }
+
     // Setters
     /**
      * @brief Set the item quantity
@@ -93,5 +100,8 @@ private:
     int m_id;
     int m_length;
     int m_quantity;
+    float m_volume;   // volume per piece; fills the padding before m_weight
     double m_weight;  // weight per piece
 };
+
+static_assert(sizeof(item) == 24, "item volume must stay in the padding");
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+#include "item.h"
+#include "pack_constraints.h"
+
+/**
+ * @brief How an input item is handled by the planner
+ */
+enum class item_class : std::uint8_t {
+    VALID,         // packed normally
+    ZERO_WEIGHT,   // packed; weight is zero, negative or NaN, so only the unit limit applies
+    OVERSIZE,      // dropped: one unit exceeds a per-pack limit, no pack can take it
+    INVALID        // dropped: quantity is zero or negative
+};
+
+inline constexpr std::size_t ITEM_CLASS_COUNT = 4;
+
+inline const char* item_class_name(item_class c) noexcept {
+    switch (c) {
+        case item_class::VALID: return "valid";
+        case item_class::ZERO_WEIGHT: return "zero-weight";
+        case item_class::OVERSIZE: return "oversize";
+        case item_class::INVALID: return "invalid";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Counts of each item class in a request, with example IDs
+ */
+struct input_diagnostics {
+    static constexpr std::size_t MAX_EXAMPLES = 5;   // IDs kept per class (not for VALID)
+
+    std::array<std::size_t, ITEM_CLASS_COUNT> items{};   // input lines
+    std::array<long long, ITEM_CLASS_COUNT> units{};     // positive quantities
+    std::array<std::vector<int>, ITEM_CLASS_COUNT> examples;
+
+    [[nodiscard]] std::size_t count(item_class c) const noexcept { return items[static_cast<std::size_t>(c)]; }
+    [[nodiscard]] long long unit_count(item_class c) const noexcept { return units[static_cast<std::size_t>(c)]; }
+
+    /**
+     * @brief Get the number of lines in the request, before screening
+     * @return std::size_t Lines of every class
+     */
+    [[nodiscard]] std::size_t lines() const noexcept {
+        std::size_t total = 0;
+        for (std::size_t c : items) total += c;
+        return total;
+    }
+
+    /**
+     * @brief Get the number of lines left out of the plan
+     * @return std::size_t Oversize and invalid lines
+     */
+    [[nodiscard]] std::size_t dropped() const noexcept {
+        return count(item_class::OVERSIZE) + count(item_class::INVALID);
+    }
+
+    /**
+     * @brief Get the units requested, including oversize units that were dropped
+     * @return int Sum of the positive quantities, clamped to INT_MAX
+     */
+    [[nodiscard]] int requested_units() const noexcept {
+        const long long total = unit_count(item_class::VALID) + unit_count(item_class::ZERO_WEIGHT) +
+                                unit_count(item_class::OVERSIZE);
+        return static_cast<int>(std::min<long long>(total, std::numeric_limits<int>::max()));
+    }
+
+    /**
+     * @brief Check whether every line was an ordinary, packable item
+     * @return bool True if there were no zero-weight, oversize or invalid lines
+     */
+    [[nodiscard]] bool clean() const noexcept {
+        return dropped() == 0 && count(item_class::ZERO_WEIGHT) == 0;
+    }
+};
+
+/**
+ * @brief Classify one item without branches
+ *
+ * Uses the same admits() test the packing loops use to skip items, so an
+ * item is OVERSIZE exactly when every strategy would leave it out.
+ *
+ * @tparam Constraints pack_constraints<...> list of the plan
+ * @param i Item to classify
+ * @param limits Per-pack limits of the plan
+ * @return item_class Class of the item
+ */
+template <typename Constraints>
+[[nodiscard]] inline item_class classify_item(const item& i, const pack_limits& limits) noexcept {
+    const bool invalid = i.get_quantity() <= 0;
+    const bool oversize = !Constraints::admits(
+        unit_offer{i.get_length(), 1, i.get_weight(), i.get_volume()}, limits);
+    const bool zero_weight = !(i.get_weight() > 0.0);
+    // Bitwise rather than logical operators: the result is a select, not a branch chain
+    return static_cast<item_class>((invalid * 3) | ((!invalid & oversize) * 2) |
+                                   (!invalid & !oversize & zero_weight));
+}
+
+/**
+ * @brief Classify items and drop the ones no pack can take, in one pass
+ *
+ * Classification is a select, not a branch chain. Up to the first dropped
+ * line the pass only reads, so clean input is never rewritten; after it,
+ * every item is copied to the write position, which only advances for kept
+ * items. Lines that are not VALID (rare in practice) also update their class
+ * counters. Kept items stay in input order.
+ *
+ * @param items Items to screen; on return, only VALID and ZERO_WEIGHT items
+ * @param limits Per-pack limits of the plan (sanitised, as the strategies use them)
+ * @return input_diagnostics Counts and example IDs of every class
+ */
+inline input_diagnostics screen_items(std::vector<item>& items, const pack_limits& limits) {
+    return with_pack_constraints(limits, [&](auto constraints) {
+        using Constraints = decltype(constraints);
+        input_diagnostics diagnostics;
+        item* const data = items.data();
+        const std::size_t count = items.size();
+        long long total_units = 0;
+        auto record = [&](const item& current, std::size_t c, int quantity) {
+            // Rare path; VALID counts are derived from the totals afterwards
+            ++diagnostics.items[c];
+            diagnostics.units[c] += quantity;
+            if (diagnostics.examples[c].size() < input_diagnostics::MAX_EXAMPLES) {
+                diagnostics.examples[c].push_back(current.get_id());
+            }
+        };
+
+        // Read-only scan up to the first dropped line; clean input never writes
+        std::size_t r = 0;
+        for (; r < count; ++r) {
+            const auto c = static_cast<std::size_t>(classify_item<Constraints>(data[r], limits));
+            if (c > static_cast<std::size_t>(item_class::ZERO_WEIGHT)) break;
+            const int quantity = std::max(0, data[r].get_quantity());
+            total_units += quantity;
+            if (c != 0) record(data[r], c, quantity);
+        }
+
+        // Compact the rest
+        std::size_t kept = r;
+        for (; r < count; ++r) {
+            const item current = data[r];
+            const auto c = static_cast<std::size_t>(classify_item<Constraints>(current, limits));
+            const int quantity = std::max(0, current.get_quantity());
+            total_units += quantity;
+            if (c != 0) record(current, c, quantity);
+            data[kept] = current;
+            kept += c <= static_cast<std::size_t>(item_class::ZERO_WEIGHT);
+        }
+        items.erase(items.begin() + static_cast<std::ptrdiff_t>(kept), items.end());
+
+        constexpr auto VALID = static_cast<std::size_t>(item_class::VALID);
+        diagnostics.items[VALID] = count - diagnostics.items[1] - diagnostics.items[2] - diagnostics.items[3];
+        diagnostics.units[VALID] = total_units - diagnostics.units[1] - diagnostics.units[2] - diagnostics.units[3];
+        return diagnostics;
+    });
+}
+
+/**
+ * @brief Print the classes that are not VALID
+ * @param diagnostics Diagnostics to print
+ * @param output Stream to write to
+ */
+inline void output_input_diagnostics(const input_diagnostics& diagnostics, std::ostream& output) {
+    output << "\nInput Diagnostics:\n";
+    output << "Valid items: " << diagnostics.count(item_class::VALID) << '\n';
+    for (auto c : {item_class::ZERO_WEIGHT, item_class::OVERSIZE, item_class::INVALID}) {
+        if (diagnostics.count(c) == 0) continue;
+        output << (c == item_class::ZERO_WEIGHT ? "Packed " : "Dropped ") << item_class_name(c)
+               << " items: " << diagnostics.count(c) << " (" << diagnostics.unit_count(c) << " units), e.g. IDs";
+        for (int id : diagnostics.examples[static_cast<std::size_t>(c)]) output << ' ' << id;
+        output << '\n';
+    }
+}
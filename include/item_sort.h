@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "item.h"
+#include "simd_kernels.h"
+#include "sort_order.h"
+
+/**
+ * @brief Stable item sorting for every sort_order
+ *
+ * Items are sorted by integer keys with an LSD radix sort (8-bit digits),
+ * which is stable, so rows with equal keys keep their input order. Every
+ * stage sorts the 64-bit (key << 32 | position) values that
+ * simd_kernels::build_sort_keys produces for lengths. Weight orders key on
+ * the upper half of the weight's bit pattern and settle the rare near-ties
+ * on the full value; composite orders then run a stable length stage over
+ * the weight order. Digits that are the same in every key are skipped, so
+ * lengths below 65536 cost two passes.
+ *
+ * Keys use the values as packed: lengths below 1 count as 1 and negative or
+ * NaN weights as 0, so the order the validator sees in the packs is the order
+ * that was sorted.
+ */
+namespace item_sort {
+
+/**
+ * @brief Order-preserving unsigned key of a length
+ * @param length Item length
+ * @param descending True to order larger values first
+ * @return std::uint32_t Key; ascending key order is the requested order
+ */
+[[nodiscard]] constexpr std::uint32_t length_key(std::int32_t length, bool descending) noexcept {
+    // Same mapping as simd_kernels::build_sort_keys
+    return static_cast<std::uint32_t>(std::max(1, length)) ^ (descending ? 0x7FFFFFFFu : 0x80000000u);
+}
+
+/**
+ * @brief Order-preserving unsigned key of a piece weight
+ * @param weight Weight per piece
+ * @param descending True to order heavier pieces first
+ * @return std::uint64_t Key; ascending key order is the requested order
+ */
+[[nodiscard]] inline std::uint64_t weight_key(double weight, bool descending) noexcept {
+    // max() maps NaN and negatives to +0.0; non-negative doubles order like their bit patterns
+    const std::uint64_t bits = std::bit_cast<std::uint64_t>(std::max(0.0, weight) + 0.0);
+    return descending ? ~bits : bits;
+}
+
+/**
+ * @brief Whether an order has a weight key
+ */
+[[nodiscard]] constexpr bool uses_weight(sort_order order) noexcept {
+    return order == sort_order::HEAVY_TO_LIGHT || order == sort_order::SHORT_TO_LONG_HEAVY_FIRST ||
+           order == sort_order::LONG_TO_SHORT_HEAVY_FIRST;
+}
+
+/**
+ * @brief Whether an order has a length key
+ */
+[[nodiscard]] constexpr bool uses_length(sort_order order) noexcept {
+    return order != sort_order::NATURAL && order != sort_order::HEAVY_TO_LIGHT;
+}
+
+/**
+ * @brief Whether an order puts longer items first
+ */
+[[nodiscard]] constexpr bool length_descending(sort_order order) noexcept {
+    return order == sort_order::LONG_TO_SHORT || order == sort_order::LONG_TO_SHORT_HEAVY_FIRST;
+}
+
+/**
+ * @brief Check whether a line must come strictly before another under an order
+ * @param order Sort order
+ * @param length_a Length of the first line
+ * @param weight_a Piece weight of the first line
+ * @param length_b Length of the second line
+ * @param weight_b Piece weight of the second line
+ * @return bool True if (a) sorts before (b); false for NATURAL and for ties
+ */
+[[nodiscard]] inline bool precedes(sort_order order, std::int32_t length_a, double weight_a,
+                                   std::int32_t length_b, double weight_b) noexcept {
+    if (uses_length(order)) {
+        const bool descending = length_descending(order);
+        const std::uint32_t a = length_key(length_a, descending);
+        const std::uint32_t b = length_key(length_b, descending);
+        if (a != b) return a < b;
+    }
+    return uses_weight(order) && weight_key(weight_a, true) < weight_key(weight_b, true);
+}
+
+namespace detail {
+
+/**
+ * @brief Stable LSD radix sort on bytes [first_byte, first_byte + byte_count) of a 64-bit key
+ * @param data Records to sort
+ * @param scratch Buffer of the same size (contents are overwritten)
+ * @param key_of Returns the std::uint64_t key of a record
+ */
+template <typename T, typename KeyOf>
+void radix_sort(std::vector<T>& data, std::vector<T>& scratch, KeyOf key_of,
+                unsigned first_byte, unsigned byte_count) {
+    const std::size_t count = data.size();
+    std::array<std::array<std::size_t, 256>, 8> histograms{};
+    for (const T& record : data) {
+        const std::uint64_t key = key_of(record);
+        for (unsigned b = 0; b < byte_count; ++b) {
+            ++histograms[b][(key >> (8 * (first_byte + b))) & 0xFF];
+        }
+    }
+
+    scratch.resize(count);
+    for (unsigned b = 0; b < byte_count; ++b) {
+        const unsigned shift = 8 * (first_byte + b);
+        auto& offsets = histograms[b];
+        // Every key has the same digit here: the pass would not move anything
+        if (offsets[(key_of(data.front()) >> shift) & 0xFF] == count) continue;
+
+        std::size_t running = 0;
+        for (auto& offset : offsets) {
+            const std::size_t digit_count = offset;
+            offset = running;
+            running += digit_count;
+        }
+        for (const T& record : data) {
+            scratch[offsets[(key_of(record) >> shift) & 0xFF]++] = record;
+        }
+        data.swap(scratch);
+    }
+}
+
+// Below this, building keys costs more than comparison sorting
+constexpr std::size_t RADIX_MIN_ITEMS = 64;
+
+} // namespace detail
+
+/**
+ * @brief Sort items in place, stably, by a sort order
+ * @param items Items to sort
+ * @param order Sort order (NATURAL leaves the items unchanged)
+ */
+inline void sort(std::vector<item>& items, sort_order order) {
+    const std::size_t count = items.size();
+    if (order == sort_order::NATURAL || count < 2) return;
+
+    if (count < detail::RADIX_MIN_ITEMS || count > std::numeric_limits<std::uint32_t>::max()) {
+        std::stable_sort(items.begin(), items.end(), [order](const item& a, const item& b) {
+            return precedes(order, a.get_length(), a.get_weight(), b.get_length(), b.get_weight());
+        });
+        return;
+    }
+
+    // Each stage sorts 64-bit (key << 32 | position) values on the key half, so
+    // positions stay in input order within equal keys; the low half is the row
+    std::vector<std::uint64_t> keys(count);
+    std::vector<std::uint64_t> scratch;
+    auto identity = [](std::uint64_t key) { return key; };
+    auto row_of = [](std::uint64_t key) { return static_cast<std::uint32_t>(key); };
+
+    std::vector<std::uint32_t> rows;   // input row at each position of the weight stage
+    if (uses_weight(order)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            keys[i] = (weight_key(items[i].get_weight(), true) & 0xFFFFFFFF00000000ull) | i;
+        }
+        detail::radix_sort(keys, scratch, identity, 4, 4);
+
+        // The upper 32 bits order weights to ~1e-6; settle near-ties on the full key
+        auto full_key = [&](std::uint64_t key) { return weight_key(items[row_of(key)].get_weight(), true); };
+        for (std::size_t begin = 0; begin < count;) {
+            std::size_t end = begin + 1;
+            while (end < count && (keys[end] >> 32) == (keys[begin] >> 32)) ++end;
+            if (end - begin > 1 &&
+                !std::is_sorted(keys.begin() + begin, keys.begin() + end,
+                                [&](std::uint64_t a, std::uint64_t b) { return full_key(a) < full_key(b); })) {
+                std::stable_sort(keys.begin() + begin, keys.begin() + end,
+                                 [&](std::uint64_t a, std::uint64_t b) { return full_key(a) < full_key(b); });
+            }
+            begin = end;
+        }
+    }
+
+    if (uses_length(order)) {
+        std::vector<std::int32_t> lengths(count);
+        if (uses_weight(order)) {
+            // Second, stable stage on the primary key; equal lengths stay heaviest first
+            rows.resize(count);
+            for (std::size_t p = 0; p < count; ++p) rows[p] = row_of(keys[p]);
+            for (std::size_t p = 0; p < count; ++p) lengths[p] = std::max(1, items[rows[p]].get_length());
+        } else {
+            for (std::size_t i = 0; i < count; ++i) lengths[i] = std::max(1, items[i].get_length());
+        }
+        simd_kernels::build_sort_keys(lengths.data(), count, length_descending(order), keys.data());
+        detail::radix_sort(keys, scratch, identity, 4, 4);
+    }
+
+    std::vector<item> sorted;
+    sorted.reserve(count);
+    for (const std::uint64_t key : keys) {
+        sorted.push_back(items[rows.empty() ? row_of(key) : rows[row_of(key)]]);
+    }
+    items.swap(sorted);
+}
+
+} // namespace item_sort
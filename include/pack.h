@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <sstream>
 #include "item.h"
+#include "pack_constraints.h"
 
 /**
  * @brief Represents a pack containing multiple items
@@ -36,6 +37,7 @@ public:
             m_items.push_back(item);
             m_total_items = new_quantity;
             m_total_weight = new_weight;
+            m_total_volume += item.get_quantity() * item.get_volume();
             m_max_length = std::max(m_max_length, item.get_length());
             return true;
         }
@@ -50,8 +52,8 @@ public:
      * @return int Number of items successfully added
      */
     [[nodiscard]] int add_partial_item(const item& item, int max_items, double max_weight) noexcept {
-        return add_partial_item(item.get_id(), item.get_length(),
-                                item.get_quantity(), item.get_weight(), max_items, max_weight);
+        return add_partial_item(item.get_id(), item.get_length(), item.get_quantity(),
+                                item.get_weight(), item.get_volume(), pack_limits{max_items, max_weight});
     }
 
     /**
@@ -66,32 +68,44 @@ public:
      */
     [[nodiscard]] int add_partial_item(int id, int length, int quantity, double weight,
                                     int max_items, double max_weight) noexcept {
+        return add_partial_item<default_constraints>(id, length, quantity, weight, 0.0,
+                                                     pack_limits{max_items, max_weight});
+    }
+
+    /**
+     * @brief Try to add partial quantity of an item under a list of constraints
+     * @tparam Constraints pack_constraints<...> list to enforce
+     * @param id The item ID
+     * @param length The item length
+     * @param quantity The item quantity
+     * @param weight The item weight per piece
+     * @param volume The item volume per piece
+     * @param limits Per-pack limits
+     * @return int Number of items successfully added
+     */
+    template <typename Constraints = default_constraints>
+    [[nodiscard]] int add_partial_item(int id, int length, int quantity, double weight, double volume,
+                                       const pack_limits& limits) noexcept {
         // SAFETY: Validate inputs to prevent negative values
-        if (quantity <= 0 || max_items <= 0 || max_weight < 0) {
+        if (quantity <= 0 || limits.max_items <= 0 || limits.max_weight < 0) {
             return 0;
         }
 
         // SAFETY: Ensure length is positive for valid packing
         length = std::max(1, length);
 
-        // SAFETY: Ensure weight is non-negative
+        // SAFETY: Ensure weight and volume are non-negative
         weight = std::max(0.0, weight);
+        // Rounded to the stored precision so the totals match the stored lines
+        const float unit_volume = static_cast<float>(std::max(0.0, volume));
 
-        const int max_by_items = max_items - m_total_items;
-        const double weight_remaining = max_weight - m_total_weight;
-
-        // Handle zero weight case - if weight is 0, weight constraint doesn't apply
-        const int max_by_weight = (weight == 0.0) ? quantity :
-                                    static_cast<int>(weight_remaining / weight);
-
-        // SAFETY: Ensure max_by_weight is non-negative to prevent underflow
-        const int safe_max_by_weight = std::max(0, max_by_weight);
-
-        const int can_add = std::min({max_by_items, safe_max_by_weight, quantity});
+        const int can_add = Constraints::fit(pack_totals{m_total_items, m_total_weight, m_total_volume},
+                                             unit_offer{length, quantity, weight, unit_volume}, limits);
         if (can_add > 0) {
-            m_items.emplace_back(id, length, can_add, weight);
+            m_items.emplace_back(id, length, can_add, weight, unit_volume);
             m_total_items += can_add;
             m_total_weight += can_add * weight;
+            m_total_volume += can_add * static_cast<double>(unit_volume);
             m_max_length = std::max(m_max_length, length);
         }
         return can_add;
@@ -138,6 +152,12 @@ public:
      */
     [[nodiscard]] double get_total_weight() const noexcept { return m_total_weight; }
 
+    /**
+     * @brief Get the total volume of the pack
+     * @return double Total volume
+     */
+    [[nodiscard]] double get_total_volume() const noexcept { return m_total_volume; }
+
     /**
      * @brief Get the maximum length of any item in the pack
      * @return int Maximum length
@@ -191,5 +211,6 @@ private:
     std::vector<item> m_items;
     int m_total_items = 0;
     double m_total_weight = 0.0;
+    double m_total_volume = 0.0;
     int m_max_length = 0;
 };
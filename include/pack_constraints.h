@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * @brief Per-pack limits checked when units are placed
+ *
+ * Units and weight are always enforced. Length and volume are optional and
+ * disabled while zero. input_lines is not a per-pack limit: it carries the
+ * request's line count from before screening, so the pack caps do not shrink
+ * when invalid or oversize lines are dropped.
+ */
+struct pack_limits {
+    int max_items = 100;
+    double max_weight = 200.0;
+    int max_length = 0;          // longest item a pack may hold (0 = unlimited)
+    double max_volume = 0.0;     // combined volume of a pack (0 = unlimited)
+    std::size_t input_lines = 0; // lines before screening (0 = the items packed)
+
+    /**
+     * @brief Check whether any optional limit is set
+     * @return bool True if length or volume must be enforced
+     */
+    [[nodiscard]] constexpr bool has_extended() const noexcept {
+        return max_length > 0 || max_volume > 0.0;
+    }
+
+    /**
+     * @brief Get the line count the pack caps are sized from
+     * @param packed Number of items handed to the strategy
+     * @return std::size_t The request's line count, never less than packed
+     */
+    [[nodiscard]] constexpr std::size_t cap_lines(std::size_t packed) const noexcept {
+        return std::max(packed, input_lines);
+    }
+};
+
+/**
+ * @brief Running totals of the pack being filled
+ */
+struct pack_totals {
+    int items;
+    double weight;
+    double volume;
+};
+
+/**
+ * @brief Units of one item offered to a pack (already sanitised, quantity > 0)
+ */
+struct unit_offer {
+    int length;
+    int quantity;
+    double weight;   // per unit, >= 0
+    double volume;   // per unit, >= 0
+};
+
+namespace pack_constraint_detail {
+
+/**
+ * @brief Units that fit into the remaining capacity of an additive quantity
+ * @param remaining Capacity left in the pack
+ * @param per_unit Amount one unit uses (>= 0)
+ * @param quantity Units offered
+ * @return int Units that fit, in [0, quantity]
+ */
+[[nodiscard]] inline int fit_by_capacity(double remaining, double per_unit, int quantity) noexcept {
+    // SAFETY: Compare in double before narrowing; tiny per-unit amounts give quotients beyond INT_MAX
+    const double fit = (per_unit == 0.0) ? quantity : remaining / per_unit;
+    return fit >= quantity ? quantity : fit > 0.0 ? static_cast<int>(fit) : 0;  // NaN gives 0
+}
+
+} // namespace pack_constraint_detail
+
+/*
+ * A constraint is a stateless type with two static members:
+ *   int fit(const pack_totals&, const unit_offer&, const pack_limits&)
+ *       Units of the offer the pack can still take under this constraint.
+ *   bool admits(const unit_offer&, const pack_limits&)
+ *       Whether one unit fits an empty pack; items failing this are skipped
+ *       instead of opening packs they can never enter.
+ */
+
+/**
+ * @brief Units per pack (max_items)
+ */
+struct item_count_constraint {
+    [[nodiscard]] static int fit(const pack_totals& totals, const unit_offer&,
+                                 const pack_limits& limits) noexcept {
+        return limits.max_items - totals.items;
+    }
+
+    [[nodiscard]] static bool admits(const unit_offer&, const pack_limits&) noexcept { return true; }
+};
+
+/**
+ * @brief Weight per pack (max_weight)
+ */
+struct weight_constraint {
+    [[nodiscard]] static int fit(const pack_totals& totals, const unit_offer& offer,
+                                 const pack_limits& limits) noexcept {
+        return pack_constraint_detail::fit_by_capacity(limits.max_weight - totals.weight,
+                                                       offer.weight, offer.quantity);
+    }
+
+    [[nodiscard]] static bool admits(const unit_offer& offer, const pack_limits& limits) noexcept {
+        return !(offer.weight > limits.max_weight);
+    }
+};
+
+/**
+ * @brief Longest item per pack (max_length); all or nothing per item
+ */
+struct length_constraint {
+    [[nodiscard]] static int fit(const pack_totals&, const unit_offer& offer,
+                                 const pack_limits& limits) noexcept {
+        return admits(offer, limits) ? offer.quantity : 0;
+    }
+
+    [[nodiscard]] static bool admits(const unit_offer& offer, const pack_limits& limits) noexcept {
+        return limits.max_length <= 0 || offer.length <= limits.max_length;
+    }
+};
+
+/**
+ * @brief Volume per pack (max_volume)
+ */
+struct volume_constraint {
+    [[nodiscard]] static int fit(const pack_totals& totals, const unit_offer& offer,
+                                 const pack_limits& limits) noexcept {
+        if (limits.max_volume <= 0.0) return offer.quantity;
+        return pack_constraint_detail::fit_by_capacity(limits.max_volume - totals.volume,
+                                                       offer.volume, offer.quantity);
+    }
+
+    [[nodiscard]] static bool admits(const unit_offer& offer, const pack_limits& limits) noexcept {
+        return limits.max_volume <= 0.0 || !(offer.volume > limits.max_volume);
+    }
+};
+
+/**
+ * @brief Compile-time list of constraints applied together
+ *
+ * fit() is the minimum of every constraint's fit, expanded as a fold so the
+ * compiler inlines each check into the packing loop; a constraint that is not
+ * in the list generates no code at all.
+ */
+template <typename... Constraints>
+struct pack_constraints {
+    [[nodiscard]] static int fit(const pack_totals& totals, const unit_offer& offer,
+                                 const pack_limits& limits) noexcept {
+        int units = offer.quantity;
+        ((units = std::min(units, Constraints::fit(totals, offer, limits))), ...);
+        return units;
+    }
+
+    [[nodiscard]] static bool admits(const unit_offer& offer, const pack_limits& limits) noexcept {
+        return (Constraints::admits(offer, limits) && ...);
+    }
+};
+
+// The two limits every plan has
+using default_constraints = pack_constraints<item_count_constraint, weight_constraint>;
+
+// Every supported limit; used only when pack_limits::has_extended()
+using extended_constraints = pack_constraints<item_count_constraint, weight_constraint,
+                                              length_constraint, volume_constraint>;
+
+/**
+ * @brief Run a packing loop instantiated for the constraints a plan needs
+ *
+ * Picks the constraint list once per plan, so plans without the optional
+ * limits run exactly the two-constraint loop.
+ *
+ * @param limits Limits of the plan
+ * @param fn Generic callable taking the constraint list as a tag argument
+ * @return Whatever fn returns
+ */
+template <typename Fn>
+decltype(auto) with_pack_constraints(const pack_limits& limits, Fn&& fn) {
+    if (limits.has_extended()) return fn(extended_constraints{});
+    return fn(default_constraints{});
+}
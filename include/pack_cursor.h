@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include "item.h"
+#include "pack.h"
+
+/**
+ * @brief Resumable next-fit packing state
+ *
+ * Runs the same next-fit loop as blocking_pack_strategy, including its
+ * safety limits, but in bounded increments: advance() performs at most the
+ * requested number of steps and returns, and the next call continues exactly
+ * where the previous one stopped. One step is one attempt to place (part of)
+ * an item into the current pack. Packing a list in any number of increments
+ * gives the same packs as blocking_pack_strategy::pack_items.
+ */
+class pack_cursor {
+public:
+    /**
+     * @brief Where packing stands; with the open pack, enough to continue elsewhere
+     */
+    struct state {
+        size_t index = 0;               // item being packed next
+        int remaining_quantity = 0;     // units of that item still to place (0 = not started)
+        int pack_number = 1;            // packs opened so far; the open pack has this number
+        int safety_counter = 0;         // placement attempts so far
+    };
+
+    /**
+     * @brief Start packing a list of items
+     * @param items Items to pack, already in packing order
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     */
+    pack_cursor(std::vector<item> items, int max_items, double max_weight)
+        : pack_cursor(std::move(items), pack_limits{max_items, max_weight}) {}
+
+    /**
+     * @brief Start packing a list of items under per-pack limits
+     * @param items Items to pack, already in packing order
+     * @param limits Per-pack limits, including the optional ones
+     */
+    pack_cursor(std::vector<item> items, const pack_limits& limits)
+        : m_items(std::move(items)),
+          // SAFETY: Validate constraints to prevent infinite loops
+          m_limits{std::max(1, limits.max_items), std::max(0.1, limits.max_weight),
+                   limits.max_length, limits.max_volume, limits.input_lines},
+          // SAFETY: Limit the number of packs to prevent OOM with extreme values
+          m_max_packs(std::min<size_t>(100000, limits.cap_lines(m_items.size()) / 10 + 1000)) {
+        m_packs.reserve(std::min(m_max_packs,
+                    std::max<size_t>(64, static_cast<size_t>(m_items.size() * 0.00222) + 16)));
+        m_packs.emplace_back(m_pack_number);
+    }
+
+    /**
+     * @brief Continue packing from a saved state
+     *
+     * The packs closed before the state was saved are not needed: next-fit
+     * never revisits them, and the pack cap counts them through pack_number.
+     *
+     * @param items Items to pack, in the same order as when the state was saved
+     * @param limits Per-pack limits, the same as when the state was saved
+     * @param saved State returned by get_state()
+     * @param open_pack The pack that was open when the state was saved
+     */
+    pack_cursor(std::vector<item> items, const pack_limits& limits, const state& saved, pack open_pack)
+        : m_items(std::move(items)),
+          m_limits{std::max(1, limits.max_items), std::max(0.1, limits.max_weight),
+                   limits.max_length, limits.max_volume, limits.input_lines},
+          m_max_packs(std::min<size_t>(100000, limits.cap_lines(m_items.size()) / 10 + 1000)),
+          m_index(std::min(saved.index, m_items.size())),
+          m_remaining_quantity(saved.remaining_quantity),
+          m_pack_number(saved.pack_number),
+          m_safety_counter(saved.safety_counter) {
+        m_packs.reserve(64);
+        m_packs.push_back(std::move(open_pack));
+    }
+
+    /**
+     * @brief Continue packing for a bounded amount of work
+     * @param max_steps Maximum number of placement steps to perform
+     * @return size_t Steps actually performed (less than max_steps only when done)
+     */
+    size_t advance(size_t max_steps) {
+        return with_pack_constraints(m_limits, [&](auto constraints) {
+            return advance_impl<decltype(constraints)>(max_steps);
+        });
+    }
+
+    /**
+     * @brief Pack everything that is left
+     */
+    void run() {
+        while (!done()) {
+            advance(static_cast<size_t>(-1));
+        }
+    }
+
+    /**
+     * @brief Check whether every item has been processed
+     * @return bool True if packing is complete
+     */
+    [[nodiscard]] bool done() const noexcept { return m_index >= m_items.size(); }
+
+    /**
+     * @brief Get the fraction of items processed so far
+     * @return double Progress in [0, 1]
+     */
+    [[nodiscard]] double progress() const noexcept {
+        return m_items.empty() ? 1.0 : static_cast<double>(m_index) / m_items.size();
+    }
+
+    /**
+     * @brief Get the index of the item being packed next
+     * @return size_t Item index
+     */
+    [[nodiscard]] size_t position() const noexcept { return m_index; }
+
+    /**
+     * @brief Get the items being packed
+     * @return const std::vector<item>& Items in packing order
+     */
+    [[nodiscard]] const std::vector<item>& items() const noexcept { return m_items; }
+
+    /**
+     * @brief Get the packs built so far; the last one is still open
+     * @return const std::vector<pack>& Packs
+     */
+    [[nodiscard]] const std::vector<pack>& packs() const noexcept { return m_packs; }
+
+    /**
+     * @brief Move the packs out of the cursor
+     * @return std::vector<pack> Packs built so far
+     */
+    [[nodiscard]] std::vector<pack> take_packs() noexcept { return std::move(m_packs); }
+
+    /**
+     * @brief Move the closed packs out of the cursor, keeping the open one
+     * @return std::vector<pack> Packs closed since the last call, in order
+     */
+    [[nodiscard]] std::vector<pack> take_closed_packs() {
+        std::vector<pack> closed;
+        if (m_packs.size() > 1) {
+            closed.reserve(m_packs.size() - 1);
+            std::move(m_packs.begin(), m_packs.end() - 1, std::back_inserter(closed));
+            m_packs.erase(m_packs.begin(), m_packs.end() - 1);
+        }
+        return closed;
+    }
+
+    /**
+     * @brief Move the items out of the cursor once packing is done with them
+     * @return std::vector<item> Items in packing order
+     */
+    [[nodiscard]] std::vector<item> take_items() noexcept { return std::move(m_items); }
+
+    /**
+     * @brief Get the state to continue from later (see the resuming constructor)
+     * @return state Cursor position, pack number and safety counter
+     */
+    [[nodiscard]] state get_state() const noexcept {
+        return state{m_index, m_remaining_quantity, m_pack_number, m_safety_counter};
+    }
+
+private:
+    template <typename Constraints>
+    size_t advance_impl(size_t max_steps) {
+        size_t steps = 0;
+        while (steps < max_steps && m_index < m_items.size()) {
+            const item& current_item = m_items[m_index];
+            ++steps;
+
+            if (m_remaining_quantity == 0) {
+                // SAFETY: Skip items with non-positive quantities
+                if (current_item.get_quantity() <= 0) {
+                    ++m_index;
+                    continue;
+                }
+                m_remaining_quantity = current_item.get_quantity();
+            }
+
+            // SAFETY: Same iteration cap as the blocking strategy
+            if (++m_safety_counter > MAX_ITERATIONS) {
+                next_item();
+                continue;
+            }
+
+            pack& current_pack = m_packs.back();
+            int added_quantity = current_pack.template add_partial_item<Constraints>(
+                current_item.get_id(), current_item.get_length(), m_remaining_quantity,
+                current_item.get_weight(), current_item.get_volume(), m_limits);
+
+            if (added_quantity > 0) {
+                m_remaining_quantity -= added_quantity;
+                if (m_remaining_quantity == 0) {
+                    ++m_index;
+                }
+            } else if (!Constraints::admits(unit_offer{current_item.get_length(), m_remaining_quantity,
+                                                       current_item.get_weight(), current_item.get_volume()},
+                                            m_limits) ||
+                       current_pack.is_empty() ||
+                       static_cast<size_t>(m_pack_number) >= m_max_packs) {
+                // Too heavy (or long, or bulky) for any pack, unplaceable, or pack cap reached: drop the rest
+                next_item();
+            } else {
+                m_packs.emplace_back(++m_pack_number);
+            }
+        }
+        return steps;
+    }
+
+    void next_item() noexcept {
+        m_remaining_quantity = 0;
+        ++m_index;
+    }
+
+    static constexpr int MAX_ITERATIONS = 1000000;
+
+    std::vector<item> m_items;
+    pack_limits m_limits;
+    size_t m_max_packs;
+
+    std::vector<pack> m_packs;
+    size_t m_index = 0;
+    int m_remaining_quantity = 0;
+    int m_pack_number = 1;
+    int m_safety_counter = 0;
+};
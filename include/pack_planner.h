@@ -4,10 +4,19 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include "batch_pack_kernel.h"
 #include "item.h"
+#include "item_screen.h"
+#include "item_sort.h"
 #include "pack.h"
 #include "sort_order.h"
 #include "pack_strategy.h"
+#include "blocking_pack_strategy.h"
+#include "pack_spill.h"
+#include "plan_checkpoint.h"
+#include "request_trace.h"
+#include "shadow_runner.h"
 #include "timer.h"
 
 /**
@@ -19,6 +28,25 @@ struct pack_planner_config {
     double max_weight_per_pack = 200.0;
     strategy_type type = strategy_type::BLOCKING_FIRST_FIT;
     int thread_count = 4;
+    // Bytes of finished packs held in memory before they spill to disk (0 = unlimited).
+    // Honoured by the blocking strategy; parallel strategies keep all packs in memory.
+    std::size_t memory_budget_bytes = 0;
+    // Optional limits, off while zero: longest item per pack and combined volume per pack
+    int max_length_per_pack = 0;
+    double max_volume_per_pack = 0.0;
+    // Lines the request had before an earlier screening pass (0 = the lines given here);
+    // lets a replanner of already-screened items keep the original pack caps
+    std::size_t input_lines = 0;
+
+    /**
+     * @brief Get the per-pack limits, sanitised the way the planner applies them
+     * @return pack_limits Limits for the packing loops
+     */
+    [[nodiscard]] pack_limits limits() const noexcept {
+        return pack_limits{std::max(1, max_items_per_pack), std::max(0.1, max_weight_per_pack),
+                           std::max(0, max_length_per_pack), std::max(0.0, max_volume_per_pack),
+                           input_lines};
+    }
 
     // C++20: default all comparisons
     auto operator<=>(const pack_planner_config&) const = default;
@@ -35,6 +63,18 @@ struct pack_planner_result {
     int total_items;
     double utilization_percent;
     std::string strategy_name;
+    // Packs flushed to disk ahead of `packs` under a memory budget; null if none were
+    std::shared_ptr<pack_spill> spill;
+    // What the screening pass found in the input, including the items it dropped
+    input_diagnostics diagnostics;
+
+    /**
+     * @brief Get the number of packs including spilled ones
+     * @return size_t Total number of packs
+     */
+    [[nodiscard]] size_t pack_count() const noexcept {
+        return packs.size() + (spill ? spill->pack_count() : 0);
+    }
 };
 
 /**
@@ -57,6 +97,14 @@ public:
     [[nodiscard]] pack_planner_result plan_packs(const pack_planner_config& config,
                                                 std::vector<item> items) {
         pack_planner_result result;
+
+        // Capture sees the items as submitted, before sorting reorders them; the
+        // copy is made before the timer starts so sampled requests are not timed slower
+        std::optional<std::vector<item>> captured_items;
+        if (m_capture && m_capture->should_sample()) {
+            captured_items = items;
+        }
+
         m_timer.start();
 
         // SAFETY: Validate and sanitize configuration
@@ -65,6 +113,12 @@ public:
         safe_config.max_weight_per_pack = std::max(0.1, config.max_weight_per_pack);
         safe_config.thread_count = std::clamp(config.thread_count, 1, 32);
 
+        // Drop items no pack can take before sorting; the strategies only see packable items,
+        // but size their pack caps from every line of the request, as before screening
+        pack_limits limits = safe_config.limits();
+        result.diagnostics = screen_items(items, limits);
+        limits.input_lines = std::max(limits.input_lines, result.diagnostics.lines());
+
         // Sort items
         timer sort_timer;
         sort_timer.start();
@@ -73,7 +127,7 @@ public:
 
         // Create or reuse strategy if config changed
         if (!m_strategy || config != m_config) {
-            m_strategy = pack_strategy_factory::create_strategy(safe_config.type, safe_config.thread_count);
+            m_strategy = pack_strategy_factory::create_strategy(safe_config.type, safe_config.thread_count, m_pool);
             m_config = safe_config;
         }
 
@@ -82,26 +136,149 @@ public:
         // Pack
         timer pack_timer;
         pack_timer.start();
-        result.packs = m_strategy->pack_items(items, safe_config.max_items_per_pack, safe_config.max_weight_per_pack);
+        auto* blocking = dynamic_cast<blocking_pack_strategy*>(m_strategy.get());
+        if (m_checkpoint && blocking) {
+            // Checkpointed planning: the same next-fit packs, resumable after an interruption
+            auto spill = std::make_shared<pack_spill>();
+            result.packs = m_checkpoint->pack_items(items, limits, safe_config.memory_budget_bytes, *spill);
+            if (spill->pack_count() > 0) {
+                result.spill = std::move(spill);
+            }
+        } else if (safe_config.memory_budget_bytes > 0 && blocking) {
+            // Memory-capped planning: closed packs stream to a temporary file
+            auto spill = std::make_shared<pack_spill>();
+            result.packs = blocking->pack_items(items, limits, safe_config.memory_budget_bytes, *spill);
+            if (spill->pack_count() > 0) {
+                result.spill = std::move(spill);
+            }
+        } else {
+            result.packs = m_strategy->pack_items(items, limits);
+        }
         result.packing_time = pack_timer.stop();
 
         result.total_time = m_timer.stop();
 
-        // SAFETY: Calculate total items safely
-        result.total_items = 0;
-        for (const auto& i : items) {
-            // SAFETY: Skip negative quantities and avoid overflow
-            if (i.get_quantity() > 0 &&
-                result.total_items <= std::numeric_limits<int>::max() - i.get_quantity()) {
-                result.total_items += i.get_quantity();
-            }
+        // Units requested, including oversize items that were dropped
+        result.total_items = result.diagnostics.requested_units();
+
+        result.utilization_percent = result.spill
+            ? calculate_utilization(result.packs, *result.spill, safe_config.max_weight_per_pack)
+            : calculate_utilization(result.packs, safe_config.max_weight_per_pack);
+
+        if (captured_items) {
+            m_capture->record(config, std::move(*captured_items), result);
         }
 
-        result.utilization_percent = calculate_utilization(result.packs, safe_config.max_weight_per_pack);
+        // Hand the sorted items to the shadow; the response is already complete
+        if (m_shadow && m_shadow->should_sample()) {
+            m_shadow->submit(limits, std::move(items), result);
+        }
 
         return result;
     }
 
+    /**
+     * @brief Plan many independent orders with one configuration
+     *
+     * Each order gets the result plan_packs would give it. With the blocking
+     * strategy, no memory budget and no capture, shadow or checkpoint attached, the orders
+     * are packed side by side by batch_pack::pack_orders, which removes the
+     * per-order setup that dominates orders of a few dozen lines; otherwise
+     * they are planned one by one. Batched timings are the batch's sort and
+     * pack times split evenly over its orders.
+     *
+     * @param config Configuration shared by every order
+     * @param orders Items of each order
+     * @return std::vector<pack_planner_result> Result of each order, in order
+     */
+    [[nodiscard]] std::vector<pack_planner_result> plan_orders(const pack_planner_config& config,
+                                                               std::vector<std::vector<item>> orders) {
+        std::vector<pack_planner_result> results(orders.size());
+        if (config.type != strategy_type::BLOCKING_FIRST_FIT || config.memory_budget_bytes > 0 ||
+            m_capture || m_shadow || m_checkpoint) {
+            for (std::size_t o = 0; o < orders.size(); ++o) {
+                results[o] = plan_packs(config, std::move(orders[o]));
+            }
+            return results;
+        }
+        if (orders.empty()) return results;
+
+        // SAFETY: Validate and sanitize configuration (as plan_packs)
+        pack_planner_config safe_config = config;
+        safe_config.max_items_per_pack = std::max(1, config.max_items_per_pack);
+        safe_config.max_weight_per_pack = std::max(0.1, config.max_weight_per_pack);
+        const pack_limits limits = safe_config.limits();
+
+        // Pack caps are sized from each order's lines before screening, as in plan_packs
+        std::vector<std::size_t> input_lines(orders.size());
+        timer sort_timer;
+        sort_timer.start();
+        for (std::size_t o = 0; o < orders.size(); ++o) {
+            results[o].diagnostics = screen_items(orders[o], limits);
+            input_lines[o] = std::max(limits.input_lines, results[o].diagnostics.lines());
+            sort_items(orders[o], safe_config.order);
+        }
+        const double sorting_time = sort_timer.stop() / static_cast<double>(orders.size());
+
+        timer pack_timer;
+        pack_timer.start();
+        blocking_pack_strategy blocking;
+        auto packs = batch_pack::pack_orders(orders, limits, input_lines,
+                                             [&](const std::vector<item>& order, const pack_limits& order_limits) {
+            return blocking.pack_items(order, order_limits);
+        });
+        const double packing_time = pack_timer.stop() / static_cast<double>(orders.size());
+
+        for (std::size_t o = 0; o < orders.size(); ++o) {
+            pack_planner_result& result = results[o];
+            result.packs = std::move(packs[o]);
+            result.sorting_time = sorting_time;
+            result.packing_time = packing_time;
+            result.total_time = sorting_time + packing_time;
+            result.total_items = result.diagnostics.requested_units();
+            result.utilization_percent = calculate_utilization(result.packs, safe_config.max_weight_per_pack);
+            result.strategy_name = blocking.get_name();
+        }
+        return results;
+    }
+
+    /**
+     * @brief Record sampled requests into a trace for later replay
+     * @param capture Trace recorder, shareable between planners (null disables capture)
+     */
+    void set_capture(std::shared_ptr<request_capture> capture) noexcept {
+        m_capture = std::move(capture);
+    }
+
+    /**
+     * @brief Evaluate a candidate strategy on sampled requests in the background
+     * @param shadow Shadow runner, shareable between planners (null disables shadowing)
+     */
+    void set_shadow(std::shared_ptr<shadow_runner> shadow) noexcept {
+        m_shadow = std::move(shadow);
+    }
+
+    /**
+     * @brief Run the parallel strategy's chunks on a dedicated pool
+     * @param pool Worker pool (null = thread_pool::shared())
+     */
+    void set_thread_pool(std::shared_ptr<thread_pool> pool) noexcept {
+        m_pool = std::move(pool);
+        m_strategy.reset();   // recreated with the new pool by the next plan
+    }
+
+    /**
+     * @brief Write periodic checkpoints while packing, and resume from them
+     *
+     * Applies to the blocking strategy (with or without a memory budget);
+     * other strategies ignore it.
+     *
+     * @param checkpoint Checkpoint file of the plan (null disables checkpoints)
+     */
+    void set_checkpoint(std::shared_ptr<plan_checkpoint> checkpoint) noexcept {
+        m_checkpoint = std::move(checkpoint);
+    }
+
     /**
      * @brief Output results to a stream
      * @param packs Packs to output
@@ -110,23 +287,79 @@ public:
     void output_results(const std::vector<pack>& packs, std::ostream& output = std::cout) const {
         for (const auto& p : packs) {
             if (!p.is_empty()) {
-                output << p.to_string() << std::endl;
+                // '\n' rather than std::endl: flushing per pack defeats output buffering
+                output << p.to_string() << '\n';
             }
         }
     }
 
+    /**
+     * @brief Output results, including spilled packs, to a stream
+     * @param result Planning result to output
+     * @param output Output stream (defaults to std::cout)
+     */
+    void output_results(const pack_planner_result& result, std::ostream& output = std::cout) const {
+        if (result.spill) {
+            result.spill->for_each([&](const pack& p) {
+                if (!p.is_empty()) {
+                    output << p.to_string() << '\n';
+                }
+            });
+        }
+        output_results(result.packs, output);
+    }
+
     /**
      * @brief Calculate utilization percentage
      * @param packs Packs to calculate utilization for
      * @param max_weight Maximum weight per pack
      * @return double Utilization percentage
      */
-    [[nodiscard]] double calculate_utilization(const std::vector<pack>& packs,
-                                            double max_weight) const noexcept {
-        if (packs.empty() || max_weight <= 0.0) return 0.0;
+    [[nodiscard]] static double calculate_utilization(const std::vector<pack>& packs,
+                                            double max_weight) noexcept {
+        return calculate_utilization(packs, 0.0, 0, max_weight);
+    }
+
+    /**
+     * @brief Calculate utilization percentage over in-memory and spilled packs
+     * @param packs Packs still in memory
+     * @param spill Packs flushed to disk
+     * @param max_weight Maximum weight per pack
+     * @return double Utilization percentage
+     */
+    [[nodiscard]] static double calculate_utilization(const std::vector<pack>& packs,
+                                            const pack_spill& spill,
+                                            double max_weight) noexcept {
+        return calculate_utilization(packs, spill.total_weight(),
+                                     static_cast<int>(spill.non_empty_count()), max_weight);
+    }
 
-        double total_weight = 0.0;
-        int non_empty_packs = 0;
+    /**
+     * @brief Sort items according to sort order
+     *
+     * Stable: items with equal keys keep their input order.
+     *
+     * @param items Items to sort
+     * @param order Sort order to use
+     */
+    static void sort_items(std::vector<item>& items, sort_order order) {
+        item_sort::sort(items, order);
+    }
+
+private:
+    /**
+     * @brief Calculate utilization percentage on top of already accumulated totals
+     * @param packs Packs to add to the totals
+     * @param total_weight Weight already accumulated
+     * @param non_empty_packs Non-empty packs already counted
+     * @param max_weight Maximum weight per pack
+     * @return double Utilization percentage
+     */
+    [[nodiscard]] static double calculate_utilization(const std::vector<pack>& packs,
+                                            double total_weight,
+                                            int non_empty_packs,
+                                            double max_weight) noexcept {
+        if ((packs.empty() && non_empty_packs == 0) || max_weight <= 0.0) return 0.0;
 
         for (const auto& p : packs) {
             if (!p.is_empty()) {
@@ -150,28 +383,11 @@ public:
         return std::clamp((total_weight / max_possible_weight) * 100.0, 0.0, 100.0);
     }
 
-private:
-    /**
-     * @brief Sort items according to sort order
-     * @param items Items to sort
-     * @param order Sort order to use
-     */
-    void sort_items(std::vector<item>& items, sort_order order) noexcept {
-        switch (order) {
-            case sort_order::SHORT_TO_LONG:
-                std::sort(items.begin(), items.end());
-                break;
-            case sort_order::LONG_TO_SHORT:
-                std::sort(items.begin(), items.end(), std::greater<item>());
-                break;
-            case sort_order::NATURAL:
-            default:
-                // Keep original order
-                break;
-        }
-    }
-
     timer m_timer;
     std::unique_ptr<pack_strategy> m_strategy;
     pack_planner_config m_config{};
+    std::shared_ptr<request_capture> m_capture;
+    std::shared_ptr<shadow_runner> m_shadow;
+    std::shared_ptr<plan_checkpoint> m_checkpoint;
+    std::shared_ptr<thread_pool> m_pool;
 };
@@ -0,0 +1,173 @@
+#ifndef PACK_PLANNER_C_H
+#define PACK_PLANNER_C_H
+
+/*
+ * Stable C ABI for the pack planner (libpack_planner.so).
+ *
+ * Lets other runtimes (.NET P/Invoke, Python ctypes/cffi, ...) run the C++
+ * engine in-process. Items are passed as caller-owned column buffers and
+ * results are read back as columns or pack by pack; no text serialization
+ * is involved. All handles are opaque. Functions never throw: failures are
+ * reported as a pack_planner_status, with details from
+ * pack_planner_last_error().
+ *
+ * A planner handle may be used by one thread at a time; results are
+ * independent of their planner and stay valid until freed.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(PACK_PLANNER_C_BUILD)
+#define PACK_PLANNER_C_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define PACK_PLANNER_C_API __declspec(dllimport)
+#else
+#define PACK_PLANNER_C_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped on any incompatible change to the declarations below */
+#define PACK_PLANNER_ABI_VERSION 3
+
+typedef struct pack_planner_handle pack_planner_handle;
+typedef struct pack_planner_plan pack_planner_plan;
+
+typedef enum pack_planner_status {
+    PACK_PLANNER_OK = 0,
+    PACK_PLANNER_INVALID_ARGUMENT = 1,
+    PACK_PLANNER_OUT_OF_RANGE = 2,
+    PACK_PLANNER_OUT_OF_MEMORY = 3,
+    PACK_PLANNER_INTERNAL_ERROR = 4
+} pack_planner_status;
+
+/*
+ * Values match sort_order and strategy_type. Fill with pack_planner_options_init
+ * before setting fields: it sets struct_size, which the library checks. Later
+ * options take the reserved slots, so the struct keeps its size across versions.
+ */
+typedef struct pack_planner_options {
+    uint32_t struct_size;        /* sizeof(pack_planner_options) */
+    int32_t sort_order;          /* 0 natural, 1 short to long, 2 long to short, 3 heavy to light,
+                                    4 short to long heavy first, 5 long to short heavy first */
+    int32_t strategy;            /* 0 blocking first fit, 1 parallel first fit, 2 blocking best fit, 3 parallel best fit */
+    int32_t max_items_per_pack;
+    double max_weight_per_pack;
+    int32_t thread_count;        /* parallel strategies only */
+    int32_t max_length_per_pack; /* longest item a pack may hold (0 = unlimited) */
+    double max_volume_per_pack;  /* combined volume of a pack (0 = unlimited) */
+    uint32_t reserved[8];        /* must be zero */
+} pack_planner_options;
+
+typedef struct pack_planner_stats {
+    double sorting_ms;
+    double packing_ms;
+    double total_ms;
+    int64_t total_items;         /* summed item quantities */
+    double utilization_percent;
+} pack_planner_stats;
+
+typedef struct pack_planner_pack_info {
+    int32_t pack_number;
+    int32_t pack_length;
+    double total_weight;
+    uint32_t first_item;         /* index of the pack's first line in the item columns */
+    uint32_t item_count;         /* number of lines in the pack */
+} pack_planner_pack_info;
+
+typedef struct pack_planner_item_line {
+    int32_t id;
+    int32_t length;
+    int32_t quantity;
+    double weight;
+    float volume;
+} pack_planner_item_line;
+
+/*
+ * Borrowed views of a plan's columns, valid until pack_planner_plan_free.
+ * The lines of pack p are [pack_offsets[p], pack_offsets[p + 1]).
+ */
+typedef struct pack_planner_columns {
+    size_t pack_count;
+    size_t item_count;
+    const uint32_t* pack_offsets;  /* pack_count + 1 entries */
+    const int32_t* pack_numbers;
+    const int32_t* pack_lengths;
+    const double* pack_weights;
+    const int32_t* item_ids;
+    const int32_t* item_lengths;
+    const int32_t* item_quantities;
+    const double* item_weights;
+    const float* item_volumes;
+} pack_planner_columns;
+
+/* ABI version the library was built with (compare with PACK_PLANNER_ABI_VERSION) */
+PACK_PLANNER_C_API uint32_t pack_planner_abi_version(void);
+
+/* Message for the last failed call on this thread ("" if none) */
+PACK_PLANNER_C_API const char* pack_planner_last_error(void);
+
+/* Fill options with the engine defaults, struct_size set and reserved slots zeroed */
+PACK_PLANNER_C_API void pack_planner_options_init(pack_planner_options* options);
+
+/* Create a planner; returns NULL on allocation failure */
+PACK_PLANNER_C_API pack_planner_handle* pack_planner_create(void);
+
+/* Destroy a planner (NULL is ignored); plans it produced stay valid */
+PACK_PLANNER_C_API void pack_planner_destroy(pack_planner_handle* planner);
+
+/*
+ * Plan count items given as four caller-owned columns. The buffers are only
+ * read during the call. On success *out_plan receives a new plan that the
+ * caller must release with pack_planner_plan_free.
+ */
+PACK_PLANNER_C_API pack_planner_status pack_planner_plan_columns(
+    pack_planner_handle* planner, const pack_planner_options* options,
+    const int32_t* ids, const int32_t* lengths, const int32_t* quantities,
+    const double* weights, size_t count, pack_planner_plan** out_plan);
+
+/*
+ * As pack_planner_plan_columns, with a fifth column of per-piece volumes
+ * for max_volume_per_pack (NULL = every volume 0).
+ */
+PACK_PLANNER_C_API pack_planner_status pack_planner_plan_columns_with_volume(
+    pack_planner_handle* planner, const pack_planner_options* options,
+    const int32_t* ids, const int32_t* lengths, const int32_t* quantities,
+    const double* weights, const float* volumes, size_t count, pack_planner_plan** out_plan);
+
+/* Release a plan (NULL is ignored) */
+PACK_PLANNER_C_API void pack_planner_plan_free(pack_planner_plan* plan);
+
+/* Number of non-empty packs in a plan */
+PACK_PLANNER_C_API size_t pack_planner_plan_pack_count(const pack_planner_plan* plan);
+
+/* Number of pack lines across all packs */
+PACK_PLANNER_C_API size_t pack_planner_plan_item_count(const pack_planner_plan* plan);
+
+/* Timing and utilization of a plan */
+PACK_PLANNER_C_API pack_planner_status pack_planner_plan_stats(
+    const pack_planner_plan* plan, pack_planner_stats* out_stats);
+
+/* Name of the strategy that produced the plan, valid until the plan is freed */
+PACK_PLANNER_C_API const char* pack_planner_plan_strategy_name(const pack_planner_plan* plan);
+
+/* Describe pack `index` (0-based, in pack order) */
+PACK_PLANNER_C_API pack_planner_status pack_planner_plan_pack(
+    const pack_planner_plan* plan, size_t index, pack_planner_pack_info* out_pack);
+
+/* Read pack line `index` (0-based, across all packs in pack order) */
+PACK_PLANNER_C_API pack_planner_status pack_planner_plan_item(
+    const pack_planner_plan* plan, size_t index, pack_planner_item_line* out_item);
+
+/* Borrow every column of a plan at once, without copying */
+PACK_PLANNER_C_API pack_planner_status pack_planner_plan_get_columns(
+    const pack_planner_plan* plan, pack_planner_columns* out_columns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PACK_PLANNER_C_H */
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "item.h"
+#include "pack.h"
+
+/**
+ * @brief Temporary on-disk store for finalized packs
+ *
+ * Packs are appended in a compact binary plan format and streamed back in
+ * the order they were written, one pack in memory at a time. The file is an
+ * anonymous temporary (std::tmpfile) and disappears when the spill is destroyed.
+ *
+ * Record layout (native byte order, never leaves the machine):
+ *   int32 pack_number, int32 item_count,
+ *   item_count x { int32 id, int32 length, int32 quantity, float64 weight, float32 volume }
+ */
+class pack_spill {
+public:
+    /**
+     * @brief Construct a new pack spill backed by a temporary file
+     */
+    pack_spill() noexcept
+        : m_file(std::tmpfile()) {
+        if (m_file) {
+            // Large stdio buffer: records are small and written sequentially
+            m_buffer = std::make_unique<char[]>(BUFFER_SIZE);
+            std::setvbuf(m_file, m_buffer.get(), _IOFBF, BUFFER_SIZE);
+        }
+    }
+
+    ~pack_spill() {
+        if (m_file) std::fclose(m_file);
+    }
+
+    pack_spill(const pack_spill&) = delete;
+    pack_spill& operator=(const pack_spill&) = delete;
+
+    /**
+     * @brief Check whether the temporary file is usable
+     * @return bool True if packs can be spilled
+     */
+    [[nodiscard]] bool is_open() const noexcept { return m_file != nullptr && !m_error; }
+
+    /**
+     * @brief Check whether a write or read failed
+     * @return bool True if an I/O error occurred
+     */
+    [[nodiscard]] bool has_error() const noexcept { return m_error; }
+
+    /**
+     * @brief Append a finalized pack
+     * @param p The pack to write
+     * @return bool True if the pack was written
+     */
+    bool write(const pack& p) noexcept {
+        if (!is_open()) return false;
+
+        const auto& items = p.get_items();
+        const std::int32_t header[2] = {p.get_pack_number(), static_cast<std::int32_t>(items.size())};
+        bool ok = std::fwrite(header, sizeof(header), 1, m_file) == 1;
+
+        for (const auto& i : items) {
+            record r{i.get_id(), i.get_length(), i.get_quantity(), i.get_weight(),
+                     static_cast<float>(i.get_volume())};
+            ok = ok && std::fwrite(&r, sizeof(r), 1, m_file) == 1;
+        }
+
+        if (!ok) {
+            m_error = true;
+            return false;
+        }
+
+        ++m_pack_count;
+        if (!p.is_empty()) {
+            ++m_non_empty_count;
+            m_total_weight += p.get_total_weight();
+        }
+        m_bytes_written += sizeof(header) + items.size() * sizeof(record);
+        return true;
+    }
+
+    /**
+     * @brief Stream every spilled pack back in write order
+     * @param fn Callback invoked with each reconstructed pack
+     * @return bool True if all packs were read back
+     */
+    template <typename Fn>
+    bool for_each(Fn&& fn) const {
+        if (!m_file || m_error) return false;
+        if (std::fflush(m_file) != 0 || std::fseek(m_file, 0, SEEK_SET) != 0) return false;
+
+        std::vector<record> records;
+        bool ok = true;
+        for (std::size_t n = 0; n < m_pack_count; ++n) {
+            std::int32_t header[2];
+            if (std::fread(header, sizeof(header), 1, m_file) != 1 || header[1] < 0) {
+                ok = false;
+                break;
+            }
+
+            records.resize(static_cast<std::size_t>(header[1]));
+            if (!records.empty() &&
+                std::fread(records.data(), sizeof(record), records.size(), m_file) != records.size()) {
+                ok = false;
+                break;
+            }
+
+            // add_item repeats the original accumulation, so totals match bit for bit
+            pack p(header[0]);
+            for (const auto& r : records) {
+                (void)p.add_item(item(r.id, r.length, r.quantity, r.weight, r.volume),
+                                 std::numeric_limits<int>::max(),
+                                 std::numeric_limits<double>::infinity());
+            }
+            fn(static_cast<const pack&>(p));
+        }
+
+        // Leave the file positioned for further appends
+        std::fseek(m_file, 0, SEEK_END);
+        return ok;
+    }
+
+    /**
+     * @brief Get the number of spilled packs
+     * @return size_t Number of packs written
+     */
+    [[nodiscard]] std::size_t pack_count() const noexcept { return m_pack_count; }
+
+    /**
+     * @brief Get the number of spilled packs that hold items
+     * @return size_t Number of non-empty packs written
+     */
+    [[nodiscard]] std::size_t non_empty_count() const noexcept { return m_non_empty_count; }
+
+    /**
+     * @brief Get the combined weight of all spilled packs
+     * @return double Total weight
+     */
+    [[nodiscard]] double total_weight() const noexcept { return m_total_weight; }
+
+    /**
+     * @brief Get the size of the spill file
+     * @return size_t Bytes written
+     */
+    [[nodiscard]] std::size_t bytes_written() const noexcept { return m_bytes_written; }
+
+    /**
+     * @brief Estimate the memory a pack holds while it stays in a std::vector<pack>
+     * @param p The pack to measure
+     * @return size_t Approximate bytes including the item storage
+     */
+    [[nodiscard]] static std::size_t memory_footprint(const pack& p) noexcept {
+        return sizeof(pack) + p.get_items().capacity() * sizeof(item);
+    }
+
+private:
+#pragma pack(push, 1)
+    struct record {
+        std::int32_t id;
+        std::int32_t length;
+        std::int32_t quantity;
+        double weight;
+        float volume;
+    };
+#pragma pack(pop)
+
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+    std::FILE* m_file;
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_pack_count = 0;
+    std::size_t m_non_empty_count = 0;
+    std::size_t m_bytes_written = 0;
+    double m_total_weight = 0.0;
+    bool m_error = false;
+};
@@ -5,6 +5,8 @@
 #include "item.h"
 #include "pack.h"
 
+class thread_pool;
+
 enum class strategy_type {
     BLOCKING_FIRST_FIT,
     PARALLEL_FIRST_FIT,
@@ -30,6 +32,19 @@ public:
                                        int max_items,
                                        double max_weight) = 0;
 
+    /**
+     * @brief Pack items under per-pack limits, including the optional ones
+     *
+     * Strategies that do not override this enforce only max_items and max_weight.
+     *
+     * @param items Items to pack
+     * @param limits Per-pack limits
+     * @return std::vector<pack> Vector of packed items
+     */
+    virtual std::vector<pack> pack_items(const std::vector<item>& items, const pack_limits& limits) {
+        return pack_items(items, limits.max_items, limits.max_weight);
+    }
+
     /**
      * @brief Get strategy name for identification
      * @return std::string Strategy name
@@ -46,11 +61,13 @@ public:
      * @brief Create a pack strategy
      * @param type Strategy type to create
      * @param thread_count Number of threads for parallel strategy (ignored for others)
+     * @param pool Worker pool for parallel strategy (null = thread_pool::shared())
      * @return std::unique_ptr<pack_strategy> Created strategy
      */
     static std::unique_ptr<pack_strategy> create_strategy(
         strategy_type type,
-        int thread_count = 4);
+        int thread_count = 4,
+        std::shared_ptr<thread_pool> pool = nullptr);
 
     /**
      * @brief Parse strategy type from string
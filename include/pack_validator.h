@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "item.h"
+
+struct pack_planner_config;
+struct pack_planner_result;
+struct plan_columns;
+
+/**
+ * @brief One constraint violation found in a plan
+ */
+struct validation_issue {
+    enum class kind {
+        ITEM_LIMIT,         // pack holds more than max_items_per_pack units
+        WEIGHT_LIMIT,       // pack weighs more than max_weight_per_pack
+        LENGTH_LIMIT,       // pack holds an item longer than max_length_per_pack
+        VOLUME_LIMIT,       // pack's combined volume exceeds max_volume_per_pack
+        PACK_TOTALS,        // recorded pack length/weight disagree with its lines
+        QUANTITY_MISMATCH,  // units of an item id packed != units requested
+        SORT_ORDER          // line lengths/weights break the configured sort order
+    };
+
+    kind type;
+    int pack_number = 0;    // 0 for issues not tied to one pack
+    int item_id = 0;        // 0 for issues not tied to one item
+    std::string message;
+};
+
+/**
+ * @brief Outcome of validating one plan
+ */
+struct validation_report {
+    std::size_t packs_checked = 0;
+    std::size_t lines_checked = 0;
+    std::size_t issue_count = 0;            // all violations, including unreported ones
+    std::size_t unpackable_items = 0;       // items whose single unit exceeds a limit (expected to be left out)
+    std::vector<validation_issue> issues;   // the first max_reported_issues violations
+    double elapsed_ms = 0.0;
+
+    [[nodiscard]] bool ok() const noexcept { return issue_count == 0; }
+};
+
+/**
+ * @brief Independent checker for planning results
+ *
+ * Recomputes every constraint from the packed lines rather than trusting the
+ * planner's bookkeeping:
+ *  - each pack holds at most max_items_per_pack units and max_weight_per_pack weight,
+ *    no item longer than max_length_per_pack and at most max_volume_per_pack volume
+ *    (each if set), and its recorded length and weight match its lines;
+ *  - for every item id, the units packed across all splits equal the units
+ *    requested (items that cannot fit even one unit must be left out);
+ *  - for every order but NATURAL, no line sorts strictly before the line preceding
+ *    it in pack order (item_sort::precedes on length and piece weight).
+ *
+ * Packs are checked in parallel chunks on the shared thread pool over the flat
+ * plan_columns arrays (branch-light loops the compiler vectorizes), while the
+ * quantity reconciliation runs as one more task of the same batch.
+ */
+class pack_validator {
+public:
+    /**
+     * @brief Create a validator
+     * @param max_reported_issues Violations kept in detail (all are counted)
+     */
+    explicit pack_validator(std::size_t max_reported_issues = 32) noexcept
+        : m_max_reported_issues(max_reported_issues) {}
+
+    /**
+     * @brief Validate a planning result against its request
+     * @param config Configuration the plan was made with
+     * @param items Items as submitted to the planner
+     * @param result Planning result, including spilled packs
+     * @return validation_report Findings
+     */
+    [[nodiscard]] validation_report validate(const pack_planner_config& config,
+                                             const std::vector<item>& items,
+                                             const pack_planner_result& result) const;
+
+    /**
+     * @brief Validate a plan already flattened into columns
+     * @param config Configuration the plan was made with
+     * @param items Items as submitted to the planner
+     * @param columns Flattened plan
+     * @return validation_report Findings
+     */
+    [[nodiscard]] validation_report validate(const pack_planner_config& config,
+                                             const std::vector<item>& items,
+                                             const plan_columns& columns) const;
+
+private:
+    std::size_t m_max_reported_issues;
+};
+
+/**
+ * @brief Print a validation report
+ * @param report Report to print
+ * @param output Stream to write to
+ */
+void output_validation_report(const validation_report& report, std::ostream& output);
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "pack_strategy.h"
+#include "thread_pool.h"
 #include <thread>
 #include <future>
 #include <mutex>
 #include <atomic>
 #include <algorithm>
+#include <memory>
 
 /**
  * @brief Parallel pack strategy using multiple threads
@@ -14,36 +16,38 @@
 class parallel_pack_strategy : public pack_strategy {
 private:
     unsigned int m_num_threads;
+    std::shared_ptr<thread_pool> m_pool;   // null = thread_pool::shared()
 
     /**
      * @brief Worker function for a thread to process a chunk of items
+     * @tparam Constraints pack_constraints<...> list to enforce
      * @param items Items to process
      * @param start_idx Starting index in the items vector
      * @param end_idx Ending index in the items vector
-     * @param max_items Maximum items per pack
-     * @param max_weight Maximum weight per pack
-     * @param result_packs Vector to store resulting packs
+     * @param limits Per-pack limits
+     * @param chunk_packs Vector to store this chunk's packs
      * @param next_pack_number Atomic counter for pack numbers
-     * @param mutex Mutex for thread synchronization
      */
+    template <typename Constraints>
     void worker_thread(
         const std::vector<item>& items,
         size_t start_idx,
         size_t end_idx,
-        int max_items,
-        double max_weight,
-        std::vector<pack>& result_packs,
-        std::atomic<int>& next_pack_number,
-        std::mutex& mutex) {
+        pack_limits limits,
+        std::vector<pack>& chunk_packs,
+        std::atomic<int>& next_pack_number) {
 
         // SAFETY: Validate constraints to prevent infinite loops
-        max_items = std::max(1, max_items);
-        max_weight = std::max(0.1, max_weight);
+        limits.max_items = std::max(1, limits.max_items);
+        limits.max_weight = std::max(0.1, limits.max_weight);
 
         // Process items in this thread's chunk
         std::vector<pack> local_packs;
         // SAFETY: Limit initial allocation to prevent OOM with extreme values
-        const size_t max_safe_reserve = std::min<size_t>(20000, (end_idx - start_idx) / 10 + 500);
+        // (the chunk's share of the request's lines, so screening does not lower the cap)
+        const size_t chunk_lines = (end_idx - start_idx) * limits.cap_lines(items.size()) /
+                                   std::max<size_t>(1, items.size());
+        const size_t max_safe_reserve = std::min<size_t>(20000, chunk_lines / 10 + 500);
         local_packs.reserve(std::min(max_safe_reserve,
                         std::max<size_t>(16, static_cast<size_t>((end_idx - start_idx) * 0.00222) + 8)));
 
@@ -70,20 +74,21 @@ private:
                 }
 
                 pack& current_pack = local_packs.back();
-                int added_quantity = current_pack.add_partial_item(
+                int added_quantity = current_pack.template add_partial_item<Constraints>(
                     item.get_id(),
                     item.get_length(),
                     remaining_quantity,
                     item.get_weight(),
-                    max_items,
-                    max_weight);
+                    item.get_volume(),
+                    limits);
 
                 if (added_quantity > 0) {
                     remaining_quantity -= added_quantity;
                 } else {
-                    // Check if this item can never fit (weight exceeds max_weight)
-                    if (item.get_weight() > max_weight) {
-                        // Item is too heavy to fit in any pack, skip it
+                    // Check if this item can never fit (e.g. weight exceeds max_weight)
+                    if (!Constraints::admits(unit_offer{item.get_length(), remaining_quantity,
+                                                        item.get_weight(), item.get_volume()}, limits)) {
+                        // Item is too heavy (or long, or bulky) for any pack, skip it
                         remaining_quantity = 0;
                         break;
                     }
@@ -106,27 +111,17 @@ private:
             }
         }
 
-        // Merge local results into the shared result vector
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            // SAFETY: Limit the total number of packs to prevent OOM
-            const size_t max_total_packs = std::min<size_t>(200000, items.size() / 5 + 10000);
-            if (result_packs.size() < max_total_packs) {
-                result_packs.insert(result_packs.end(),
-                                local_packs.begin(),
-                                local_packs.begin() + std::min(local_packs.size(),
-                                                                max_total_packs - result_packs.size()));
-            }
-        }
+        chunk_packs = std::move(local_packs);
     }
 
 public:
     /**
      * @brief Construct a new parallel packing strategy
      * @param num_threads Number of threads to use (0 = use hardware concurrency)
+     * @param pool Worker pool to run the chunks on (null = thread_pool::shared())
      */
-    explicit parallel_pack_strategy(int thread_count = 4)
-        : m_num_threads(thread_count)
+    explicit parallel_pack_strategy(int thread_count = 4, std::shared_ptr<thread_pool> pool = nullptr)
+        : m_num_threads(thread_count), m_pool(std::move(pool))
     {
         if (m_num_threads == 0) {
             m_num_threads = std::thread::hardware_concurrency();
@@ -143,9 +138,38 @@ public:
     std::vector<pack> pack_items(const std::vector<item>& items,
                             int max_items,
                             double max_weight) override {
+        return pack_items_impl<default_constraints>(items, pack_limits{max_items, max_weight});
+    }
+
+    /**
+     * @brief Pack items into packs using multiple threads under per-pack limits
+     * @param items Items to pack
+     * @param limits Per-pack limits, including the optional ones
+     * @return std::vector<pack> Vector of packs
+     */
+    std::vector<pack> pack_items(const std::vector<item>& items, const pack_limits& limits) override {
+        return with_pack_constraints(limits, [&](auto constraints) {
+            return pack_items_impl<decltype(constraints)>(items, limits);
+        });
+    }
+
+    std::string get_name() const override {
+        return "Parallel(" + std::to_string(m_num_threads) + " threads)";
+    }
+
+private:
+    /**
+     * @brief Sequential fallback or chunked parallel packing for one constraint list
+     * @tparam Constraints pack_constraints<...> list to enforce
+     * @param items Items to pack
+     * @param limits Per-pack limits
+     * @return std::vector<pack> Vector of packs
+     */
+    template <typename Constraints>
+    std::vector<pack> pack_items_impl(const std::vector<item>& items, pack_limits limits) {
         // SAFETY: Validate constraints to prevent infinite loops
-        max_items = std::max(1, max_items);
-        max_weight = std::max(0.1, max_weight);
+        limits.max_items = std::max(1, limits.max_items);
+        limits.max_weight = std::max(0.1, limits.max_weight);
 
         // SAFETY: Limit thread count to a reasonable number
         m_num_threads = std::min(static_cast<unsigned int>(32),
@@ -156,7 +180,7 @@ public:
         if (items.size() < 5000 || m_num_threads == 1) {
             // SAFETY: Same fixes as in blocking strategy
             std::vector<pack> packs;
-            const size_t max_safe_reserve = std::min<size_t>(100000, items.size() / 10 + 1000);
+            const size_t max_safe_reserve = std::min<size_t>(100000, limits.cap_lines(items.size()) / 10 + 1000);
             packs.reserve(std::min(max_safe_reserve,
                         std::max<size_t>(64, static_cast<size_t>(items.size() * 0.00222) + 16)));
             int pack_number = 1;
@@ -181,15 +205,17 @@ public:
 
                     pack& current_pack = packs.back();
                     int added_quantity =
-                        current_pack.add_partial_item(i.get_id(), i.get_length(), remaining_quantity,
-                                                    i.get_weight(), max_items, max_weight);
+                        current_pack.template add_partial_item<Constraints>(
+                            i.get_id(), i.get_length(), remaining_quantity,
+                            i.get_weight(), i.get_volume(), limits);
 
                     if (added_quantity > 0) {
                         remaining_quantity -= added_quantity;
                     } else {
-                        // Check if this item can never fit (weight exceeds max_weight)
-                        if (i.get_weight() > max_weight) {
-                            // Item is too heavy to fit in any pack, skip it
+                        // Check if this item can never fit (e.g. weight exceeds max_weight)
+                        if (!Constraints::admits(unit_offer{i.get_length(), remaining_quantity,
+                                                            i.get_weight(), i.get_volume()}, limits)) {
+                            // Item is too heavy (or long, or bulky) for any pack, skip it
                             remaining_quantity = 0;
                             break;
                         }
@@ -213,47 +239,35 @@ public:
         }
 
         // For parallel processing
-        std::vector<pack> result_packs;
-        std::mutex result_mutex;
+        std::vector<std::vector<pack>> chunk_packs(m_num_threads);
         std::atomic<int> next_pack_number{1};
 
         // Calculate chunk size for each thread
         size_t chunk_size = items.size() / m_num_threads;
         size_t remainder = items.size() % m_num_threads;
 
-        // Create and start threads
-        std::vector<std::thread> threads;
-        threads.reserve(m_num_threads);
-
-        size_t start_idx = 0;
+        // Chunk start offsets, distributing the remainder among the first chunks
+        std::vector<size_t> chunk_starts(m_num_threads + 1, 0);
         for (unsigned int i = 0; i < m_num_threads; ++i) {
-            // Distribute remainder items among first 'remainder' threads
-            size_t thread_chunk_size = chunk_size + (i < remainder ? 1 : 0);
-            size_t end_idx = start_idx + thread_chunk_size;
-
-            threads.emplace_back(&parallel_pack_strategy::worker_thread,
-                                this,
-                                std::ref(items),
-                                start_idx,
-                                end_idx,
-                                max_items,
-                                max_weight,
-                                std::ref(result_packs),
-                                std::ref(next_pack_number),
-                                std::ref(result_mutex));
-
-            start_idx = end_idx;
+            chunk_starts[i + 1] = chunk_starts[i] + chunk_size + (i < remainder ? 1 : 0);
         }
 
-        // Wait for all threads to complete
-        for (auto& thread : threads) {
-            thread.join();
-        }
+        // Run the chunks on the persistent pool rather than spawning threads per call
+        thread_pool& pool = m_pool ? *m_pool : thread_pool::shared();
+        pool.run_batch(m_num_threads, [&](size_t i) {
+            worker_thread<Constraints>(items, chunk_starts[i], chunk_starts[i + 1], limits,
+                                       chunk_packs[i], next_pack_number);
+        });
 
+        // Merge in chunk order so the packs follow the sorted input, whichever thread finished first
+        // SAFETY: Limit the total number of packs to prevent OOM
+        const size_t max_total_packs = std::min<size_t>(200000, limits.cap_lines(items.size()) / 5 + 10000);
+        std::vector<pack> result_packs;
+        for (auto& packs : chunk_packs) {
+            const size_t take = std::min(packs.size(), max_total_packs - result_packs.size());
+            result_packs.insert(result_packs.end(), std::make_move_iterator(packs.begin()),
+                                std::make_move_iterator(packs.begin() + take));
+        }
         return result_packs;
     }
-
-    std::string get_name() const override {
-        return "Parallel(" + std::to_string(m_num_threads) + " threads)";
-    }
 };
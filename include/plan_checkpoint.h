@@ -0,0 +1,454 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "item.h"
+#include "pack.h"
+#include "pack_constraints.h"
+#include "pack_cursor.h"
+#include "pack_spill.h"
+
+/**
+ * @brief Periodic on-disk checkpoints of a sequential plan, and resuming from them
+ *
+ * Packs with pack_cursor, so the packs are exactly those of
+ * blocking_pack_strategy. Next-fit never revisits a closed pack, so closed
+ * packs are appended to the checkpoint file as they close and are final.
+ * Every interval a state entry follows them: the input offset (item index
+ * and units left of it), the pack number, the safety counter, the number of
+ * closed packs written so far (the output offset) and the open pack. The
+ * file is flushed and fsync'd after each state entry.
+ *
+ * Resuming reads the file up to its last complete state entry, drops
+ * whatever follows it (e.g. a write cut short by preemption), feeds the
+ * closed packs before it to the output again and continues the cursor from
+ * the saved state. The final plan is the one an uninterrupted run gives.
+ *
+ * The header holds a fingerprint of the screened, sorted items and the
+ * limits; a checkpoint is only resumed against the same input and settings.
+ *
+ * File layout (native byte order, for resuming on the same machine):
+ *   header: char[8] "PPCKPT01", uint64 fingerprint, uint64 item_count
+ *   'P' entry: one closed pack in the pack_spill record layout
+ *   'S' entry: uint64 index, int32 remaining_quantity, int32 pack_number,
+ *              int32 safety_counter, uint64 closed_packs, open pack record,
+ *              uint32 end marker
+ */
+class plan_checkpoint {
+public:
+    // Placement steps between clock checks (and between flushes of closed packs)
+    static constexpr std::size_t DEFAULT_CHECK_STEPS = 1 << 16;
+
+    /**
+     * @brief Construct a checkpoint writer, optionally resuming an earlier run
+     * @param path Checkpoint file on local disk
+     * @param resume Continue from the file if it holds a checkpoint (a missing file starts afresh)
+     * @param interval Time between state entries (zero writes one every check_steps steps)
+     * @param check_steps Placement steps between clock checks
+     */
+    explicit plan_checkpoint(std::string path, bool resume = false,
+                             std::chrono::milliseconds interval = std::chrono::seconds(60),
+                             std::size_t check_steps = DEFAULT_CHECK_STEPS) noexcept
+        : m_path(std::move(path)), m_resume(resume), m_interval(interval),
+          m_check_steps(std::max<std::size_t>(1, check_steps)) {}
+
+    ~plan_checkpoint() { close(); }
+
+    plan_checkpoint(const plan_checkpoint&) = delete;
+    plan_checkpoint& operator=(const plan_checkpoint&) = delete;
+
+    /**
+     * @brief Pack items sequentially, writing checkpoints as packing advances
+     *
+     * Closed packs are kept in memory or, with a memory budget, flushed to the
+     * spill whenever they exceed it, as blocking_pack_strategy does.
+     * On an error (unreadable or mismatched checkpoint, failed write) packing
+     * stops and has_error() is set; the checkpoint file keeps the last state
+     * written, so a later run can still resume from it.
+     *
+     * @param items Items to pack, screened and sorted; left unchanged on return
+     * @param limits Per-pack limits
+     * @param memory_budget Bytes of packs to keep in memory before spilling (0 = unlimited)
+     * @param spill Spill file receiving flushed packs
+     * @return std::vector<pack> Packs in memory, following those in the spill
+     */
+    std::vector<pack> pack_items(std::vector<item>& items, const pack_limits& limits,
+                                 std::size_t memory_budget, pack_spill& spill) {
+        m_output.clear();
+        m_held_bytes = 0;
+        m_memory_budget = memory_budget;
+        m_spill = &spill;
+
+        const std::uint64_t fingerprint = fingerprint_of(items, limits);
+        std::optional<pack_cursor> cursor;
+        if (m_resume && open_existing(fingerprint, items.size())) {
+            resume_cursor(cursor, items, limits);
+        } else if (!m_error) {
+            start_file(fingerprint, items.size());
+            cursor.emplace(std::move(items), limits);
+        }
+        if (m_error) {
+            if (cursor) items = cursor->take_items();
+            return {};
+        }
+
+        auto last_state = std::chrono::steady_clock::now();
+        while (!cursor->done()) {
+            cursor->advance(m_check_steps);
+            for (auto& p : cursor->take_closed_packs()) {
+                if (!write_pack_entry(p)) break;
+                keep(std::move(p));
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (!m_error && (cursor->done() || now - last_state >= m_interval)) {
+                write_state_entry(*cursor);
+                last_state = now;
+            }
+            if (m_error) break;
+        }
+
+        // The open (last) pack follows the closed ones and is never spilled
+        for (auto& p : cursor->take_packs()) {
+            m_output.push_back(std::move(p));
+        }
+        items = cursor->take_items();
+        return std::move(m_output);
+    }
+
+    /**
+     * @brief Close and delete the checkpoint file (once the plan has been delivered)
+     * @return bool True if the file was removed
+     */
+    bool remove() noexcept {
+        close();
+        return std::remove(m_path.c_str()) == 0;
+    }
+
+    /**
+     * @brief Check whether the checkpoint could not be read or written
+     * @return bool True if an error occurred
+     */
+    [[nodiscard]] bool has_error() const noexcept { return m_error; }
+
+    /**
+     * @brief Get a description of the error
+     * @return const std::string& Error message (empty without an error)
+     */
+    [[nodiscard]] const std::string& error_message() const noexcept { return m_error_message; }
+
+    /**
+     * @brief Check whether the last plan continued from an earlier checkpoint
+     * @return bool True if packing resumed from a saved state
+     */
+    [[nodiscard]] bool resumed() const noexcept { return m_resumed; }
+
+    /**
+     * @brief Get the item index the last plan resumed from
+     * @return size_t Input offset of the resumed state (0 when not resumed)
+     */
+    [[nodiscard]] std::size_t resumed_from() const noexcept { return m_resumed_from; }
+
+    /**
+     * @brief Get the number of state entries written by the last plan
+     * @return size_t Checkpoints written
+     */
+    [[nodiscard]] std::size_t checkpoints_written() const noexcept { return m_checkpoints; }
+
+    /**
+     * @brief Fingerprint items and limits, to tie a checkpoint to its input
+     * @param items Items in packing order
+     * @param limits Per-pack limits
+     * @return uint64_t Hash of every field of every item and of the limits
+     */
+    [[nodiscard]] static std::uint64_t fingerprint_of(const std::vector<item>& items,
+                                                      const pack_limits& limits) noexcept {
+        std::uint64_t hash = mix(0x9E3779B97F4A7C15ull, items.size());
+        hash = mix(hash, static_cast<std::uint64_t>(limits.max_items));
+        hash = mix(hash, std::bit_cast<std::uint64_t>(limits.max_weight));
+        hash = mix(hash, static_cast<std::uint64_t>(limits.max_length));
+        hash = mix(hash, std::bit_cast<std::uint64_t>(limits.max_volume));
+        hash = mix(hash, limits.cap_lines(items.size()));   // sizes the pack cap
+        for (const auto& i : items) {
+            hash = mix(hash, (static_cast<std::uint64_t>(static_cast<std::uint32_t>(i.get_id())) << 32) |
+                             static_cast<std::uint32_t>(i.get_length()));
+            hash = mix(hash, (static_cast<std::uint64_t>(static_cast<std::uint32_t>(i.get_quantity())) << 32) |
+                             std::bit_cast<std::uint32_t>(static_cast<float>(i.get_volume())));
+            hash = mix(hash, std::bit_cast<std::uint64_t>(i.get_weight()));
+        }
+        return hash;
+    }
+
+private:
+#pragma pack(push, 1)
+    struct header {
+        char magic[8];
+        std::uint64_t fingerprint;
+        std::uint64_t item_count;
+    };
+
+    // Same layout as a pack_spill record
+    struct record {
+        std::int32_t id;
+        std::int32_t length;
+        std::int32_t quantity;
+        double weight;
+        float volume;
+    };
+
+    struct state_record {
+        std::uint64_t index;
+        std::int32_t remaining_quantity;
+        std::int32_t pack_number;
+        std::int32_t safety_counter;
+        std::uint64_t closed_packs;
+    };
+#pragma pack(pop)
+
+    static constexpr char MAGIC[8] = {'P', 'P', 'C', 'K', 'P', 'T', '0', '1'};
+    static constexpr char PACK_ENTRY = 'P';
+    static constexpr char STATE_ENTRY = 'S';
+    static constexpr std::uint32_t END_MARKER = 0x454E4421;   // "!DNE"
+    static constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+    static std::uint64_t mix(std::uint64_t hash, std::uint64_t value) noexcept {
+        hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        return hash ^ (hash >> 29);
+    }
+
+    void fail(std::string message) {
+        if (!m_error) m_error_message = std::move(message);
+        m_error = true;
+    }
+
+    bool open_file(const char* mode) {
+        close();
+        m_file = std::fopen(m_path.c_str(), mode);
+        if (!m_file) return false;
+        m_buffer = std::make_unique<char[]>(BUFFER_SIZE);
+        std::setvbuf(m_file, m_buffer.get(), _IOFBF, BUFFER_SIZE);
+        return true;
+    }
+
+    void close() noexcept {
+        if (m_file) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    void start_file(std::uint64_t fingerprint, std::size_t item_count) {
+        m_resumed = false;
+        m_resumed_from = 0;
+        m_checkpoints = 0;
+        m_closed_packs = 0;
+        if (!open_file("w+b")) {
+            fail("Could not create checkpoint file: " + m_path);
+            return;
+        }
+        header h{};
+        std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+        h.fingerprint = fingerprint;
+        h.item_count = item_count;
+        if (std::fwrite(&h, sizeof(h), 1, m_file) != 1 || !sync()) {
+            fail("Could not write checkpoint file: " + m_path);
+        }
+    }
+
+    // Open the file for resuming; false (without an error) when there is nothing to resume
+    bool open_existing(std::uint64_t fingerprint, std::size_t item_count) {
+        if (!open_file("r+b")) return false;
+        header h{};
+        if (std::fread(&h, sizeof(h), 1, m_file) != 1) {
+            close();
+            return false;   // empty or cut short before the header was complete
+        }
+        if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            fail("Not a checkpoint file: " + m_path);
+        } else if (h.fingerprint != fingerprint || h.item_count != item_count) {
+            fail("Checkpoint " + m_path + " was written for different input or settings");
+        }
+        if (m_error) close();
+        return !m_error;
+    }
+
+    bool read_pack(pack* out) {
+        std::int32_t counts[2];
+        if (std::fread(counts, sizeof(counts), 1, m_file) != 1 || counts[1] < 0) return false;
+        if (!out) {
+            return std::fseek(m_file, static_cast<long>(counts[1]) * static_cast<long>(sizeof(record)),
+                              SEEK_CUR) == 0;
+        }
+        m_records.resize(static_cast<std::size_t>(counts[1]));
+        if (!m_records.empty() &&
+            std::fread(m_records.data(), sizeof(record), m_records.size(), m_file) != m_records.size()) {
+            return false;
+        }
+        // add_item repeats the original accumulation, so totals match bit for bit
+        *out = pack(counts[0]);
+        for (const auto& r : m_records) {
+            (void)out->add_item(item(r.id, r.length, r.quantity, r.weight, r.volume),
+                                std::numeric_limits<int>::max(), std::numeric_limits<double>::infinity());
+        }
+        return true;
+    }
+
+    bool read_state(state_record& s, pack* open_pack) {
+        std::uint32_t end = 0;
+        return std::fread(&s, sizeof(s), 1, m_file) == 1 && read_pack(open_pack) &&
+               std::fread(&end, sizeof(end), 1, m_file) == 1 && end == END_MARKER;
+    }
+
+    void resume_cursor(std::optional<pack_cursor>& cursor, std::vector<item>& items, const pack_limits& limits) {
+        m_checkpoints = 0;
+
+        // Pass 1: find the last complete state entry, skipping pack bodies
+        long good_end = static_cast<long>(sizeof(header));
+        long state_at = -1;
+        std::uint64_t packs_seen = 0;
+        for (;;) {
+            const long entry_at = std::ftell(m_file);
+            char tag = 0;
+            if (std::fread(&tag, 1, 1, m_file) != 1) break;
+            if (tag == PACK_ENTRY) {
+                if (!read_pack(nullptr)) break;
+                ++packs_seen;
+            } else if (tag == STATE_ENTRY) {
+                state_record s{};
+                if (!read_state(s, nullptr) || s.closed_packs != packs_seen) break;
+                state_at = entry_at;
+                good_end = std::ftell(m_file);
+            } else {
+                break;
+            }
+        }
+
+        // Pass 2: replay the closed packs before that entry, then load its state
+        std::fseek(m_file, static_cast<long>(sizeof(header)), SEEK_SET);
+        if (state_at >= 0) {
+            pack p(0);
+            while (std::ftell(m_file) < state_at) {
+                char tag = 0;
+                state_record earlier{};
+                const bool ok = std::fread(&tag, 1, 1, m_file) == 1 &&
+                                (tag == PACK_ENTRY ? read_pack(&p) : read_state(earlier, nullptr));
+                if (!ok) {
+                    fail("Could not read checkpoint file: " + m_path);
+                    return;
+                }
+                if (tag == PACK_ENTRY) keep(std::move(p));
+            }
+            char tag = 0;
+            state_record s{};
+            pack open_pack(0);
+            if (std::fread(&tag, 1, 1, m_file) != 1 || !read_state(s, &open_pack)) {
+                fail("Could not read checkpoint file: " + m_path);
+                return;
+            }
+            m_closed_packs = s.closed_packs;
+            m_resumed = true;
+            m_resumed_from = static_cast<std::size_t>(s.index);
+            cursor.emplace(std::move(items), limits,
+                           pack_cursor::state{static_cast<std::size_t>(s.index), s.remaining_quantity,
+                                              s.pack_number, s.safety_counter},
+                           std::move(open_pack));
+        } else {
+            m_closed_packs = 0;
+            m_resumed = false;
+            m_resumed_from = 0;
+            cursor.emplace(std::move(items), limits);
+        }
+
+        // Drop anything after the last complete state and append from there
+        std::fflush(m_file);
+        if (ftruncate(fileno(m_file), good_end) != 0 || std::fseek(m_file, good_end, SEEK_SET) != 0) {
+            fail("Could not truncate checkpoint file: " + m_path);
+        }
+    }
+
+    bool write_pack_record(const pack& p) {
+        const auto& lines = p.get_items();
+        const std::int32_t counts[2] = {p.get_pack_number(), static_cast<std::int32_t>(lines.size())};
+        bool ok = std::fwrite(counts, sizeof(counts), 1, m_file) == 1;
+        for (const auto& i : lines) {
+            const record r{i.get_id(), i.get_length(), i.get_quantity(), i.get_weight(),
+                           static_cast<float>(i.get_volume())};
+            ok = ok && std::fwrite(&r, sizeof(r), 1, m_file) == 1;
+        }
+        return ok;
+    }
+
+    bool write_pack_entry(const pack& p) {
+        if (std::fwrite(&PACK_ENTRY, 1, 1, m_file) != 1 || !write_pack_record(p)) {
+            fail("Could not write checkpoint file: " + m_path);
+            return false;
+        }
+        ++m_closed_packs;
+        return true;
+    }
+
+    void write_state_entry(const pack_cursor& cursor) {
+        const auto s = cursor.get_state();
+        const state_record r{s.index, s.remaining_quantity, s.pack_number, s.safety_counter, m_closed_packs};
+        const bool ok = std::fwrite(&STATE_ENTRY, 1, 1, m_file) == 1 &&
+                        std::fwrite(&r, sizeof(r), 1, m_file) == 1 &&
+                        write_pack_record(cursor.packs().back()) &&
+                        std::fwrite(&END_MARKER, sizeof(END_MARKER), 1, m_file) == 1 && sync();
+        if (!ok) {
+            fail("Could not write checkpoint file: " + m_path);
+            return;
+        }
+        ++m_checkpoints;
+    }
+
+    bool sync() noexcept {
+        return std::fflush(m_file) == 0 && fsync(fileno(m_file)) == 0;
+    }
+
+    // Hand a closed pack to the output, spilling the way blocking_pack_strategy does under a budget
+    void keep(pack&& p) {
+        m_output.push_back(std::move(p));
+        if (m_memory_budget == 0) return;
+        m_held_bytes += pack_spill::memory_footprint(m_output.back());
+        if (m_held_bytes > m_memory_budget && m_spill->is_open()) {
+            for (const auto& held : m_output) {
+                m_spill->write(held);
+            }
+            m_output.clear();
+            m_held_bytes = 0;
+        }
+    }
+
+    std::string m_path;
+    bool m_resume;
+    std::chrono::milliseconds m_interval;
+    std::size_t m_check_steps;
+
+    std::FILE* m_file = nullptr;
+    std::unique_ptr<char[]> m_buffer;
+    std::vector<record> m_records;
+
+    std::vector<pack> m_output;
+    std::size_t m_held_bytes = 0;
+    std::size_t m_memory_budget = 0;
+    pack_spill* m_spill = nullptr;
+
+    std::uint64_t m_closed_packs = 0;
+    std::size_t m_checkpoints = 0;
+    std::size_t m_resumed_from = 0;
+    bool m_resumed = false;
+    bool m_error = false;
+    std::string m_error_message;
+};
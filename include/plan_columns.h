@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "pack.h"
+#include "pack_planner.h"
+#include "simd_kernels.h"
+
+/**
+ * @brief Flat, columnar copy of a planning result
+ *
+ * Non-empty packs are laid out back to back: the items of pack p occupy
+ * [pack_offsets[p], pack_offsets[p + 1]) in the item columns, so
+ * pack_offsets holds pack_count() + 1 entries. Every column is a contiguous
+ * array of plain numbers that can be exposed to other runtimes (JavaScript
+ * typed arrays, C callers) without per-pack or per-item conversion.
+ */
+struct plan_columns {
+    std::vector<std::uint32_t> pack_offsets;
+    std::vector<std::int32_t> pack_numbers;
+    std::vector<std::int32_t> pack_lengths;
+    std::vector<double> pack_weights;
+
+    std::vector<std::int32_t> item_ids;
+    std::vector<std::int32_t> item_lengths;
+    std::vector<std::int32_t> item_quantities;
+    std::vector<double> item_weights;
+    std::vector<float> item_volumes;
+
+    /**
+     * @brief Replace the contents with the packs of a result, spilled packs first
+     * @param result Planning result to flatten
+     */
+    void assign(const pack_planner_result& result) {
+        clear();
+        if (result.spill) {
+            // Spilled packs stream back one at a time: append as they come
+            pack_offsets.push_back(0);
+            result.spill->for_each([this](const pack& p) { append(p); });
+            for (const auto& p : result.packs) {
+                append(p);
+            }
+            return;
+        }
+
+        // In-memory packs: size every column up front from the offsets
+        for (const auto& p : result.packs) {
+            if (p.is_empty()) continue;
+            pack_offsets.push_back(static_cast<std::uint32_t>(p.get_items().size()));
+            pack_numbers.push_back(p.get_pack_number());
+            pack_lengths.push_back(p.get_pack_length());
+            pack_weights.push_back(p.get_total_weight());
+        }
+        pack_offsets.push_back(0);
+        const std::size_t item_total = simd_kernels::exclusive_prefix_sum(pack_offsets.data(),
+                                                                         pack_offsets.size());
+        item_ids.resize(item_total);
+        item_lengths.resize(item_total);
+        item_quantities.resize(item_total);
+        item_weights.resize(item_total);
+        item_volumes.resize(item_total);
+
+        std::size_t at = 0;
+        for (const auto& p : result.packs) {
+            for (const auto& i : p.get_items()) {
+                item_ids[at] = i.get_id();
+                item_lengths[at] = i.get_length();
+                item_quantities[at] = i.get_quantity();
+                item_weights[at] = i.get_weight();
+                item_volumes[at] = static_cast<float>(i.get_volume());
+                ++at;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the combined weight of all packs
+     * @return double Total weight
+     */
+    [[nodiscard]] double total_weight() const noexcept {
+        return simd_kernels::sum(pack_weights.data(), pack_weights.size());
+    }
+
+    /**
+     * @brief Get the combined quantity of all pack lines
+     * @return long long Total quantity
+     */
+    [[nodiscard]] long long total_quantity() const noexcept {
+        return simd_kernels::sum_positive(item_quantities.data(), item_quantities.size());
+    }
+
+    /**
+     * @brief Get the number of (non-empty) packs
+     * @return size_t Number of packs
+     */
+    [[nodiscard]] std::size_t pack_count() const noexcept { return pack_numbers.size(); }
+
+    /**
+     * @brief Get the number of pack lines across all packs
+     * @return size_t Number of item entries
+     */
+    [[nodiscard]] std::size_t item_count() const noexcept { return item_ids.size(); }
+
+    /**
+     * @brief Drop all packs, keeping the allocated capacity for reuse
+     */
+    void clear() noexcept {
+        pack_offsets.clear();
+        pack_numbers.clear();
+        pack_lengths.clear();
+        pack_weights.clear();
+        item_ids.clear();
+        item_lengths.clear();
+        item_quantities.clear();
+        item_weights.clear();
+        item_volumes.clear();
+    }
+
+private:
+    void append(const pack& p) {
+        if (p.is_empty()) return;
+
+        for (const auto& i : p.get_items()) {
+            item_ids.push_back(i.get_id());
+            item_lengths.push_back(i.get_length());
+            item_quantities.push_back(i.get_quantity());
+            item_weights.push_back(i.get_weight());
+            item_volumes.push_back(static_cast<float>(i.get_volume()));
+        }
+        pack_numbers.push_back(p.get_pack_number());
+        pack_lengths.push_back(p.get_pack_length());
+        pack_weights.push_back(p.get_total_weight());
+        pack_offsets.push_back(static_cast<std::uint32_t>(item_ids.size()));
+    }
+};
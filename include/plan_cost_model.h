@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "item.h"
+#include "pack_strategy.h"
+
+/**
+ * @brief Fitted latency of one strategy: fixed_ms + ms_per_item * items
+ */
+struct plan_cost {
+    double fixed_ms = 0.0;
+    double ms_per_item = 0.0;
+    std::size_t samples = 0;
+
+    /**
+     * @brief Predict the planning latency of a request
+     * @param item_count Number of item lines in the request
+     * @return double Predicted latency in milliseconds
+     */
+    [[nodiscard]] double predict_ms(std::size_t item_count) const noexcept {
+        return fixed_ms + ms_per_item * static_cast<double>(item_count);
+    }
+};
+
+/**
+ * @brief Per-device model of planning latency by strategy
+ *
+ * Samples are (item count, measured plan_packs latency) pairs; fit() turns
+ * them into a linear cost per strategy by least squares. calibrate() collects
+ * the samples by planning a small synthetic workload on the current device,
+ * so predictions reflect the actual planner rather than a generic CPU score.
+ */
+class plan_cost_model {
+public:
+    /**
+     * @brief Record one measured plan
+     * @param type Strategy that planned the request
+     * @param item_count Number of item lines in the request
+     * @param ms Measured total planning time in milliseconds
+     */
+    void add_sample(strategy_type type, std::size_t item_count, double ms);
+
+    /**
+     * @brief Fit the cost of every strategy that has samples
+     *
+     * Strategies with samples at a single size only get a per-item rate
+     * through the origin. Negative coefficients from noisy samples are
+     * clamped to zero.
+     */
+    void fit();
+
+    /**
+     * @brief Measure the planner on synthetic requests and fit the model
+     * @param strategies Strategies to calibrate
+     * @param sizes Request sizes (item lines) to plan
+     * @param repetitions Runs per size; the fastest run is kept
+     * @param thread_count Threads for the parallel strategies
+     */
+    void calibrate(const std::vector<strategy_type>& strategies = default_strategies(),
+                   const std::vector<std::size_t>& sizes = {1000, 4000, 16000},
+                   int repetitions = 3, int thread_count = 4);
+
+    /**
+     * @brief Get the fitted cost of a strategy
+     * @param type Strategy to look up
+     * @return const plan_cost* Fitted cost, or nullptr if not calibrated
+     */
+    [[nodiscard]] const plan_cost* cost(strategy_type type) const noexcept;
+
+    /**
+     * @brief Predict the planning latency of a request
+     * @param type Strategy that will plan the request
+     * @param item_count Number of item lines in the request
+     * @return std::optional<double> Latency in milliseconds, empty if not calibrated
+     */
+    [[nodiscard]] std::optional<double> predict_ms(strategy_type type, std::size_t item_count) const noexcept;
+
+    /**
+     * @brief Get the strategy predicted to plan a request fastest
+     * @param item_count Number of item lines in the request
+     * @return std::optional<strategy_type> Fastest calibrated strategy, if any
+     */
+    [[nodiscard]] std::optional<strategy_type> fastest(std::size_t item_count) const noexcept;
+
+    /**
+     * @brief Drop all samples and fitted costs
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Build a deterministic synthetic request for calibration
+     * @param count Number of item lines
+     * @param seed Random seed
+     * @return std::vector<item> Items with realistic length/quantity/weight spread
+     */
+    [[nodiscard]] static std::vector<item> calibration_items(std::size_t count, std::uint32_t seed = 42);
+
+    /**
+     * @brief Get every strategy type
+     * @return std::vector<strategy_type> All strategies
+     */
+    [[nodiscard]] static std::vector<strategy_type> default_strategies();
+
+private:
+    static constexpr std::size_t STRATEGY_COUNT = 4;
+
+    struct sample {
+        double items;
+        double ms;
+    };
+
+    std::array<std::vector<sample>, STRATEGY_COUNT> m_samples;
+    std::array<std::optional<plan_cost>, STRATEGY_COUNT> m_costs;
+};
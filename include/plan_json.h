@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include "pack.h"
+#include "pack_planner.h"
+
+/**
+ * @brief Output formats of a planning result
+ */
+enum class output_format {
+    TEXT,    // "Pack Number:" blocks from pack::to_string
+    JSON,    // one document: {"packs":[...],"metrics":{...}}
+    NDJSON   // one pack object per line, then a {"metrics":{...}} line
+};
+
+/**
+ * @brief Parse an output format name ("text", "json" or "ndjson")
+ * @param name Format name
+ * @return output_format The format (TEXT for unknown names)
+ */
+[[nodiscard]] inline output_format parse_output_format(std::string_view name) noexcept {
+    if (name == "json") return output_format::JSON;
+    if (name == "ndjson") return output_format::NDJSON;
+    return output_format::TEXT;
+}
+
+/**
+ * @brief Streaming JSON writer for planning results
+ *
+ * Writes straight from the packs into a fixed buffer that is flushed to the
+ * stream in large blocks: no document is built and no pack is formatted to a
+ * std::string first. Numbers go through std::to_chars, so doubles are written
+ * in their shortest round-trip form; non-finite values become null.
+ *
+ * Field names match the camelCase models of the C# API (PackResponse,
+ * ItemResponse, PerformanceMetrics); the metrics also carry the input
+ * diagnostics of the screening pass. Volumes are written only when non-zero.
+ *
+ *   plan_json_writer writer(out, output_format::NDJSON);
+ *   for (const auto& p : packs) writer.write_pack(p);
+ *   writer.finish(result);
+ */
+class plan_json_writer {
+public:
+    /**
+     * @brief Construct a writer
+     * @param output Stream to write to
+     * @param format JSON or NDJSON (TEXT is treated as JSON)
+     */
+    plan_json_writer(std::ostream& output, output_format format) noexcept
+        : m_output(output), m_ndjson(format == output_format::NDJSON) {
+        if (!m_ndjson) put("{\"packs\":[");
+    }
+
+    plan_json_writer(const plan_json_writer&) = delete;
+    plan_json_writer& operator=(const plan_json_writer&) = delete;
+
+    ~plan_json_writer() { flush(); }
+
+    /**
+     * @brief Write one pack; empty packs are skipped
+     * @param p Pack to write
+     */
+    void write_pack(const pack& p) {
+        if (p.is_empty()) return;
+        if (!m_ndjson && m_pack_count > 0) put(',');
+        ++m_pack_count;
+
+        put("{\"packNumber\":");
+        put_int(p.get_pack_number());
+        put(",\"packLength\":");
+        put_int(p.get_pack_length());
+        put(",\"totalItems\":");
+        put_int(p.get_total_items());
+        put(",\"totalWeight\":");
+        put_double(p.get_total_weight());
+        if (p.get_total_volume() > 0.0) {
+            put(",\"totalVolume\":");
+            put_double(p.get_total_volume());
+        }
+        put(",\"items\":[");
+        bool first = true;
+        for (const auto& i : p.get_items()) {
+            if (!first) put(',');
+            first = false;
+            put("{\"id\":");
+            put_int(i.get_id());
+            put(",\"length\":");
+            put_int(i.get_length());
+            put(",\"quantity\":");
+            put_int(i.get_quantity());
+            put(",\"weight\":");
+            put_double(i.get_weight());
+            put(",\"totalWeight\":");
+            put_double(i.get_total_weight());
+            if (i.get_volume() > 0.0) {
+                put(",\"volume\":");
+                put_double(i.get_volume());
+            }
+            put('}');
+        }
+        put("]}");
+        if (m_ndjson) put('\n');
+    }
+
+    /**
+     * @brief Write every pack of a result (spilled packs first) and the metrics
+     * @param result Planning result
+     */
+    void write_result(const pack_planner_result& result) {
+        if (result.spill) {
+            result.spill->for_each([this](const pack& p) { write_pack(p); });
+        }
+        for (const auto& p : result.packs) {
+            write_pack(p);
+        }
+        finish(result);
+    }
+
+    /**
+     * @brief Write the metrics of a result and close the document
+     * @param result Planning result whose timings and strategy are reported
+     */
+    void finish(const pack_planner_result& result) {
+        put(m_ndjson ? "{\"metrics\":{" : "],\"metrics\":{");
+        put("\"sortingTimeMs\":");
+        put_double(result.sorting_time);
+        put(",\"packingTimeMs\":");
+        put_double(result.packing_time);
+        put(",\"totalTimeMs\":");
+        put_double(result.total_time);
+        put(",\"totalItems\":");
+        put_int(result.total_items);
+        put(",\"utilizationPercent\":");
+        put_double(result.utilization_percent);
+        put(",\"strategyUsed\":");
+        put_string(result.strategy_name);
+        put(",\"packCount\":");
+        put_int(static_cast<long long>(m_pack_count));
+        put_diagnostics(result.diagnostics);
+        put("}}\n");
+        flush();
+    }
+
+    /**
+     * @brief Hand the buffered bytes to the stream
+     */
+    void flush() {
+        if (m_used > 0) {
+            m_output.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+            m_used = 0;
+        }
+    }
+
+private:
+    // Longest single token written without a capacity check (a number or a key)
+    static constexpr std::size_t MAX_TOKEN = 64;
+
+    void reserve(std::size_t bytes) {
+        if (m_used + bytes > m_buffer.size()) flush();
+    }
+
+    void put(char c) {
+        reserve(1);
+        m_buffer[m_used++] = c;
+    }
+
+    void put(std::string_view text) {
+        if (text.size() > MAX_TOKEN) {
+            flush();
+            m_output.write(text.data(), static_cast<std::streamsize>(text.size()));
+            return;
+        }
+        reserve(text.size());
+        text.copy(m_buffer.data() + m_used, text.size());
+        m_used += text.size();
+    }
+
+    void put_int(long long value) {
+        reserve(MAX_TOKEN);
+        char* begin = m_buffer.data() + m_used;
+        m_used += std::to_chars(begin, begin + MAX_TOKEN, value).ptr - begin;
+    }
+
+    void put_double(double value) {
+        if (!std::isfinite(value)) {
+            put("null");
+            return;
+        }
+        reserve(MAX_TOKEN);
+        char* begin = m_buffer.data() + m_used;
+        m_used += std::to_chars(begin, begin + MAX_TOKEN, value).ptr - begin;
+    }
+
+    // ,"input":{"valid":N,"zeroWeight":{"items":N,"units":N,"exampleIds":[...]},"oversize":{...},"invalid":{...}}
+    void put_diagnostics(const input_diagnostics& diagnostics) {
+        put(",\"input\":{\"valid\":");
+        put_int(static_cast<long long>(diagnostics.count(item_class::VALID)));
+        for (auto c : {item_class::ZERO_WEIGHT, item_class::OVERSIZE, item_class::INVALID}) {
+            put(c == item_class::ZERO_WEIGHT ? ",\"zeroWeight\":{\"items\":"
+                : c == item_class::OVERSIZE ? ",\"oversize\":{\"items\":" : ",\"invalid\":{\"items\":");
+            put_int(static_cast<long long>(diagnostics.count(c)));
+            put(",\"units\":");
+            put_int(diagnostics.unit_count(c));
+            put(",\"exampleIds\":[");
+            bool first = true;
+            for (int id : diagnostics.examples[static_cast<std::size_t>(c)]) {
+                if (!first) put(',');
+                first = false;
+                put_int(id);
+            }
+            put("]}");
+        }
+        put('}');
+    }
+
+    void put_string(std::string_view text) {
+        put('"');
+        for (const char c : text) {
+            const auto u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                put('\\');
+                put(c);
+            } else if (u < 0x20) {
+                constexpr char HEX[] = "0123456789abcdef";
+                const char escaped[] = {'\\', 'u', '0', '0', HEX[u >> 4], HEX[u & 0xF]};
+                put(std::string_view(escaped, sizeof(escaped)));
+            } else {
+                put(c);
+            }
+        }
+        put('"');
+    }
+
+    std::ostream& m_output;
+    bool m_ndjson;
+    std::size_t m_pack_count = 0;
+    std::array<char, 64 * 1024> m_buffer;
+    std::size_t m_used = 0;
+};
+
+/**
+ * @brief Write a planning result in a JSON format
+ * @param result Planning result
+ * @param output Stream to write to
+ * @param format JSON or NDJSON
+ */
+inline void write_plan_json(const pack_planner_result& result, std::ostream& output, output_format format) {
+    plan_json_writer writer(output, format);
+    writer.write_result(result);
+}
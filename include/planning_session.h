@@ -0,0 +1,129 @@
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <vector>
+#include "pack_cursor.h"
+#include "pack_planner.h"
+
+/**
+ * @brief Time-sliced planning of one request
+ *
+ * Lets a single-threaded caller (e.g. a browser main thread) interleave a
+ * large plan with other work: each step() packs for roughly the given time
+ * budget and returns. Sorting happens in the first step and is not sliced.
+ * Packing always uses the next-fit (blocking) algorithm, so the final
+ * result matches pack_planner::plan_packs with BLOCKING_FIRST_FIT.
+ */
+class planning_session {
+public:
+    /**
+     * @brief Prepare a session; no work is done until the first step
+     * @param config Configuration for planning
+     * @param items Items to pack
+     */
+    planning_session(const pack_planner_config& config, std::vector<item> items)
+        : m_config(config), m_items(std::move(items)) {
+        m_config.max_items_per_pack = std::max(1, config.max_items_per_pack);
+        m_config.max_weight_per_pack = std::max(0.1, config.max_weight_per_pack);
+    }
+
+    /**
+     * @brief Advance the plan for about the given amount of time
+     * @param budget_ms Time budget in milliseconds (<= 0 runs to completion)
+     * @return bool True once planning is complete
+     */
+    bool step(double budget_ms) {
+        if (done()) return true;
+
+        timer step_timer;
+        step_timer.start();
+
+        if (!m_cursor) {
+            // Same screening as pack_planner::plan_packs, so both produce the same plan
+            pack_limits limits = m_config.limits();
+            m_diagnostics = screen_items(m_items, limits);
+            limits.input_lines = m_diagnostics.lines();
+            pack_planner::sort_items(m_items, m_config.order);
+            m_sorting_time = step_timer.elapsed();
+            m_cursor.emplace(std::move(m_items), limits);
+        }
+
+        if (budget_ms <= 0.0) {
+            m_cursor->run();
+        } else {
+            const auto deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration<double, std::milli>(budget_ms - step_timer.elapsed());
+            // Check the clock every STEP_BATCH placements to keep its cost negligible
+            while (!m_cursor->done() && std::chrono::steady_clock::now() < deadline) {
+                m_cursor->advance(STEP_BATCH);
+            }
+        }
+
+        m_elapsed_time += step_timer.stop();
+        ++m_steps;
+        return done();
+    }
+
+    /**
+     * @brief Check whether planning is complete
+     * @return bool True if every item has been packed
+     */
+    [[nodiscard]] bool done() const noexcept { return m_cursor && m_cursor->done(); }
+
+    /**
+     * @brief Get the fraction of items packed so far
+     * @return double Progress in [0, 1]
+     */
+    [[nodiscard]] double progress() const noexcept { return m_cursor ? m_cursor->progress() : 0.0; }
+
+    /**
+     * @brief Get the number of packs opened so far
+     * @return size_t Number of packs
+     */
+    [[nodiscard]] size_t pack_count() const noexcept { return m_cursor ? m_cursor->packs().size() : 0; }
+
+    /**
+     * @brief Get the number of step() calls made
+     * @return size_t Number of steps
+     */
+    [[nodiscard]] size_t steps() const noexcept { return m_steps; }
+
+    /**
+     * @brief Finish any remaining work and collect the result
+     *
+     * Times are the sums over all steps, so they exclude the gaps between them.
+     * The packs are moved out; call once.
+     *
+     * @return pack_planner_result Results of the planning process
+     */
+    [[nodiscard]] pack_planner_result result() {
+        if (!done()) step(0.0);
+
+        pack_planner_result result;
+        result.sorting_time = m_sorting_time;
+        result.total_time = m_elapsed_time;
+        result.packing_time = m_elapsed_time - m_sorting_time;
+        result.strategy_name = "Blocking";
+
+        result.total_items = m_diagnostics.requested_units();
+        result.diagnostics = m_diagnostics;
+
+        result.packs = m_cursor->take_packs();
+        result.utilization_percent = pack_planner::calculate_utilization(
+            result.packs, m_config.max_weight_per_pack);
+        return result;
+    }
+
+private:
+    static constexpr size_t STEP_BATCH = 4096;
+
+    pack_planner_config m_config;
+    std::vector<item> m_items;
+    std::optional<pack_cursor> m_cursor;
+    input_diagnostics m_diagnostics;
+    double m_sorting_time = 0.0;
+    double m_elapsed_time = 0.0;
+    size_t m_steps = 0;
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "item.h"
+#include "sort_order.h"
+#include "pack_strategy.h"
+
+struct pack_planner_config;
+struct pack_planner_result;
+
+/**
+ * @brief One captured planning request
+ */
+struct trace_record {
+    std::uint64_t timestamp_us = 0;  // wall-clock capture time (µs since the Unix epoch)
+    sort_order order = sort_order::NATURAL;
+    strategy_type type = strategy_type::BLOCKING_FIRST_FIT;
+    int thread_count = 4;
+    int max_items_per_pack = 100;
+    double max_weight_per_pack = 200.0;
+    int max_length_per_pack = 0;     // 0 = unlimited (and in version 1 traces)
+    double max_volume_per_pack = 0.0;
+    std::uint64_t memory_budget_bytes = 0;
+    double sorting_time = 0.0;       // as measured in production (ms)
+    double packing_time = 0.0;
+    double total_time = 0.0;
+    std::vector<item> items;         // input before sorting
+};
+
+/**
+ * @brief Opt-in recorder of sampled planning requests into a binary trace
+ *
+ * File layout (native byte order): the 8-byte magic "PPTRACE2", then one
+ * record per request:
+ *   u64 timestamp_us, u8 order, u8 type, u16 reserved, i32 thread_count,
+ *   i32 max_items, f64 max_weight, u64 memory_budget,
+ *   f64 sorting_ms, f64 packing_ms, f64 total_ms,
+ *   i32 max_length, f64 max_volume, u32 item_count,
+ *   item_count x { i32 id, i32 length, i32 quantity, f64 weight, f32 volume }
+ *
+ * Version 1 traces ("PPTRACE1") have neither max_length and max_volume nor
+ * the item volume; trace_reader still reads them, with those limits off.
+ *
+ * Traces are opened for append, so successive CLI runs accumulate into one
+ * file; appending to a version 1 trace is refused (is_open() is false).
+ * Safe to share between planners on different threads.
+ *
+ * Recording stays off the request path: record() only queues the request,
+ * and a background writer encodes, writes and flushes it. The queue is
+ * bounded; when it is full, records are dropped rather than making the
+ * request wait. Queued records are written before the destructor returns.
+ */
+class request_capture {
+public:
+    /**
+     * @brief Open (or create) a trace file for appending
+     * @param path Trace file path
+     * @param sample_rate Fraction of requests to record, in [0, 1]
+     * @param seed Seed for the sampling decision (0 = random)
+     * @param max_queue Maximum records waiting for the writer
+     */
+    explicit request_capture(const std::string& path, double sample_rate = 1.0,
+                             std::uint32_t seed = 0, std::size_t max_queue = 64);
+
+    /**
+     * @brief Write the queued records and stop the writer
+     */
+    ~request_capture();
+
+    request_capture(const request_capture&) = delete;
+    request_capture& operator=(const request_capture&) = delete;
+
+    /**
+     * @brief Check whether the trace file is usable
+     * @return bool True if requests can be recorded
+     */
+    [[nodiscard]] bool is_open() const noexcept { return m_file != nullptr && !m_error; }
+
+    /**
+     * @brief Decide whether the next request should be recorded
+     * @return bool True if the request is sampled
+     */
+    [[nodiscard]] bool should_sample();
+
+    /**
+     * @brief Queue a request and its measured timings for the trace
+     * @param config Configuration the request was planned with
+     * @param items Input items before sorting
+     * @param result Result of planning the request
+     * @return bool True if queued, false if dropped (queue full, trace unusable, or
+     *         more items than a trace record can hold)
+     */
+    bool record(const pack_planner_config& config, std::vector<item> items,
+                const pack_planner_result& result);
+
+    /**
+     * @brief Block until every queued record has been written and flushed
+     */
+    void wait_idle();
+
+    /**
+     * @brief Get the number of requests written by this instance
+     * @return size_t Number of records written
+     */
+    [[nodiscard]] std::size_t captured() const;
+
+    /**
+     * @brief Get the number of requests dropped: queue full or too large to record
+     * @return size_t Number of records dropped
+     */
+    [[nodiscard]] std::size_t dropped() const;
+
+private:
+    void run();
+
+    std::FILE* m_file = nullptr;
+    double m_sample_rate;
+    std::size_t m_max_queue;
+    std::mt19937 m_rng;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_idle;
+    std::deque<trace_record> m_queue;
+    bool m_busy = false;
+    bool m_stop = false;
+    std::size_t m_captured = 0;
+    std::size_t m_dropped = 0;
+    std::atomic<bool> m_error{false};
+
+    std::thread m_writer;
+};
+
+/**
+ * @brief Sequential reader for traces written by request_capture (versions 1 and 2)
+ */
+class trace_reader {
+public:
+    /**
+     * @brief Open a trace file
+     * @param path Trace file path
+     */
+    explicit trace_reader(const std::string& path);
+    ~trace_reader();
+
+    trace_reader(const trace_reader&) = delete;
+    trace_reader& operator=(const trace_reader&) = delete;
+
+    /**
+     * @brief Check whether the file is a readable trace
+     * @return bool True if the header was valid
+     */
+    [[nodiscard]] bool is_open() const noexcept { return m_file != nullptr && !m_error; }
+
+    /**
+     * @brief Check whether a malformed or truncated record was found
+     * @return bool True if reading stopped on an error
+     */
+    [[nodiscard]] bool has_error() const noexcept { return m_error; }
+
+    /**
+     * @brief Read the next record
+     * @param record Receives the record
+     * @return bool True if a record was read, false at end of trace or on error
+     */
+    [[nodiscard]] bool next(trace_record& record);
+
+private:
+    std::FILE* m_file = nullptr;
+    int m_version = 2;
+    std::uint64_t m_size = 0;   // file size, bounds every record's item count
+    bool m_error = false;
+};
+
+/**
+ * @brief Options for replaying a trace
+ */
+struct replay_options {
+    // Pacing: 0 = back to back, 1 = original arrival rate, N = N times faster
+    double speed = 0.0;
+    // Override the recorded strategy (and its thread count, if > 0)
+    std::optional<strategy_type> strategy;
+    int thread_count = 0;
+};
+
+/**
+ * @brief Latency distribution summary in milliseconds
+ */
+struct latency_summary {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @brief Results of replaying a trace
+ */
+struct replay_report {
+    std::size_t requests = 0;
+    long long total_items = 0;
+    double wall_time = 0.0;          // ms for the whole replay
+    latency_summary replayed;        // replay latencies; paced, from the scheduled arrival
+    latency_summary original;        // latencies recorded at capture time
+    bool trace_error = false;
+};
+
+/**
+ * @brief Summarise a set of latencies
+ * @param latencies Latencies in milliseconds (reordered in place)
+ * @return latency_summary Mean and percentiles
+ */
+[[nodiscard]] latency_summary summarize_latencies(std::vector<double>& latencies);
+
+/**
+ * @brief Re-run every request of a trace through the planner
+ * @param path Trace file path
+ * @param options Pacing and strategy overrides
+ * @return std::optional<replay_report> The report, or nullopt if the trace cannot be opened
+ */
+[[nodiscard]] std::optional<replay_report> replay_trace(const std::string& path,
+                                                        const replay_options& options);
+
+/**
+ * @brief Print a replay report
+ * @param report Report to print
+ * @param output Output stream
+ */
+void output_replay_report(const replay_report& report, std::ostream& output);
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "item.h"
+#include "pack_constraints.h"
+#include "pack_strategy.h"
+
+struct pack_planner_config;
+struct pack_planner_result;
+
+/**
+ * @brief Aggregated comparison of a shadow strategy against the primary one
+ *
+ * Deltas are candidate minus primary, so a negative latency delta means the
+ * candidate packed faster and a negative pack delta means it used fewer packs.
+ */
+struct shadow_metrics {
+    std::string candidate_name;
+    std::size_t submitted = 0;          // requests handed to the shadow
+    std::size_t completed = 0;          // requests the candidate finished
+    std::size_t dropped = 0;            // requests skipped because the queue was full
+    double primary_packing_ms = 0.0;    // summed over completed requests
+    double candidate_packing_ms = 0.0;
+    double max_latency_delta_ms = 0.0;
+    long long pack_count_delta = 0;     // summed over completed requests
+    double utilization_delta = 0.0;     // summed percentage points
+    std::size_t candidate_faster = 0;
+    std::size_t candidate_fewer_packs = 0;
+
+    [[nodiscard]] double mean_latency_delta_ms() const noexcept {
+        return completed ? (candidate_packing_ms - primary_packing_ms) / completed : 0.0;
+    }
+
+    [[nodiscard]] double mean_pack_count_delta() const noexcept {
+        return completed ? static_cast<double>(pack_count_delta) / completed : 0.0;
+    }
+
+    [[nodiscard]] double mean_utilization_delta() const noexcept {
+        return completed ? utilization_delta / completed : 0.0;
+    }
+};
+
+/**
+ * @brief Runs a candidate strategy on sampled requests off the critical path
+ *
+ * The primary planner hands over its already sorted items once its own
+ * result is complete; a single background worker re-packs them with the
+ * candidate strategy and folds the comparison into shadow_metrics. The queue
+ * is bounded and submissions are dropped rather than blocking when it is full,
+ * so the shadow can never slow the primary response down. A parallel
+ * candidate runs its chunks on the runner's own worker pool, never on
+ * thread_pool::shared(), so primary plans do not queue behind them.
+ */
+class shadow_runner {
+public:
+    /**
+     * @brief Start the shadow worker
+     * @param candidate Strategy to evaluate
+     * @param sample_rate Fraction of requests to shadow, in [0, 1]
+     * @param thread_count Threads for a parallel candidate
+     * @param max_queue Maximum requests waiting for the worker
+     * @param seed Seed for the sampling decision (0 = random)
+     */
+    explicit shadow_runner(strategy_type candidate, double sample_rate = 1.0,
+                           int thread_count = 4, std::size_t max_queue = 16,
+                           std::uint32_t seed = 0);
+
+    /**
+     * @brief Finish the queued requests and stop the worker
+     */
+    ~shadow_runner();
+
+    shadow_runner(const shadow_runner&) = delete;
+    shadow_runner& operator=(const shadow_runner&) = delete;
+
+    /**
+     * @brief Decide whether the next request should be shadowed
+     * @return bool True if the request is sampled
+     */
+    [[nodiscard]] bool should_sample();
+
+    /**
+     * @brief Queue a request for the candidate strategy
+     * @param limits Limits the primary planned with, including its pre-screening line count
+     * @param sorted_items Items in the order the primary packed them
+     * @param primary Result of the primary strategy
+     * @return bool True if queued, false if dropped
+     */
+    bool submit(const pack_limits& limits, std::vector<item>&& sorted_items,
+                const pack_planner_result& primary);
+
+    /**
+     * @brief Block until every queued request has been evaluated
+     */
+    void wait_idle();
+
+    /**
+     * @brief Get a consistent copy of the metrics gathered so far
+     * @return shadow_metrics Metrics snapshot
+     */
+    [[nodiscard]] shadow_metrics snapshot() const;
+
+private:
+    struct job {
+        std::vector<item> items;
+        pack_limits limits;   // every limit the primary planned with, input_lines included
+        double primary_packing_ms;
+        std::size_t primary_packs;
+        double primary_utilization;
+    };
+
+    void run();
+
+    strategy_type m_candidate;
+    double m_sample_rate;
+    int m_thread_count;
+    std::size_t m_max_queue;
+    std::mt19937 m_rng;
+
+    std::shared_ptr<thread_pool> m_pool;   // parallel candidates only
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work_ready;
+    std::condition_variable m_idle;
+    std::deque<job> m_queue;
+    bool m_busy = false;
+    bool m_stop = false;
+    shadow_metrics m_metrics;
+
+    std::thread m_worker;
+};
+
+/**
+ * @brief Print a shadow comparison summary
+ * @param metrics Metrics to print
+ * @param output Output stream
+ */
+void output_shadow_metrics(const shadow_metrics& metrics, std::ostream& output);
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define PACK_PLANNER_SIMD128 1
+#endif
+
+/**
+ * @brief Column kernels with a 128-bit WebAssembly SIMD path
+ *
+ * Each kernel has a scalar implementation, which native -O3 builds
+ * auto-vectorize, and an explicit wasm_simd128 implementation that is
+ * compiled in when building with -msimd128 (the pack_planner_wasm_simd
+ * variant). Both paths produce identical results.
+ */
+namespace simd_kernels {
+
+/**
+ * @brief Check whether the SIMD128 paths were compiled in
+ * @return bool True for -msimd128 builds
+ */
+[[nodiscard]] constexpr bool enabled() noexcept {
+#ifdef PACK_PLANNER_SIMD128
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Sum the positive values of an int32 column
+ * @param values Column to sum
+ * @param count Number of values
+ * @return long long Sum of the values greater than zero
+ */
+[[nodiscard]] inline long long sum_positive(const std::int32_t* values, std::size_t count) noexcept {
+    long long total = 0;
+    std::size_t i = 0;
+#ifdef PACK_PLANNER_SIMD128
+    v128_t acc_lo = wasm_i64x2_splat(0);
+    v128_t acc_hi = wasm_i64x2_splat(0);
+    const v128_t zero = wasm_i32x4_splat(0);
+    for (; i + 4 <= count; i += 4) {
+        v128_t v = wasm_v128_load(values + i);
+        v = wasm_i32x4_max(v, zero);
+        acc_lo = wasm_i64x2_add(acc_lo, wasm_i64x2_extend_low_i32x4(v));
+        acc_hi = wasm_i64x2_add(acc_hi, wasm_i64x2_extend_high_i32x4(v));
+    }
+    const v128_t acc = wasm_i64x2_add(acc_lo, acc_hi);
+    total = wasm_i64x2_extract_lane(acc, 0) + wasm_i64x2_extract_lane(acc, 1);
+#endif
+    for (; i < count; ++i) {
+        total += values[i] > 0 ? values[i] : 0;
+    }
+    return total;
+}
+
+/**
+ * @brief Sum a float64 column
+ *
+ * Accumulates in two interleaved lanes in both paths, so the SIMD and scalar
+ * builds round identically.
+ *
+ * @param values Column to sum
+ * @param count Number of values
+ * @return double Sum of the values
+ */
+[[nodiscard]] inline double sum(const double* values, std::size_t count) noexcept {
+    std::size_t i = 0;
+#ifdef PACK_PLANNER_SIMD128
+    v128_t acc = wasm_f64x2_splat(0.0);
+    for (; i + 2 <= count; i += 2) {
+        acc = wasm_f64x2_add(acc, wasm_v128_load(values + i));
+    }
+    double lane0 = wasm_f64x2_extract_lane(acc, 0);
+    double lane1 = wasm_f64x2_extract_lane(acc, 1);
+#else
+    double lane0 = 0.0;
+    double lane1 = 0.0;
+    for (; i + 2 <= count; i += 2) {
+        lane0 += values[i];
+        lane1 += values[i + 1];
+    }
+#endif
+    if (i < count) {
+        lane0 += values[i];
+    }
+    return lane0 + lane1;
+}
+
+/**
+ * @brief Replace a column of counts with its exclusive prefix sum
+ * @param values Counts in, start offsets out
+ * @param count Number of values
+ * @return uint32_t Sum of all counts (the end offset)
+ */
+inline std::uint32_t exclusive_prefix_sum(std::uint32_t* values, std::size_t count) noexcept {
+    std::uint32_t running = 0;
+    std::size_t i = 0;
+#ifdef PACK_PLANNER_SIMD128
+    for (; i + 4 <= count; i += 4) {
+        // In-register inclusive scan of 4 lanes (two shift-and-add steps)
+        v128_t v = wasm_v128_load(values + i);
+        v = wasm_i32x4_add(v, wasm_i32x4_shuffle(wasm_i32x4_splat(0), v, 3, 4, 5, 6));
+        v = wasm_i32x4_add(v, wasm_i32x4_shuffle(wasm_i32x4_splat(0), v, 2, 3, 4, 5));
+        // Shift to exclusive and add the carry from earlier blocks
+        const v128_t exclusive = wasm_i32x4_shuffle(wasm_i32x4_splat(0), v, 3, 4, 5, 6);
+        wasm_v128_store(values + i, wasm_i32x4_add(exclusive, wasm_i32x4_splat(running)));
+        running += wasm_u32x4_extract_lane(v, 3);
+    }
+#endif
+    for (; i < count; ++i) {
+        const std::uint32_t value = values[i];
+        values[i] = running;
+        running += value;
+    }
+    return running;
+}
+
+/**
+ * @brief Build 64-bit sort keys from an int32 key column
+ *
+ * Each key holds the order-preserving (biased, optionally inverted) value in
+ * its upper 32 bits and the row index in its lower 32 bits, so sorting the
+ * keys as unsigned integers yields a stable order of the rows.
+ *
+ * @param values Key column (e.g. item lengths)
+ * @param count Number of rows (at most 2^32)
+ * @param descending True to order larger values first
+ * @param keys Output, count entries
+ */
+inline void build_sort_keys(const std::int32_t* values, std::size_t count, bool descending,
+                            std::uint64_t* keys) noexcept {
+    // Flipping the sign bit maps int32 order onto uint32 order; inverting all bits reverses it
+    const std::uint32_t flip = descending ? 0x7FFFFFFFu : 0x80000000u;
+    std::size_t i = 0;
+#ifdef PACK_PLANNER_SIMD128
+    const v128_t flip_v = wasm_i32x4_splat(static_cast<std::int32_t>(flip));
+    v128_t index_lo = wasm_i64x2_make(0, 1);
+    v128_t index_hi = wasm_i64x2_make(2, 3);
+    const v128_t step = wasm_i64x2_splat(4);
+    for (; i + 4 <= count; i += 4) {
+        const v128_t v = wasm_v128_xor(wasm_v128_load(values + i), flip_v);
+        const v128_t lo = wasm_i64x2_shl(wasm_u64x2_extend_low_u32x4(v), 32);
+        const v128_t hi = wasm_i64x2_shl(wasm_u64x2_extend_high_u32x4(v), 32);
+        wasm_v128_store(keys + i, wasm_v128_or(lo, index_lo));
+        wasm_v128_store(keys + i + 2, wasm_v128_or(hi, index_hi));
+        index_lo = wasm_i64x2_add(index_lo, step);
+        index_hi = wasm_i64x2_add(index_hi, step);
+    }
+#endif
+    for (; i < count; ++i) {
+        const std::uint32_t biased = static_cast<std::uint32_t>(values[i]) ^ flip;
+        keys[i] = (static_cast<std::uint64_t>(biased) << 32) | static_cast<std::uint32_t>(i);
+    }
+}
+
+} // namespace simd_kernels
@@ -8,9 +8,15 @@
 enum class sort_order {
     NATURAL,
     SHORT_TO_LONG,
-    LONG_TO_SHORT
+    LONG_TO_SHORT,
+    HEAVY_TO_LIGHT,              // piece weight descending (first-fit decreasing)
+    SHORT_TO_LONG_HEAVY_FIRST,   // length ascending, then piece weight descending
+    LONG_TO_SHORT_HEAVY_FIRST    // length descending, then piece weight descending
 };
 
+// Highest sort_order value, for range checks on integer input
+inline constexpr sort_order LAST_SORT_ORDER = sort_order::LONG_TO_SHORT_HEAVY_FIRST;
+
 /**
  * @brief Parse a string to get the corresponding sort_order
  * @param str The string to parse
@@ -20,6 +26,9 @@ enum class sort_order {
     if (str == "NATURAL") return sort_order::NATURAL;
     if (str == "SHORT_TO_LONG") return sort_order::SHORT_TO_LONG;
     if (str == "LONG_TO_SHORT") return sort_order::LONG_TO_SHORT;
+    if (str == "HEAVY_TO_LIGHT") return sort_order::HEAVY_TO_LIGHT;
+    if (str == "SHORT_TO_LONG_HEAVY_FIRST") return sort_order::SHORT_TO_LONG_HEAVY_FIRST;
+    if (str == "LONG_TO_SHORT_HEAVY_FIRST") return sort_order::LONG_TO_SHORT_HEAVY_FIRST;
     return sort_order::NATURAL; // default
 }
 
@@ -33,6 +42,9 @@ enum class sort_order {
         case sort_order::NATURAL: return "NAT";
         case sort_order::SHORT_TO_LONG: return "STL";
         case sort_order::LONG_TO_SHORT: return "LTS";
+        case sort_order::HEAVY_TO_LIGHT: return "HTL";
+        case sort_order::SHORT_TO_LONG_HEAVY_FIRST: return "STLH";
+        case sort_order::LONG_TO_SHORT_HEAVY_FIRST: return "LTSH";
         default: return "NAT";
     }
 }
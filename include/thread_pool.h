@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef PACK_PLANNER_POOL_SIZE
+// Upper bound on pooled worker threads (0 = hardware concurrency).
+// WASM builds set this to the planner's PTHREAD_POOL_SIZE so every worker is
+// pre-spawned; the profiler module spawns the same number on demand.
+#define PACK_PLANNER_POOL_SIZE 0
+#endif
+
+/**
+ * @brief Persistent worker pool shared by the parallel strategies
+ *
+ * Workers are started once and reused across planning calls, so a parallel
+ * plan costs a queue hand-off per chunk rather than a thread spawn and join.
+ * This matters most under Emscripten, where every new std::thread is a Web
+ * Worker hand-off. The thread calling run_batch() executes its own batch's
+ * queued tasks while it waits, so batches may be nested or exceed the worker
+ * count without deadlocking, and a caller never runs another request's work.
+ */
+class thread_pool {
+public:
+    /**
+     * @brief Start a pool
+     * @param worker_count Number of worker threads (0 = hardware concurrency)
+     */
+    explicit thread_pool(unsigned int worker_count = 0) {
+        if (worker_count == 0) {
+            worker_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (PACK_PLANNER_POOL_SIZE > 0) {
+            worker_count = std::min<unsigned int>(worker_count, PACK_PLANNER_POOL_SIZE);
+        }
+
+        m_workers.reserve(worker_count);
+        for (unsigned int i = 0; i < worker_count; ++i) {
+            m_workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_task_ready.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /**
+     * @brief Get the process-wide pool, starting it on first use
+     * @return thread_pool& Shared pool
+     */
+    static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Get the number of worker threads
+     * @return size_t Worker count
+     */
+    [[nodiscard]] size_t size() const noexcept { return m_workers.size(); }
+
+    /**
+     * @brief Queue a task without waiting for it
+     * @param task Task to run on a worker; it must not throw
+     */
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(queued_task{std::move(task), nullptr});
+        }
+        m_task_ready.notify_one();
+    }
+
+    /**
+     * @brief Run fn(0) .. fn(count - 1) on the pool and wait for all of them
+     *
+     * An exception thrown by fn is caught where the task runs, so it never
+     * reaches a worker thread. The first one is rethrown here once every task
+     * of the batch has finished and nothing still refers to fn.
+     *
+     * @param count Number of tasks
+     * @param fn Callable taking the task index
+     */
+    template <typename Fn>
+    void run_batch(size_t count, Fn&& fn) {
+        if (count == 0) return;
+
+        struct batch_state {
+            std::mutex mutex;
+            std::condition_variable finished;
+            size_t remaining;
+            std::exception_ptr error;   // first exception thrown by fn
+        };
+        auto state = std::make_shared<batch_state>();
+        state->remaining = count;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i = 0; i < count; ++i) {
+                m_tasks.push_back(queued_task{[&fn, i, state] {
+                    std::exception_ptr error;
+                    try {
+                        fn(i);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    std::lock_guard<std::mutex> batch_lock(state->mutex);
+                    if (error && !state->error) {
+                        state->error = std::move(error);
+                    }
+                    if (--state->remaining == 0) {
+                        state->finished.notify_all();
+                    }
+                }, state.get()});
+            }
+        }
+        m_task_ready.notify_all();
+
+        // Help with this batch's tasks instead of idling; tasks of other batches or
+        // submit() are left to the workers, so this caller never waits behind them
+        while (run_one(state.get())) {
+            std::lock_guard<std::mutex> batch_lock(state->mutex);
+            if (state->remaining == 0) break;
+        }
+
+        std::unique_lock<std::mutex> batch_lock(state->mutex);
+        state->finished.wait(batch_lock, [&] { return state->remaining == 0; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+private:
+    struct queued_task {
+        std::function<void()> run;
+        const void* batch;   // batch state of a run_batch() task, null for submit()
+    };
+
+    /**
+     * @brief Run one queued task of a batch on the calling thread
+     * @param batch Batch whose tasks may be taken
+     * @return bool False if no task of the batch is queued
+     */
+    bool run_one(const void* batch) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = std::find_if(m_tasks.begin(), m_tasks.end(),
+                                   [batch](const queued_task& t) { return t.batch == batch; });
+            if (it == m_tasks.end()) return false;
+            task = std::move(it->run);
+            m_tasks.erase(it);
+        }
+        task();
+        return true;
+    }
+
+    void worker_loop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_task_ready.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                if (m_tasks.empty()) return;  // stopping and drained
+                task = std::move(m_tasks.front().run);
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::deque<queued_task> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_task_ready;
+    bool m_stop = false;
+};
@@ -6,190 +6,262 @@
 #include "item.h"
 #include "pack.h"
 #include "pack_planner.h"
-#include "benchmark.h"
+#include "plan_columns.h"
+#include "plan_json.h"
+#include "planning_session.h"
+#include "thread_pool.h"
+#include "simd_kernels.h"
 #include <vector>
 #include <string>
-#include <chrono>
-#include <cmath>
-#include <random>
 #include <algorithm>
+#include <optional>
+#include <atomic>
+#include <memory>
+#include <sstream>
+
+// Typed-array view over a column in WASM memory (no copy)
+template <typename T>
+emscripten::val typedView(const std::vector<T>& column) {
+    return emscripten::val(emscripten::typed_memory_view(column.size(), column.data()));
+}
 
-// Profiler results structure
-struct ProfilerResults {
-    double cpu_score;
-    double memory_bandwidth_mbps;
-    double network_latency_ms;
-    double network_bandwidth_mbps;
-    double battery_level;
-    bool is_charging;
-    std::string recommendation;
-    double confidence_score;
-};
-
-class SystemProfiler {
-private:
-    std::mt19937 rng;
-
-    // CPU benchmarking using mathematical operations
-    double benchmarkCPU() {
-        auto start = std::chrono::high_resolution_clock::now();
+// JS passes enums as plain numbers; one out of range throws a RangeError instead of
+// becoming an invalid enum value
+inline sort_order sortOrderArg(int value) {
+    if (value < 0 || value > static_cast<int>(LAST_SORT_ORDER)) {
+        emscripten::val::global("RangeError").new_(emscripten::val(
+            "sortOrder must be 0-" + std::to_string(static_cast<int>(LAST_SORT_ORDER)) +
+            ", got " + std::to_string(value))).throw_();
+    }
+    return static_cast<sort_order>(value);
+}
 
-        // Mathematical operations benchmark
-        double result = 0.0;
-        const int iterations = 1000000;
+inline strategy_type strategyTypeArg(int value) {
+    if (value < 0 || value > static_cast<int>(strategy_type::PARALLEL_BEST_FIT)) {
+        emscripten::val::global("RangeError").new_(emscripten::val(
+            "strategyType must be 0-" + std::to_string(static_cast<int>(strategy_type::PARALLEL_BEST_FIT)) +
+            ", got " + std::to_string(value))).throw_();
+    }
+    return static_cast<strategy_type>(value);
+}
 
-        for (int i = 0; i < iterations; ++i) {
-            double x = static_cast<double>(i) / 1000.0;
-            result += std::sin(x) * std::cos(x) + std::sqrt(x + 1.0) + std::log(x + 1.0);
-        }
+inline emscripten::val statsObject(const pack_planner_result& result) {
+    emscripten::val stats = emscripten::val::object();
+    stats.set("sortingTime", result.sorting_time);
+    stats.set("packingTime", result.packing_time);
+    stats.set("totalTime", result.total_time);
+    stats.set("totalItems", result.total_items);
+    stats.set("utilizationPercent", result.utilization_percent);
+    stats.set("strategyName", result.strategy_name);
+    stats.set("packCount", result.packs.size());
+    // Lines the screening pass left out (oversize or non-positive quantity)
+    stats.set("droppedItems", result.diagnostics.dropped());
+    return stats;
+}
 
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+// Stats plus typed-array views over the result columns (see PackPlanner::plan)
+inline emscripten::val planObject(const pack_planner_result& result, const plan_columns& columns) {
+    emscripten::val planned = statsObject(result);
+    planned.set("packCount", columns.pack_count());
+    planned.set("totalWeight", columns.total_weight());
+    planned.set("packOffsets", typedView(columns.pack_offsets));
+    planned.set("packNumbers", typedView(columns.pack_numbers));
+    planned.set("packLengths", typedView(columns.pack_lengths));
+    planned.set("packWeights", typedView(columns.pack_weights));
+    planned.set("itemIds", typedView(columns.item_ids));
+    planned.set("itemLengths", typedView(columns.item_lengths));
+    planned.set("itemQuantities", typedView(columns.item_quantities));
+    planned.set("itemWeights", typedView(columns.item_weights));
+    return planned;
+}
 
-        // Calculate operations per second and normalize to a score (higher is better)
-        double ops_per_second = (iterations * 4.0) / (duration.count() / 1000000.0); // 4 ops per iteration
-        return ops_per_second / 1000000.0; // Normalize to millions of ops per second
+/**
+ * Columnar item storage that lives inside the WASM heap.
+ *
+ * JavaScript either fills the typed-array views returned by ids()/lengths()/
+ * quantities()/weights() in place, or hands over whole Int32Array/Float64Array
+ * columns through assign(), which copies each column with a single bulk set().
+ * Either way no per-item value is marshalled through emscripten::val.
+ *
+ * The views alias WASM memory: fetch them again after resize() or after any
+ * call that may grow the heap, since growth detaches previously returned views.
+ */
+class ItemBuffer {
+public:
+    ItemBuffer() = default;
+    explicit ItemBuffer(unsigned count) { resize(count); }
+
+    void resize(unsigned count) {
+        m_ids.resize(count);
+        m_lengths.resize(count);
+        m_quantities.resize(count);
+        m_weights.resize(count);
     }
 
-    // Memory bandwidth testing
-    double benchmarkMemoryBandwidth() {
-        const size_t buffer_size = 64 * 1024 * 1024; // 64MB
-        const int iterations = 10;
-
-        std::vector<uint8_t> src(buffer_size);
-        std::vector<uint8_t> dst(buffer_size);
-
-        // Fill source buffer with random data
-        std::uniform_int_distribution<uint8_t> dist(0, 255);
-        for (size_t i = 0; i < buffer_size; ++i) {
-            src[i] = dist(rng);
+    unsigned size() const { return static_cast<unsigned>(m_ids.size()); }
+
+    emscripten::val ids() { return typedView(m_ids); }
+    emscripten::val lengths() { return typedView(m_lengths); }
+    emscripten::val quantities() { return typedView(m_quantities); }
+    emscripten::val weights() { return typedView(m_weights); }
+
+    // Copy four equally long JS typed arrays (or plain arrays) into the buffer;
+    // throws a RangeError, leaving the buffer untouched, if the lengths differ
+    void assign(emscripten::val jsIds, emscripten::val jsLengths,
+                emscripten::val jsQuantities, emscripten::val jsWeights) {
+        const unsigned count = jsIds["length"].as<unsigned>();
+        const unsigned lengthCount = jsLengths["length"].as<unsigned>();
+        const unsigned quantityCount = jsQuantities["length"].as<unsigned>();
+        const unsigned weightCount = jsWeights["length"].as<unsigned>();
+        if (lengthCount != count || quantityCount != count || weightCount != count) {
+            const std::string message = "ItemBuffer.assign: column lengths differ (ids " + std::to_string(count) +
+                ", lengths " + std::to_string(lengthCount) + ", quantities " + std::to_string(quantityCount) +
+                ", weights " + std::to_string(weightCount) + ")";
+            emscripten::val::global("RangeError").new_(emscripten::val(message)).throw_();
         }
+        resize(count);
+        // Views are taken after resize() so they see the final heap
+        ids().call<void>("set", jsIds);
+        lengths().call<void>("set", jsLengths);
+        quantities().call<void>("set", jsQuantities);
+        weights().call<void>("set", jsWeights);
+    }
 
-        auto start = std::chrono::high_resolution_clock::now();
+    // Sum of the positive quantities, i.e. the number of units to pack
+    double totalQuantity() const {
+        return static_cast<double>(simd_kernels::sum_positive(m_quantities.data(), m_quantities.size()));
+    }
 
-        for (int i = 0; i < iterations; ++i) {
-            std::copy(src.begin(), src.end(), dst.begin());
+    // Build planner items straight from the columns (pure WASM loop)
+    std::vector<item> to_items() const {
+        std::vector<item> items;
+        items.reserve(m_ids.size());
+        for (size_t i = 0; i < m_ids.size(); ++i) {
+            items.emplace_back(m_ids[i], m_lengths[i], m_quantities[i], m_weights[i]);
         }
+        return items;
+    }
 
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+private:
+    std::vector<int32_t> m_ids;
+    std::vector<int32_t> m_lengths;
+    std::vector<int32_t> m_quantities;
+    std::vector<double> m_weights;
+};
+
+class PackPlanner {
+public:
+    std::vector<std::string> packItems(emscripten::val jsItems, int maxItems, double maxWeight,
+                                      int sortOrder = 0, int strategyType = 0, int threadCount = 4) {
+        auto result = m_planner.plan_packs(
+            makeConfig(maxItems, maxWeight, sortOrder, strategyType, threadCount), itemsFromRows(jsItems));
+        return packStrings(result);
+    }
 
-        // Calculate bandwidth in MB/s
-        double total_bytes = buffer_size * iterations;
-        double seconds = duration.count() / 1000000.0;
-        return (total_bytes / (1024 * 1024)) / seconds;
+    // Add a method to get the planning stats
+    emscripten::val getPlanningStats(emscripten::val jsItems, int maxItems, double maxWeight,
+                                    int sortOrder = 0, int strategyType = 0, int threadCount = 4) {
+        auto result = m_planner.plan_packs(
+            makeConfig(maxItems, maxWeight, sortOrder, strategyType, threadCount), itemsFromRows(jsItems));
+        return statsObject(result);
     }
 
-    // Network latency test (using fetch to a known endpoint)
-    emscripten::val testNetworkLatency() {
-        return emscripten::val::global("Promise").call<emscripten::val>("resolve", emscripten::val(50.0)); // Placeholder
+    // Zero-copy variants: items come from an ItemBuffer already in the WASM heap
+    std::vector<std::string> packItemBuffer(const ItemBuffer& buffer, int maxItems, double maxWeight,
+                                           int sortOrder, int strategyType, int threadCount) {
+        auto result = m_planner.plan_packs(
+            makeConfig(maxItems, maxWeight, sortOrder, strategyType, threadCount), buffer.to_items());
+        return packStrings(result);
     }
 
-    // Battery status assessment
-    emscripten::val getBatteryInfo() {
-        // This will be handled in JavaScript and passed back
-        return emscripten::val::object();
+    emscripten::val getPlanningStatsFromBuffer(const ItemBuffer& buffer, int maxItems, double maxWeight,
+                                              int sortOrder, int strategyType, int threadCount) {
+        auto result = m_planner.plan_packs(
+            makeConfig(maxItems, maxWeight, sortOrder, strategyType, threadCount), buffer.to_items());
+        return statsObject(result);
     }
 
-public:
-    SystemProfiler() : rng(std::chrono::steady_clock::now().time_since_epoch().count()) {}
-
-    // Main profiling method
-    emscripten::val profileSystem() {
-        ProfilerResults results;
-
-        // CPU benchmarking
-        results.cpu_score = benchmarkCPU();
-
-        // Memory bandwidth testing
-        results.memory_bandwidth_mbps = benchmarkMemoryBandwidth();
-
-        // These will be filled by JavaScript callbacks
-        results.network_latency_ms = 0.0;
-        results.network_bandwidth_mbps = 0.0;
-        results.battery_level = 1.0;
-        results.is_charging = true;
-
-        // Make recommendation based on CPU and memory performance
-        makeRecommendation(results);
-
-        // Convert to JavaScript object
-        emscripten::val jsResults = emscripten::val::object();
-        jsResults.set("cpuScore", results.cpu_score);
-        jsResults.set("memoryBandwidthMbps", results.memory_bandwidth_mbps);
-        jsResults.set("networkLatencyMs", results.network_latency_ms);
-        jsResults.set("networkBandwidthMbps", results.network_bandwidth_mbps);
-        jsResults.set("batteryLevel", results.battery_level);
-        jsResults.set("isCharging", results.is_charging);
-        jsResults.set("recommendation", results.recommendation);
-        jsResults.set("confidenceScore", results.confidence_score);
-
-        return jsResults;
+    // Columnar variant: Int32Array ids/lengths/quantities and Float64Array weights
+    emscripten::val getPlanningStatsColumnar(emscripten::val ids, emscripten::val lengths,
+                                            emscripten::val quantities, emscripten::val weights,
+                                            int maxItems, double maxWeight,
+                                            int sortOrder, int strategyType, int threadCount) {
+        m_columns.assign(ids, lengths, quantities, weights);
+        return getPlanningStatsFromBuffer(m_columns, maxItems, maxWeight, sortOrder, strategyType, threadCount);
     }
 
-    // Stress test for more intensive profiling
-    emscripten::val stressTest(int duration_seconds) {
-        auto start = std::chrono::high_resolution_clock::now();
-        auto end_time = start + std::chrono::seconds(duration_seconds);
+    std::vector<std::string> packItemsColumnar(emscripten::val ids, emscripten::val lengths,
+                                              emscripten::val quantities, emscripten::val weights,
+                                              int maxItems, double maxWeight,
+                                              int sortOrder, int strategyType, int threadCount) {
+        m_columns.assign(ids, lengths, quantities, weights);
+        return packItemBuffer(m_columns, maxItems, maxWeight, sortOrder, strategyType, threadCount);
+    }
 
-        double cpu_total = 0.0;
-        double memory_total = 0.0;
-        int iterations = 0;
+    /**
+     * Plan once and return the stats together with the packs as typed-array
+     * views over result columns held by this PackPlanner (see plan_columns):
+     * packOffsets (Uint32Array, packCount + 1 entries), packNumbers,
+     * packLengths, packWeights, itemIds, itemLengths, itemQuantities and
+     * itemWeights. The views stay valid until the next plan call, heap growth
+     * or delete(); copy them with slice() to keep them longer.
+     */
+    emscripten::val plan(const ItemBuffer& buffer, int maxItems, double maxWeight,
+                         int sortOrder, int strategyType, int threadCount) {
+        auto result = m_planner.plan_packs(
+            makeConfig(maxItems, maxWeight, sortOrder, strategyType, threadCount), buffer.to_items());
+        m_result.assign(result);
+        return planObject(result, m_result);
+    }
 
-        while (std::chrono::high_resolution_clock::now() < end_time) {
-            cpu_total += benchmarkCPU();
-            memory_total += benchmarkMemoryBandwidth();
-            iterations++;
-        }
+    emscripten::val planColumnar(emscripten::val ids, emscripten::val lengths,
+                                 emscripten::val quantities, emscripten::val weights,
+                                 int maxItems, double maxWeight,
+                                 int sortOrder, int strategyType, int threadCount) {
+        m_columns.assign(ids, lengths, quantities, weights);
+        return plan(m_columns, maxItems, maxWeight, sortOrder, strategyType, threadCount);
+    }
 
-        emscripten::val results = emscripten::val::object();
-        results.set("avgCpuScore", cpu_total / iterations);
-        results.set("avgMemoryBandwidth", memory_total / iterations);
-        results.set("iterations", iterations);
-        results.set("duration", duration_seconds);
+    /**
+     * Plan once and return the packs and stats as JSON text written straight
+     * from the result (see plan_json_writer): one {"packs":[...],"metrics":{...}}
+     * document, or with ndjson one pack per line and a final metrics line.
+     * JSON.parse() gives objects in the shape of the C# API responses.
+     */
+    std::string planJson(const ItemBuffer& buffer, int maxItems, double maxWeight,
+                         int sortOrder, int strategyType, int threadCount, bool ndjson) {
+        auto result = m_planner.plan_packs(
+            makeConfig(maxItems, maxWeight, sortOrder, strategyType, threadCount), buffer.to_items());
+        std::ostringstream json;
+        write_plan_json(result, json, ndjson ? output_format::NDJSON : output_format::JSON);
+        return std::move(json).str();
+    }
 
-        return results;
+    std::string planJsonColumnar(emscripten::val ids, emscripten::val lengths,
+                                 emscripten::val quantities, emscripten::val weights,
+                                 int maxItems, double maxWeight,
+                                 int sortOrder, int strategyType, int threadCount, bool ndjson) {
+        m_columns.assign(ids, lengths, quantities, weights);
+        return planJson(m_columns, maxItems, maxWeight, sortOrder, strategyType, threadCount, ndjson);
     }
 
 private:
-    void makeRecommendation(ProfilerResults& results) {
-        // Simple scoring algorithm
-        double cpu_weight = 0.4;
-        double memory_weight = 0.3;
-        double network_weight = 0.2;
-        double battery_weight = 0.1;
-
-        // Normalize scores (these thresholds would be calibrated based on real data)
-        double cpu_normalized = std::min(results.cpu_score / 10.0, 1.0); // Assume 10 MOPS is excellent
-        double memory_normalized = std::min(results.memory_bandwidth_mbps / 10000.0, 1.0); // 10GB/s is excellent
-        double network_normalized = 1.0; // Will be updated when network tests are implemented
-        double battery_normalized = results.battery_level;
-
-        double overall_score = cpu_normalized * cpu_weight +
-                              memory_normalized * memory_weight +
-                              network_normalized * network_weight +
-                              battery_normalized * battery_weight;
-
-        results.confidence_score = overall_score;
-
-        if (overall_score > 0.7) {
-            results.recommendation = "CLIENT_PREFERRED";
-        } else if (overall_score > 0.4) {
-            results.recommendation = "HYBRID";
-        } else {
-            results.recommendation = "SERVER_PREFERRED";
-        }
+    static pack_planner_config makeConfig(int maxItems, double maxWeight,
+                                          int sortOrder, int strategyType, int threadCount) {
+        pack_planner_config config;
+        config.max_items_per_pack = maxItems;
+        config.max_weight_per_pack = maxWeight;
+        config.order = sortOrderArg(sortOrder);
+        config.type = strategyTypeArg(strategyType);
+        config.thread_count = threadCount;
+        return config;
     }
-};
 
-class PackPlanner {
-public:
-    std::vector<std::string> packItems(emscripten::val jsItems, int maxItems, double maxWeight,
-                                      int sortOrder = 0, int strategyType = 0, int threadCount = 4) {
+    // Row input ([[id, length, quantity, weight], ...]): four val round trips per item
+    static std::vector<item> itemsFromRows(emscripten::val jsItems) {
         std::vector<item> items;
-
-        // Convert JS array to C++ vector<item>
         unsigned length = jsItems["length"].as<unsigned>();
+        items.reserve(length);
         for (unsigned i = 0; i < length; ++i) {
             emscripten::val jsItem = jsItems[i];
             items.emplace_back(
@@ -199,109 +271,183 @@ public:
                 jsItem[3].as<double>()  // weight
             );
         }
+        return items;
+    }
 
-        // Create configuration
-        pack_planner_config config;
-        config.max_items_per_pack = maxItems;
-        config.max_weight_per_pack = maxWeight;
-        config.order = static_cast<sort_order>(sortOrder);
-        config.type = static_cast<strategy_type>(strategyType);
-        config.thread_count = threadCount;
-
-        // Use pack_planner instead of directly using blocking_pack_strategy
-        pack_planner planner;
-        auto result = planner.plan_packs(config, items);
-
+    static std::vector<std::string> packStrings(const pack_planner_result& result) {
         std::vector<std::string> results;
         for (const auto& p : result.packs) {
             if (!p.is_empty()) {
                 results.push_back(p.to_string());
             }
         }
-
         return results;
     }
 
-    // Add a method to get the planning stats
-    emscripten::val getPlanningStats(emscripten::val jsItems, int maxItems, double maxWeight,
-                                    int sortOrder = 0, int strategyType = 0, int threadCount = 4) {
-        std::vector<item> items;
+    // Reused across calls so the strategy and column storage are not rebuilt each time
+    pack_planner m_planner;
+    ItemBuffer m_columns;
+    plan_columns m_result;
+};
 
-        // Convert JS array to C++ vector<item>
-        unsigned length = jsItems["length"].as<unsigned>();
-        for (unsigned i = 0; i < length; ++i) {
-            emscripten::val jsItem = jsItems[i];
-            items.emplace_back(
-                jsItem[0].as<int>(),    // id
-                jsItem[1].as<int>(),    // length
-                jsItem[2].as<int>(),    // quantity
-                jsItem[3].as<double>()  // weight
-            );
+/**
+ * Resumable planning for the browser main thread.
+ *
+ *   const session = new Module.PlanningSession(buffer, maxItems, maxWeight, sortOrder);
+ *   function tick() {
+ *       const { done, progress } = session.step(8);   // ~8 ms per frame
+ *       render(progress);
+ *       if (!done) requestAnimationFrame(tick);
+ *       else show(session.result());
+ *   }
+ *
+ * Packing is next-fit (the blocking strategy) since the main thread has no
+ * workers to spread a parallel plan over. The item buffer is copied on
+ * construction and may be reused or deleted straight away.
+ */
+class PlanningSession {
+public:
+    PlanningSession(const ItemBuffer& buffer, int maxItems, double maxWeight, int sortOrder)
+        : m_session(makeConfig(maxItems, maxWeight, sortOrder), buffer.to_items()) {}
+
+    // Advance for about budgetMs milliseconds; returns { done, progress, packCount }
+    emscripten::val step(double budgetMs) {
+        const bool done = m_session.step(budgetMs);
+
+        emscripten::val status = emscripten::val::object();
+        status.set("done", done);
+        status.set("progress", m_session.progress());
+        status.set("packCount", m_session.pack_count());
+        return status;
+    }
+
+    bool isDone() const { return m_session.done(); }
+    double progress() const { return m_session.progress(); }
+
+    // Finish any remaining work and return the same object as PackPlanner.plan()
+    emscripten::val result() {
+        if (!m_result) {
+            m_result = m_session.result();
+            m_columns.assign(*m_result);
         }
+        return planObject(*m_result, m_columns);
+    }
 
-        // Create configuration
+private:
+    static pack_planner_config makeConfig(int maxItems, double maxWeight, int sortOrder) {
         pack_planner_config config;
         config.max_items_per_pack = maxItems;
         config.max_weight_per_pack = maxWeight;
-        config.order = static_cast<sort_order>(sortOrder);
-        config.type = static_cast<strategy_type>(strategyType);
-        config.thread_count = threadCount;
+        config.order = sortOrderArg(sortOrder);
+        return config;
+    }
 
-        // Use pack_planner
-        pack_planner planner;
-        auto result = planner.plan_packs(config, items);
-
-        // Return stats as a JavaScript object
-        emscripten::val stats = emscripten::val::object();
-        stats.set("sortingTime", result.sorting_time);
-        stats.set("packingTime", result.packing_time);
-        stats.set("totalTime", result.total_time);
-        stats.set("totalItems", result.total_items);
-        stats.set("utilizationPercent", result.utilization_percent);
-        stats.set("strategyName", result.strategy_name);
-        stats.set("packCount", result.packs.size());
-
-        return stats;
+    planning_session m_session;
+    std::optional<pack_planner_result> m_result;
+    plan_columns m_columns;
+};
+
+/**
+ * Plan on the persistent worker pool, off the browser main thread.
+ *
+ * With -pthread the WASM heap is a SharedArrayBuffer, so the ItemBuffer
+ * columns JavaScript filled are already visible to the workers; they are
+ * copied into the job once, inside WASM, and the main thread returns at
+ * once. Poll isDone() (e.g. once per animation frame) and read result(),
+ * which returns the same object as PackPlanner.plan(), or null while the
+ * plan is still running. Parallel strategies fan out over the same pool.
+ */
+class BackgroundPlan {
+public:
+    BackgroundPlan(const ItemBuffer& buffer, int maxItems, double maxWeight,
+                   int sortOrder, int strategyType, int threadCount)
+        : m_job(std::make_shared<job>()) {
+        m_job->config.max_items_per_pack = maxItems;
+        m_job->config.max_weight_per_pack = maxWeight;
+        m_job->config.order = sortOrderArg(sortOrder);
+        m_job->config.type = strategyTypeArg(strategyType);
+        m_job->config.thread_count = threadCount;
+        m_job->items = buffer.to_items();
+
+        // The job owns its state, so deleting this object early is safe
+        thread_pool::shared().submit([job = m_job] {
+            pack_planner planner;
+            job->result = planner.plan_packs(job->config, std::move(job->items));
+            job->columns.assign(job->result);
+            job->done.store(true, std::memory_order_release);
+        });
     }
 
-    // Add benchmark method for WASM
-    emscripten::val runBenchmark(int size, int sortOrder, int strategyType, int threadCount) {
-        benchmark bench;
-        benchmark_result result = bench.run_single_benchmark(
-            size,
-            static_cast<sort_order>(sortOrder),
-            static_cast<strategy_type>(strategyType),
-            threadCount
-        );
-
-        // Return results as a JavaScript object
-        emscripten::val jsResult = emscripten::val::object();
-        jsResult.set("size", result.size);
-        jsResult.set("order", result.order);
-        jsResult.set("strategy", result.strategy);
-        jsResult.set("numThreads", result.num_threads);
-        jsResult.set("sortingTime", result.sorting_time);
-        jsResult.set("packingTime", result.packing_time);
-        jsResult.set("totalTime", result.total_time);
-        jsResult.set("itemsPerSecond", result.items_per_second);
-        jsResult.set("totalPacks", result.total_packs);
-        jsResult.set("utilizationPercent", result.utilization_percent);
-
-        return jsResult;
+    bool isDone() const { return m_job->done.load(std::memory_order_acquire); }
+
+    emscripten::val result() const {
+        if (!isDone()) return emscripten::val::null();
+        return planObject(m_job->result, m_job->columns);
     }
+
+private:
+    struct job {
+        pack_planner_config config;
+        std::vector<item> items;
+        pack_planner_result result;
+        plan_columns columns;
+        std::atomic<bool> done{false};
+    };
+
+    std::shared_ptr<job> m_job;
 };
 
+// Start the worker pool now (its threads come from PTHREAD_POOL_SIZE) so the
+// first parallel or background plan does not pay for it
+inline unsigned prewarmWorkers() {
+    return static_cast<unsigned>(thread_pool::shared().size());
+}
+
+// True when this module is the -msimd128 variant
+inline bool simdEnabled() {
+    return simd_kernels::enabled();
+}
+
 EMSCRIPTEN_BINDINGS(pack_planner_module) {
     emscripten::class_<PackPlanner>("PackPlanner")
         .constructor<>()
         .function("packItems", &PackPlanner::packItems)
         .function("getPlanningStats", &PackPlanner::getPlanningStats)
-        .function("runBenchmark", &PackPlanner::runBenchmark);
-
-    emscripten::class_<SystemProfiler>("SystemProfiler")
+        .function("packItemBuffer", &PackPlanner::packItemBuffer)
+        .function("getPlanningStatsFromBuffer", &PackPlanner::getPlanningStatsFromBuffer)
+        .function("packItemsColumnar", &PackPlanner::packItemsColumnar)
+        .function("getPlanningStatsColumnar", &PackPlanner::getPlanningStatsColumnar)
+        .function("plan", &PackPlanner::plan)
+        .function("planColumnar", &PackPlanner::planColumnar)
+        .function("planJson", &PackPlanner::planJson)
+        .function("planJsonColumnar", &PackPlanner::planJsonColumnar);
+
+    emscripten::class_<ItemBuffer>("ItemBuffer")
         .constructor<>()
-        .function("profileSystem", &SystemProfiler::profileSystem)
-        .function("stressTest", &SystemProfiler::stressTest);
+        .constructor<unsigned>()
+        .function("resize", &ItemBuffer::resize)
+        .function("size", &ItemBuffer::size)
+        .function("ids", &ItemBuffer::ids)
+        .function("lengths", &ItemBuffer::lengths)
+        .function("quantities", &ItemBuffer::quantities)
+        .function("weights", &ItemBuffer::weights)
+        .function("totalQuantity", &ItemBuffer::totalQuantity)
+        .function("assign", &ItemBuffer::assign);
+
+    emscripten::class_<PlanningSession>("PlanningSession")
+        .constructor<const ItemBuffer&, int, double, int>()
+        .function("step", &PlanningSession::step)
+        .function("isDone", &PlanningSession::isDone)
+        .function("progress", &PlanningSession::progress)
+        .function("result", &PlanningSession::result);
+
+    emscripten::class_<BackgroundPlan>("BackgroundPlan")
+        .constructor<const ItemBuffer&, int, double, int, int, int>()
+        .function("isDone", &BackgroundPlan::isDone)
+        .function("result", &BackgroundPlan::result);
+
+    emscripten::function("prewarmWorkers", &prewarmWorkers);
+    emscripten::function("simdEnabled", &simdEnabled);
 
     emscripten::register_vector<std::string>("VectorString");
 
@@ -309,7 +455,10 @@ EMSCRIPTEN_BINDINGS(pack_planner_module) {
     emscripten::enum_<sort_order>("SortOrder")
         .value("NATURAL", sort_order::NATURAL)
         .value("SHORT_TO_LONG", sort_order::SHORT_TO_LONG)
-        .value("LONG_TO_SHORT", sort_order::LONG_TO_SHORT);
+        .value("LONG_TO_SHORT", sort_order::LONG_TO_SHORT)
+        .value("HEAVY_TO_LIGHT", sort_order::HEAVY_TO_LIGHT)
+        .value("SHORT_TO_LONG_HEAVY_FIRST", sort_order::SHORT_TO_LONG_HEAVY_FIRST)
+        .value("LONG_TO_SHORT_HEAVY_FIRST", sort_order::LONG_TO_SHORT_HEAVY_FIRST);
 
     emscripten::enum_<strategy_type>("StrategyType")
         .value("BLOCKING", strategy_type::BLOCKING_FIRST_FIT)
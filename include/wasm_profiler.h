@@ -0,0 +1,163 @@
+#pragma once
+#ifdef __EMSCRIPTEN__
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+#include "benchmark.h"
+#include "plan_cost_model.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+// Profiling and benchmarking, built as a separate module (pack_planner_profiler)
+// that the page loads lazily so it does not delay the planner module.
+
+/**
+ * Device profiler that routes planning between WASM and the server.
+ *
+ * Instead of a generic CPU score, calibrate() plans a small synthetic
+ * workload with every strategy and fits a per-device cost model (see
+ * plan_cost_model). routePlan() then predicts the latency of the pending
+ * request on this device and compares it with the cost of sending it to
+ * the server.
+ */
+class SystemProfiler {
+public:
+    // Calibrate once; later calls reuse the fitted model
+    void calibrate() {
+        if (m_calibrated) return;
+        m_model.calibrate(plan_cost_model::default_strategies(), {1000, 4000, 16000}, 3,
+                          static_cast<int>(thread_pool::shared().size()) + 1);
+        m_calibrated = true;
+    }
+
+    bool isCalibrated() const { return m_calibrated; }
+
+    emscripten::val profileSystem() {
+        calibrate();
+
+        emscripten::val jsResults = emscripten::val::object();
+        emscripten::val costs = emscripten::val::object();
+        for (const auto type : plan_cost_model::default_strategies()) {
+            const plan_cost* fitted = m_model.cost(type);
+            emscripten::val entry = emscripten::val::object();
+            entry.set("fixedMs", fitted->fixed_ms);
+            entry.set("msPerItem", fitted->ms_per_item);
+            costs.set(static_cast<int>(type), entry);
+        }
+        // Planning throughput of the default strategy, in millions of items per second
+        const double ms_per_item = m_model.cost(strategy_type::BLOCKING_FIRST_FIT)->ms_per_item;
+        jsResults.set("cpuScore", ms_per_item > 0.0 ? 1.0 / (ms_per_item * 1000.0) : 0.0);
+        jsResults.set("costModel", costs);
+        return jsResults;
+    }
+
+    double predictPlanMs(unsigned itemCount, int strategyType) {
+        calibrate();
+        return m_model.predict_ms(static_cast<strategy_type>(strategyType), itemCount).value_or(0.0);
+    }
+
+    // Decide where to plan a request of itemCount lines, given the measured network
+    emscripten::val routePlan(unsigned itemCount, int strategyType,
+                              double networkLatencyMs, double networkBandwidthMbps) {
+        const double client_ms = predictPlanMs(itemCount, strategyType);
+        // Round trip plus upload of the request; server compute is small next to a WAN hop
+        const double transfer_ms = networkBandwidthMbps > 0.0
+            ? itemCount * WIRE_BYTES_PER_ITEM / (networkBandwidthMbps * 1024.0 * 1024.0) * 1000.0
+            : 0.0;
+        const double server_ms = std::max(0.0, networkLatencyMs) + transfer_ms;
+
+        std::string recommendation;
+        if (client_ms <= server_ms * CLIENT_MARGIN) {
+            recommendation = "CLIENT_PREFERRED";
+        } else if (client_ms * CLIENT_MARGIN >= server_ms) {
+            recommendation = "SERVER_PREFERRED";
+        } else {
+            recommendation = "HYBRID";
+        }
+
+        emscripten::val route = emscripten::val::object();
+        route.set("predictedClientMs", client_ms);
+        route.set("predictedServerMs", server_ms);
+        route.set("recommendation", recommendation);
+        // How clearly one side wins: 0 for a tie, approaching 1 for a large gap
+        const double slower = std::max(client_ms, server_ms);
+        route.set("confidenceScore", slower > 0.0 ? std::abs(client_ms - server_ms) / slower : 0.0);
+        return route;
+    }
+
+    // Re-run the calibration workload repeatedly for the given time
+    emscripten::val stressTest(int duration_seconds) {
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds(duration_seconds);
+
+        double score_total = 0.0;
+        int iterations = 0;
+        do {
+            m_calibrated = false;
+            m_model.clear();
+            score_total += profileSystem()["cpuScore"].as<double>();
+            iterations++;
+        } while (std::chrono::steady_clock::now() < end_time);
+
+        emscripten::val results = emscripten::val::object();
+        results.set("avgCpuScore", score_total / iterations);
+        results.set("iterations", iterations);
+        results.set("duration", duration_seconds);
+        return results;
+    }
+
+private:
+    // Approximate JSON size of one item row in a server request
+    static constexpr double WIRE_BYTES_PER_ITEM = 64.0;
+    // Prefer a side only when it is predicted at least this much faster
+    static constexpr double CLIENT_MARGIN = 0.8;
+
+    plan_cost_model m_model;
+    bool m_calibrated = false;
+};
+
+// Synthetic benchmark runs (see benchmark::run_single_benchmark)
+class Benchmark {
+public:
+    emscripten::val runBenchmark(int size, int sortOrder, int strategyType, int threadCount) {
+        benchmark bench;
+        benchmark_result result = bench.run_single_benchmark(
+            size,
+            static_cast<sort_order>(sortOrder),
+            static_cast<strategy_type>(strategyType),
+            threadCount
+        );
+
+        // Return results as a JavaScript object
+        emscripten::val jsResult = emscripten::val::object();
+        jsResult.set("size", result.size);
+        jsResult.set("order", result.order);
+        jsResult.set("strategy", result.strategy);
+        jsResult.set("numThreads", result.num_threads);
+        jsResult.set("sortingTime", result.sorting_time);
+        jsResult.set("packingTime", result.packing_time);
+        jsResult.set("totalTime", result.total_time);
+        jsResult.set("itemsPerSecond", result.items_per_second);
+        jsResult.set("totalPacks", result.total_packs);
+        jsResult.set("utilizationPercent", result.utilization_percent);
+
+        return jsResult;
+    }
+};
+
+EMSCRIPTEN_BINDINGS(pack_planner_profiler_module) {
+    emscripten::class_<SystemProfiler>("SystemProfiler")
+        .constructor<>()
+        .function("calibrate", &SystemProfiler::calibrate)
+        .function("isCalibrated", &SystemProfiler::isCalibrated)
+        .function("profileSystem", &SystemProfiler::profileSystem)
+        .function("predictPlanMs", &SystemProfiler::predictPlanMs)
+        .function("routePlan", &SystemProfiler::routePlan)
+        .function("stressTest", &SystemProfiler::stressTest);
+
+    emscripten::class_<Benchmark>("Benchmark")
+        .constructor<>()
+        .function("runBenchmark", &Benchmark::runBenchmark);
+}
+#endif
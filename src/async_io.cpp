@@ -0,0 +1,419 @@
+#include "async_io.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(PACK_PLANNER_HAS_IO_URING)
+#include <atomic>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace detail {
+
+#if defined(PACK_PLANNER_HAS_IO_URING)
+
+/**
+ * @brief Minimal io_uring wrapper using the raw syscalls (no liburing)
+ *
+ * Supports one read or write in flight at a time, which is all the double
+ * buffering needs: the other buffer is owned by the caller meanwhile.
+ */
+class io_ring {
+public:
+    /**
+     * @brief Try to create a ring
+     * @return std::unique_ptr<io_ring> The ring, or nullptr if io_uring is unavailable
+     */
+    static std::unique_ptr<io_ring> create() {
+        auto ring = std::unique_ptr<io_ring>(new io_ring());
+        if (!ring->setup()) return nullptr;
+        return ring;
+    }
+
+    ~io_ring() {
+        if (m_sqes != MAP_FAILED) munmap(m_sqes, m_sqes_size);
+        if (m_cq_ptr != MAP_FAILED && m_cq_ptr != m_sq_ptr) munmap(m_cq_ptr, m_cq_size);
+        if (m_sq_ptr != MAP_FAILED) munmap(m_sq_ptr, m_sq_size);
+        if (m_fd >= 0) close(m_fd);
+    }
+
+    /**
+     * @brief Submit a single read or write
+     * @param opcode IORING_OP_READ or IORING_OP_WRITE
+     * @param fd Target file descriptor
+     * @param data Buffer address
+     * @param size Number of bytes
+     * @param offset File offset, or -1 to use (and advance) the current position
+     * @return bool True if the request was accepted by the kernel
+     */
+    [[nodiscard]] bool submit(std::uint8_t opcode, int fd, void* data, std::size_t size,
+                              std::uint64_t offset) noexcept {
+        const unsigned tail = m_sq_tail->load(std::memory_order_relaxed);
+        const unsigned index = tail & *m_sq_mask;
+
+        io_uring_sqe& sqe = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(data);
+        sqe.len = static_cast<std::uint32_t>(size);
+        sqe.off = offset;
+        sqe.user_data = IO_USER_DATA;
+
+        m_sq_array[index] = index;
+        m_sq_tail->store(tail + 1, std::memory_order_release);
+
+        for (;;) {
+            const long submitted = syscall(__NR_io_uring_enter, m_fd, 1, 0, 0, nullptr, 0);
+            if (submitted == 1) return true;
+            if (submitted < 0 && errno == EINTR) continue;
+            return false;
+        }
+    }
+
+    /**
+     * @brief Cancel the request in flight and wait until the kernel is done with its buffer
+     *
+     * The request completes either with its result (it finished first) or
+     * with -ECANCELED; the cancel request completes too. Both are reaped.
+     */
+    void cancel() noexcept {
+        const unsigned tail = m_sq_tail->load(std::memory_order_relaxed);
+        const unsigned index = tail & *m_sq_mask;
+
+        io_uring_sqe& sqe = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_ASYNC_CANCEL;
+        sqe.fd = -1;
+        sqe.addr = IO_USER_DATA;
+        sqe.user_data = CANCEL_USER_DATA;
+
+        m_sq_array[index] = index;
+        m_sq_tail->store(tail + 1, std::memory_order_release);
+
+        long submitted;
+        do {
+            submitted = syscall(__NR_io_uring_enter, m_fd, 1, 0, 0, nullptr, 0);
+        } while (submitted < 0 && errno == EINTR);
+
+        // Without the cancel in the ring only the request itself completes
+        for (int pending = submitted == 1 ? 2 : 1; pending > 0; --pending) {
+            (void)wait();
+        }
+    }
+
+    /**
+     * @brief Wait for the completion of the request in flight
+     * @return long Bytes transferred, or a negative errno value
+     */
+    [[nodiscard]] long wait() noexcept {
+        for (;;) {
+            const unsigned head = m_cq_head->load(std::memory_order_relaxed);
+            if (head != m_cq_tail->load(std::memory_order_acquire)) {
+                const long res = m_cqes[head & *m_cq_mask].res;
+                m_cq_head->store(head + 1, std::memory_order_release);
+                return res;
+            }
+            const long rc = syscall(__NR_io_uring_enter, m_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (rc < 0 && errno != EINTR) return -errno;
+        }
+    }
+
+private:
+    static constexpr std::uint64_t IO_USER_DATA = 1;
+    static constexpr std::uint64_t CANCEL_USER_DATA = 2;
+
+    io_ring() = default;
+
+    bool setup() noexcept {
+        io_uring_params params{};
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, 2, &params));
+        if (m_fd < 0) return false;
+
+        // Offset -1 ("current position") is needed for pipes and stdout
+        if (!(params.features & IORING_FEAT_RW_CUR_POS)) return false;
+
+        m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+        }
+
+        m_sq_ptr = mmap(nullptr, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        m_fd, IORING_OFF_SQ_RING);
+        if (m_sq_ptr == MAP_FAILED) return false;
+
+        m_cq_ptr = single_mmap ? m_sq_ptr
+                               : mmap(nullptr, m_cq_size, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        if (m_cq_ptr == MAP_FAILED) return false;
+
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          m_fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(m_sq_ptr);
+        m_sq_tail = reinterpret_cast<std::atomic<unsigned>*>(sq + params.sq_off.tail);
+        m_sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*>(m_cq_ptr);
+        m_cq_head = reinterpret_cast<std::atomic<unsigned>*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<std::atomic<unsigned>*>(cq + params.cq_off.tail);
+        m_cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    int m_fd = -1;
+    void* m_sq_ptr = MAP_FAILED;
+    void* m_cq_ptr = MAP_FAILED;
+    std::size_t m_sq_size = 0;
+    std::size_t m_cq_size = 0;
+    std::size_t m_sqes_size = 0;
+    io_uring_sqe* m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+
+    std::atomic<unsigned>* m_sq_tail = nullptr;
+    unsigned* m_sq_mask = nullptr;
+    unsigned* m_sq_array = nullptr;
+    std::atomic<unsigned>* m_cq_head = nullptr;
+    std::atomic<unsigned>* m_cq_tail = nullptr;
+    unsigned* m_cq_mask = nullptr;
+    io_uring_cqe* m_cqes = nullptr;
+};
+
+#else
+
+/**
+ * @brief Stand-in when io_uring is not available; create() always fails
+ */
+class io_ring {
+public:
+    static std::unique_ptr<io_ring> create() { return nullptr; }
+    [[nodiscard]] bool submit(std::uint8_t, int, void*, std::size_t, std::uint64_t) noexcept { return false; }
+    [[nodiscard]] long wait() noexcept { return -ENOSYS; }
+    void cancel() noexcept {}
+};
+
+#endif
+
+} // namespace detail
+
+namespace {
+
+#if defined(PACK_PLANNER_HAS_IO_URING)
+constexpr std::uint8_t OP_READ = IORING_OP_READ;
+constexpr std::uint8_t OP_WRITE = IORING_OP_WRITE;
+#else
+constexpr std::uint8_t OP_READ = 0;
+constexpr std::uint8_t OP_WRITE = 0;
+#endif
+
+constexpr std::uint64_t CURRENT_POSITION = ~std::uint64_t{0};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// async_input_buffer
+// ---------------------------------------------------------------------------
+
+async_input_buffer::async_input_buffer(int fd, std::size_t buffer_size)
+    : m_fd(fd), m_ring(detail::io_ring::create()) {
+    buffer_size = std::max<std::size_t>(buffer_size, 4096);
+    m_buffers[0].resize(buffer_size);
+    m_buffers[1].resize(buffer_size);
+
+    const off_t position = lseek(fd, 0, SEEK_CUR);
+    m_seekable = position >= 0;
+    m_offset = m_seekable ? static_cast<std::uint64_t>(position) : 0;
+
+    setg(nullptr, nullptr, nullptr);
+
+    // Start filling the first buffer right away
+    submit_read(0);
+}
+
+async_input_buffer::~async_input_buffer() {
+    // The kernel may still be writing into a buffer. Cancel rather than wait:
+    // on a pipe whose writer stays open the read would never complete.
+    // (The blocking fallback has nothing in flight; it reads on demand.)
+    if (m_pending_slot >= 0 && m_ring) {
+        m_ring->cancel();
+    }
+}
+
+void async_input_buffer::submit_read(int slot) {
+    m_pending_slot = slot;
+    if (!m_ring) return; // Blocking fallback reads lazily in wait_read()
+
+    std::vector<char>& buffer = m_buffers[slot];
+    const std::uint64_t offset = m_seekable ? m_offset : CURRENT_POSITION;
+    if (!m_ring->submit(OP_READ, m_fd, buffer.data(), buffer.size(), offset)) {
+        // Submission failure: switch to the blocking path for the rest of the stream
+        m_ring.reset();
+    }
+}
+
+long async_input_buffer::wait_read() {
+    const int slot = m_pending_slot;
+    m_pending_slot = -1;
+    std::vector<char>& buffer = m_buffers[slot];
+
+    long bytes = m_ring ? m_ring->wait() : -EAGAIN;
+
+    // Blocking fallback, also used to retry interrupted or would-block ring reads
+    while (bytes == -EINTR || bytes == -EAGAIN) {
+        bytes = m_seekable
+            ? ::pread(m_fd, buffer.data(), buffer.size(), static_cast<off_t>(m_offset))
+            : ::read(m_fd, buffer.data(), buffer.size());
+        if (bytes < 0) bytes = -errno;
+    }
+
+    if (bytes > 0) {
+        m_offset += static_cast<std::uint64_t>(bytes);
+    }
+    return bytes;
+}
+
+async_input_buffer::int_type async_input_buffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    if (m_eof) {
+        return traits_type::eof();
+    }
+    if (m_pending_slot < 0) {
+        // Prefetching stopped at the end of the manifest; read on demand from here
+        submit_read(1 - m_current_slot);
+    }
+
+    const int slot = m_pending_slot;
+    const long bytes = wait_read();
+    if (bytes <= 0) {
+        m_eof = true;
+        m_error = bytes < 0;
+        return traits_type::eof();
+    }
+
+    char* begin = m_buffers[slot].data();
+    setg(begin, begin, begin + bytes);
+    m_current_slot = slot;
+
+    // Prefetch into the other buffer while the caller parses this one, unless
+    // it holds the blank line that ends a manifest: the data after it is
+    // usually never read, and on a pipe held open the read would not complete
+    const bool blank_line = (m_last_char == '\n' && begin[0] == '\n') ||
+                            std::search_n(begin, begin + bytes, 2, '\n') != begin + bytes;
+    m_last_char = begin[bytes - 1];
+    if (!blank_line) {
+        submit_read(1 - slot);
+    }
+
+    return traits_type::to_int_type(*gptr());
+}
+
+// ---------------------------------------------------------------------------
+// async_output_buffer
+// ---------------------------------------------------------------------------
+
+async_output_buffer::async_output_buffer(int fd, std::size_t buffer_size)
+    : m_fd(fd), m_ring(detail::io_ring::create()) {
+    buffer_size = std::max<std::size_t>(buffer_size, 4096);
+    m_buffers[0].resize(buffer_size);
+    m_buffers[1].resize(buffer_size);
+
+    char* begin = m_buffers[0].data();
+    setp(begin, begin + buffer_size);
+}
+
+async_output_buffer::~async_output_buffer() {
+    sync();
+}
+
+bool async_output_buffer::write_all(const char* data, std::size_t size) noexcept {
+    while (size > 0) {
+        const ssize_t written = ::write(m_fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+void async_output_buffer::wait_write() {
+    if (m_pending_slot < 0) return;
+
+    const char* data = m_buffers[m_pending_slot].data();
+    while (m_pending_done < m_pending_size) {
+        const long res = m_ring->wait();
+        if (res == -EINTR || res == -EAGAIN) {
+            // Finish synchronously rather than spinning on the ring
+            m_error |= !write_all(data + m_pending_done, m_pending_size - m_pending_done);
+            break;
+        }
+        if (res <= 0) {
+            m_error = true;
+            break;
+        }
+        m_pending_done += static_cast<std::size_t>(res);
+        if (m_pending_done < m_pending_size) {
+            // Short write (pipes): resubmit the remainder
+            if (!m_ring->submit(OP_WRITE, m_fd, const_cast<char*>(data) + m_pending_done,
+                                m_pending_size - m_pending_done, CURRENT_POSITION)) {
+                m_error |= !write_all(data + m_pending_done, m_pending_size - m_pending_done);
+                break;
+            }
+        }
+    }
+    m_pending_slot = -1;
+}
+
+void async_output_buffer::submit_current() {
+    const std::size_t size = static_cast<std::size_t>(pptr() - pbase());
+    if (size == 0) return;
+
+    // At most one write in flight: the other buffer must be free before we swap into it
+    wait_write();
+
+    const int slot = m_current_slot;
+    if (m_ring && m_ring->submit(OP_WRITE, m_fd, m_buffers[slot].data(), size,
+                                 CURRENT_POSITION)) {
+        m_pending_slot = slot;
+        m_pending_size = size;
+        m_pending_done = 0;
+    } else {
+        m_error |= !write_all(m_buffers[slot].data(), size);
+    }
+
+    m_current_slot = 1 - slot;
+    char* begin = m_buffers[m_current_slot].data();
+    setp(begin, begin + m_buffers[m_current_slot].size());
+}
+
+async_output_buffer::int_type async_output_buffer::overflow(int_type ch) {
+    submit_current();
+    if (m_error) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int async_output_buffer::sync() {
+    submit_current();
+    wait_write();
+    return m_error ? -1 : 0;
+}
@@ -1,34 +1,49 @@
 #include "benchmark.h"
+#include "adversarial_cases.h"
 #include <iostream>
 #include <iomanip>
+#include <map>
 #include <random>
+#include <thread>
 
 const std::vector<int> benchmark::BENCHMARK_SIZES = {100000, 1000000, 5000000, 10000000, 20000000};
 const std::vector<sort_order> benchmark::SORT_ORDERS = {sort_order::NATURAL,
                                                         sort_order::LONG_TO_SHORT,
-                                                        sort_order::SHORT_TO_LONG};
+                                                        sort_order::SHORT_TO_LONG,
+                                                        sort_order::HEAVY_TO_LIGHT,
+                                                        sort_order::LONG_TO_SHORT_HEAVY_FIRST};
 const std::vector<strategy_type> benchmark::PACKING_STRATEGIES = { strategy_type::BLOCKING_FIRST_FIT,
                                                                   strategy_type::PARALLEL_FIRST_FIT };
-const std::vector<unsigned int> benchmark::THREAD_COUNTS = {0}; // 0 means use hardware concurrency
 
 benchmark::benchmark() {
 }
 
-void benchmark::run_benchmark() {
+void benchmark::run_benchmark(int max_size) {
     std::cout << "=== PERFORMANCE BENCHMARK ===" << std::endl;
     std::cout << "Running C++ Performance Benchmarks..." << std::endl;
 
+    if (m_energy_meter) {
+        // Idle draw over a short pause, for reading the per-plan figures
+        const energy_sample idle_start = m_energy_meter->sample();
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        const energy_sample idle_end = m_energy_meter->sample();
+        std::cout << "Energy: RAPL";
+        for (const auto& name : m_energy_meter->domain_names()) std::cout << " " << name;
+        std::cout << ", idle " << std::fixed << std::setprecision(1)
+                  << m_energy_meter->watts(idle_start, idle_end) << " W" << std::endl;
+    }
+
     std::vector<benchmark_result> all_results;
 
     m_total_timer.start();
 
-    for (strategy_type strategy : PACKING_STRATEGIES) {
-        for (unsigned int threads : THREAD_COUNTS) {
-            // Skip thread variations for blocking strategy
-            if (strategy == strategy_type::BLOCKING_FIRST_FIT && threads > 0) {
-                continue;
-            }
+    // The blocking strategy ignores the thread count: run it once
+    const std::vector<unsigned int> single_run = {0};
 
+    for (strategy_type strategy : PACKING_STRATEGIES) {
+        const auto& thread_counts =
+            strategy == strategy_type::BLOCKING_FIRST_FIT ? single_run : m_thread_counts;
+        for (unsigned int threads : thread_counts) {
             for (sort_order order : SORT_ORDERS) {
                 std::cout << "Strategy: " <<
                     pack_strategy_factory::strategy_type_to_string(strategy);
@@ -38,10 +53,15 @@ void benchmark::run_benchmark() {
                 }
                 std::cout << ", Order: " << sort_order_to_string(order) << std::endl;
 
-                std::cout << "Size      Sort(ms)    Pack(ms)    Total(ms)   Items/sec   Packs       Util%" << std::endl;
-                std::cout << "----------------------------------------------------------------------------" << std::endl;
+                std::cout << "Size      Sort(ms)    Pack(ms)    Total(ms)   Items/sec   Packs       Util%";
+                if (m_energy_meter) std::cout << "   Sort(J)   Pack(J)   J/plan    J/M items";
+                std::cout << std::endl;
+                std::cout << "----------------------------------------------------------------------------";
+                if (m_energy_meter) std::cout << "------------------------------------------";
+                std::cout << std::endl;
 
                 for (int size : BENCHMARK_SIZES) {
+                    if (size > max_size) continue;
                     benchmark_result result = run_single_benchmark(size, order, strategy, threads);
                     all_results.push_back(result);
 
@@ -52,7 +72,16 @@ void benchmark::run_benchmark() {
                               << std::left << std::setw(12) << result.total_time
                               << std::left << std::setw(12) << result.items_per_second
                               << std::left << std::setw(12) << result.total_packs
-                              << std::setprecision(1) << result.utilization_percent << "%" << std::endl;
+                              << std::setprecision(1) << result.utilization_percent << "%";
+                    if (result.energy_measured) {
+                        const double joules = result.sorting_joules + result.packing_joules;
+                        std::cout << std::setprecision(3)
+                                  << "   " << std::left << std::setw(10) << result.sorting_joules
+                                  << std::left << std::setw(10) << result.packing_joules
+                                  << std::left << std::setw(10) << joules
+                                  << joules * 1e6 / size;
+                    }
+                    std::cout << std::endl;
                 }
                 std::cout << std::endl;
             }
@@ -61,11 +90,95 @@ void benchmark::run_benchmark() {
 
     double total_benchmark_time = m_total_timer.stop();
 
+    if (m_energy_meter) {
+        output_energy_summary(all_results);
+    }
+
     std::cout << "Total benchmark execution: " << std::fixed << std::setprecision(3)
               << total_benchmark_time << " ms (" <<
         static_cast<long long>(total_benchmark_time * 1000) << " μs)" << std::endl;
 }
 
+bool benchmark::set_energy_measurement(bool enabled) {
+    m_energy_meter.reset();
+    if (!enabled) return true;
+
+    auto meter = std::make_unique<energy_meter>();
+    if (!meter->available()) return false;
+    m_energy_meter = std::move(meter);
+    return true;
+}
+
+void benchmark::set_thread_counts(std::vector<unsigned int> thread_counts) {
+    if (thread_counts.empty()) thread_counts.push_back(0);
+    m_thread_counts = std::move(thread_counts);
+}
+
+bool benchmark::run_adversarial_benchmark() {
+    constexpr adversarial_engine ENGINES[] = {adversarial_engine::BLOCKING, adversarial_engine::PARALLEL,
+                                              adversarial_engine::SPILLING, adversarial_engine::SESSION};
+
+    std::cout << "Adversarial Latency Guard" << std::endl;
+    std::cout << "Case                            Engine     Time (ms)   Ceiling   Packs     Memory (KiB)  Status" << std::endl;
+    std::cout << "-----------------------------------------------------------------------------------------------" << std::endl;
+
+    bool all_within = true;
+    for (const auto& c : adversarial_cases()) {
+        for (const adversarial_engine engine : ENGINES) {
+            const adversarial_run run = run_adversarial_case(c, engine);
+            const bool within = run.within(c);
+            all_within = all_within && within;
+            std::cout << std::left << std::setw(32) << c.name
+                      << std::left << std::setw(11) << adversarial_engine_name(engine)
+                      << std::fixed << std::setprecision(2)
+                      << std::left << std::setw(12) << run.elapsed_ms
+                      << std::setprecision(0)
+                      << std::left << std::setw(10) << c.time_ceiling_ms
+                      << std::left << std::setw(10) << run.pack_count
+                      << std::left << std::setw(14) << run.memory_bytes / 1024
+                      << (within ? "ok" : "EXCEEDED") << std::endl;
+        }
+    }
+    std::cout << std::endl;
+    std::cout << (all_within ? "All cases within their ceilings" : "Some cases exceeded their ceilings")
+              << std::endl;
+    return all_within;
+}
+
+void benchmark::output_energy_summary(const std::vector<benchmark_result>& results) const {
+    struct totals {
+        double joules = 0.0;
+        double items = 0.0;
+        double time_ms = 0.0;
+    };
+    std::map<std::pair<std::string, int>, totals> by_config;
+    for (const auto& r : results) {
+        if (!r.energy_measured) continue;
+        auto& t = by_config[{r.strategy, r.num_threads}];
+        t.joules += r.sorting_joules + r.packing_joules;
+        t.items += r.size;
+        t.time_ms += r.total_time;
+    }
+    if (by_config.empty()) return;
+
+    std::cout << "Energy by strategy and thread count (all sizes and orders)" << std::endl;
+    std::cout << "Strategy                    Threads   Joules      J/M items   Avg W" << std::endl;
+    std::cout << "----------------------------------------------------------------------" << std::endl;
+    for (const auto& [config, t] : by_config) {
+        const bool parallel = config.first == pack_strategy_factory::strategy_type_to_string(
+                                                  strategy_type::PARALLEL_FIRST_FIT);
+        std::cout << std::left << std::setw(28) << config.first
+                  << std::left << std::setw(10)
+                  << (!parallel ? "-" : config.second == 0 ? "Auto" : std::to_string(config.second))
+                  << std::fixed << std::setprecision(3)
+                  << std::left << std::setw(12) << t.joules
+                  << std::left << std::setw(12) << t.joules * 1e6 / t.items
+                  << std::setprecision(1) << (t.time_ms > 0.0 ? t.joules * 1000.0 / t.time_ms : 0.0)
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
 std::vector<item> benchmark::generate_test_data(int size) {
     std::vector<item> items;
     items.reserve(size);
@@ -117,7 +230,29 @@ benchmark_result benchmark::run_single_benchmark(int size, sort_order order,
     config.thread_count = num_threads;
 
     // Run pack planning
-    pack_planner_result plan_result = m_planner.plan_packs(config, items);
+    pack_planner_result plan_result;
+    if (m_energy_meter) {
+        // Sort and pack as separate calls so each phase is metered on its own;
+        // packing the sorted items in natural order gives the same plan
+        const energy_sample before_sort = m_energy_meter->sample();
+        timer sort_timer;
+        sort_timer.start();
+        pack_planner::sort_items(items, order);
+        const double sorting_time = sort_timer.stop();
+        const energy_sample before_pack = m_energy_meter->sample();
+
+        config.order = sort_order::NATURAL;
+        plan_result = m_planner.plan_packs(config, std::move(items));
+        const energy_sample after_pack = m_energy_meter->sample();
+
+        plan_result.sorting_time = sorting_time;
+        plan_result.total_time += sorting_time;
+        result.energy_measured = true;
+        result.sorting_joules = m_energy_meter->joules(before_sort, before_pack);
+        result.packing_joules = m_energy_meter->joules(before_pack, after_pack);
+    } else {
+        plan_result = m_planner.plan_packs(config, items);
+    }
 
     // Fill benchmark result
     result.sorting_time = plan_result.sorting_time;
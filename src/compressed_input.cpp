@@ -0,0 +1,433 @@
+#include "compressed_input.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(PACK_PLANNER_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(PACK_PLANNER_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace {
+
+// Decoded bytes handed to the parser per underflow for single-stream inputs
+constexpr std::size_t SERIAL_CHUNK_SIZE = 1 << 20;
+
+// Compressed bytes per parallel task (a few MiB of text); BGZF blocks are <= 64 KiB
+constexpr std::size_t PARALLEL_BATCH_SIZE = 256 << 10;
+
+/**
+ * @brief Get the size of a BGZF block from its gzip header
+ * @param p Start of the gzip member
+ * @param available Bytes available from p
+ * @param block_size Receives the total block size
+ * @return bool True if p starts a complete BGZF block
+ */
+[[nodiscard]] bool bgzf_block_size(const unsigned char* p, std::size_t available,
+                                   std::size_t& block_size) noexcept {
+    if (available < 18 || p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 || !(p[3] & 4)) {
+        return false;
+    }
+
+    const std::size_t extra_end = 12 + (p[10] | (p[11] << 8));
+    if (extra_end > available) return false;
+
+    // Walk the extra subfields looking for BC (BSIZE = block size - 1)
+    std::size_t i = 12;
+    while (i + 4 <= extra_end) {
+        const std::size_t field_size = p[i + 2] | (p[i + 3] << 8);
+        if (p[i] == 'B' && p[i + 1] == 'C' && field_size == 2 && i + 6 <= extra_end) {
+            block_size = static_cast<std::size_t>(p[i + 4] | (p[i + 5] << 8)) + 1;
+            return block_size <= available;
+        }
+        i += 4 + field_size;
+    }
+    return false;
+}
+
+} // namespace
+
+compression_format detect_compression(const unsigned char* data, std::size_t size) noexcept {
+    if (size >= 2 && data[0] == 0x1f && data[1] == 0x8b) {
+        return compression_format::GZIP;
+    }
+    if (size >= 4 && data[0] == 0x28 && data[1] == 0xb5 && data[2] == 0x2f && data[3] == 0xfd) {
+        return compression_format::ZSTD;
+    }
+    return compression_format::NONE;
+}
+
+bool compression_supported(compression_format format) noexcept {
+    switch (format) {
+        case compression_format::NONE:
+            return true;
+#if defined(PACK_PLANNER_HAS_ZLIB)
+        case compression_format::GZIP:
+            return true;
+#endif
+#if defined(PACK_PLANNER_HAS_ZSTD)
+        case compression_format::ZSTD:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+namespace detail {
+
+/**
+ * @brief Incremental decoder over an in-memory compressed region
+ *
+ * Handles concatenated gzip members and concatenated zstd frames.
+ */
+struct serial_decoder {
+    serial_decoder(compression_format format, const unsigned char* data, std::size_t size)
+        : m_format(format), m_next(data), m_remaining(size) {
+        switch (format) {
+#if defined(PACK_PLANNER_HAS_ZLIB)
+            case compression_format::GZIP:
+                std::memset(&m_zlib, 0, sizeof(m_zlib));
+                // 15 + 32: maximum window, automatic gzip/zlib header detection
+                if (inflateInit2(&m_zlib, 15 + 32) != Z_OK) {
+                    throw std::runtime_error("failed to initialise gzip decoder");
+                }
+                break;
+#endif
+#if defined(PACK_PLANNER_HAS_ZSTD)
+            case compression_format::ZSTD:
+                m_zstd = ZSTD_createDStream();
+                if (!m_zstd || ZSTD_isError(ZSTD_initDStream(m_zstd))) {
+                    throw std::runtime_error("failed to initialise zstd decoder");
+                }
+                m_zstd_input = {data, size, 0};
+                m_remaining = 0;
+                break;
+#endif
+            default:
+                throw std::runtime_error("compression format not supported by this build");
+        }
+    }
+
+    ~serial_decoder() {
+#if defined(PACK_PLANNER_HAS_ZLIB)
+        if (m_format == compression_format::GZIP) inflateEnd(&m_zlib);
+#endif
+#if defined(PACK_PLANNER_HAS_ZSTD)
+        if (m_zstd) ZSTD_freeDStream(m_zstd);
+#endif
+    }
+
+    serial_decoder(const serial_decoder&) = delete;
+    serial_decoder& operator=(const serial_decoder&) = delete;
+
+    /**
+     * @brief Decode the next piece of output
+     * @param out Output buffer
+     * @param capacity Output buffer size
+     * @return std::size_t Bytes produced; 0 once the input is exhausted
+     * @throws std::runtime_error on corrupt or truncated input
+     */
+    [[nodiscard]] std::size_t decode(char* out, std::size_t capacity) {
+        if (m_finished) return 0;
+        switch (m_format) {
+#if defined(PACK_PLANNER_HAS_ZLIB)
+            case compression_format::GZIP:
+                return decode_gzip(out, capacity);
+#endif
+#if defined(PACK_PLANNER_HAS_ZSTD)
+            case compression_format::ZSTD:
+                return decode_zstd(out, capacity);
+#endif
+            default:
+                return 0;
+        }
+    }
+
+private:
+#if defined(PACK_PLANNER_HAS_ZLIB)
+    std::size_t decode_gzip(char* out, std::size_t capacity) {
+        capacity = std::min<std::size_t>(capacity, UINT_MAX);
+        m_zlib.next_out = reinterpret_cast<Bytef*>(out);
+        m_zlib.avail_out = static_cast<uInt>(capacity);
+
+        while (m_zlib.avail_out > 0) {
+            if (m_zlib.avail_in == 0) {
+                if (m_remaining == 0) {
+                    if (m_in_member) throw std::runtime_error("truncated gzip stream");
+                    m_finished = true;
+                    break;
+                }
+                const std::size_t feed = std::min<std::size_t>(m_remaining, UINT_MAX);
+                m_zlib.next_in = const_cast<Bytef*>(m_next);
+                m_zlib.avail_in = static_cast<uInt>(feed);
+                m_next += feed;
+                m_remaining -= feed;
+            }
+
+            m_in_member = true;
+            const int rc = inflate(&m_zlib, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) {
+                // Concatenated members (gzip a b > c, bgzip): start the next one
+                m_in_member = false;
+                if (m_zlib.avail_in == 0 && m_remaining == 0) {
+                    m_finished = true;
+                    break;
+                }
+                inflateReset(&m_zlib);
+            } else if (rc != Z_OK && !(rc == Z_BUF_ERROR && m_zlib.avail_in == 0)) {
+                throw std::runtime_error(std::string("corrupt gzip stream: ") +
+                                         (m_zlib.msg ? m_zlib.msg : "inflate failed"));
+            }
+        }
+        return capacity - m_zlib.avail_out;
+    }
+#endif
+
+#if defined(PACK_PLANNER_HAS_ZSTD)
+    std::size_t decode_zstd(char* out, std::size_t capacity) {
+        ZSTD_outBuffer output{out, capacity, 0};
+        while (output.pos < output.size) {
+            const std::size_t rc = ZSTD_decompressStream(m_zstd, &output, &m_zstd_input);
+            if (ZSTD_isError(rc)) {
+                throw std::runtime_error(std::string("corrupt zstd stream: ") + ZSTD_getErrorName(rc));
+            }
+            // All input consumed and output not full: everything has been flushed
+            if (m_zstd_input.pos == m_zstd_input.size && output.pos < output.size) {
+                if (rc != 0) throw std::runtime_error("truncated zstd stream");
+                m_finished = true;
+                break;
+            }
+        }
+        return output.pos;
+    }
+#endif
+
+    compression_format m_format;
+    const unsigned char* m_next;
+    std::size_t m_remaining;
+    bool m_finished = false;
+    bool m_in_member = false;
+#if defined(PACK_PLANNER_HAS_ZLIB)
+    z_stream m_zlib{};
+#endif
+#if defined(PACK_PLANNER_HAS_ZSTD)
+    ZSTD_DStream* m_zstd = nullptr;
+    ZSTD_inBuffer m_zstd_input{};
+#endif
+};
+
+} // namespace detail
+
+namespace {
+
+/**
+ * @brief Decode a whole region of independent blocks (runs on a worker thread)
+ */
+std::vector<char> decode_region(compression_format format, const unsigned char* data, std::size_t size) {
+    detail::serial_decoder decoder(format, data, size);
+    std::vector<char> output(std::max<std::size_t>(size * 4, 1 << 16));
+    std::size_t used = 0;
+    for (;;) {
+        if (used == output.size()) {
+            output.resize(output.size() * 2);
+        }
+        const std::size_t produced = decoder.decode(output.data() + used, output.size() - used);
+        if (produced == 0) break;
+        used += produced;
+    }
+    output.resize(used);
+    return output;
+}
+
+} // namespace
+
+compressed_input_buffer::compressed_input_buffer(int fd, unsigned int thread_count)
+    : m_thread_count(std::max(1u, thread_count)) {
+    setg(nullptr, nullptr, nullptr);
+
+    if (!load_input(fd)) {
+        m_done = true;
+        return;
+    }
+
+    m_format = detect_compression(m_data, m_size);
+    if (m_format == compression_format::NONE) {
+        // Plain text: hand the whole mapping to the parser, no copy
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(m_data));
+        setg(begin, begin, begin + m_size);
+        m_done = true;
+        return;
+    }
+
+    if (!compression_supported(m_format)) {
+        m_error = m_format == compression_format::GZIP
+            ? "gzip input is not supported by this build (zlib not found)"
+            : "zstd input is not supported by this build (libzstd not found)";
+        m_done = true;
+        return;
+    }
+
+    split_units();
+    if (m_units.empty()) {
+        try {
+            m_serial = std::make_unique<detail::serial_decoder>(m_format, m_data, m_size);
+        } catch (const std::exception& e) {
+            m_error = e.what();
+            m_done = true;
+        }
+    } else {
+        launch_batches();
+    }
+}
+
+compressed_input_buffer::~compressed_input_buffer() {
+    // Workers read from the mapping; wait for them before unmapping
+    m_in_flight.clear();
+    if (m_mapping) {
+        munmap(m_mapping, m_size);
+    }
+}
+
+bool compressed_input_buffer::load_input(int fd) {
+    struct stat info{};
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        const off_t start = lseek(fd, 0, SEEK_CUR);
+        if (start == 0) {
+            void* mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ,
+                                 MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                madvise(mapping, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+                m_mapping = mapping;
+                m_data = static_cast<const unsigned char*>(mapping);
+                m_size = static_cast<std::size_t>(info.st_size);
+                return true;
+            }
+        }
+    }
+
+    // Pipes (and anything that cannot be mapped): read it all; compressed input is small
+    std::size_t used = 0;
+    m_owned.resize(1 << 20);
+    for (;;) {
+        if (used == m_owned.size()) {
+            m_owned.resize(m_owned.size() * 2);
+        }
+        const ssize_t bytes = ::read(fd, m_owned.data() + used, m_owned.size() - used);
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            m_error = std::string("failed to read input: ") + std::strerror(errno);
+            return false;
+        }
+        if (bytes == 0) break;
+        used += static_cast<std::size_t>(bytes);
+    }
+    m_owned.resize(used);
+    m_data = m_owned.data();
+    m_size = used;
+    return true;
+}
+
+void compressed_input_buffer::split_units() {
+    std::vector<std::size_t> boundaries;
+    std::size_t offset = 0;
+
+    while (offset < m_size) {
+        std::size_t block_size = 0;
+        if (m_format == compression_format::GZIP) {
+            // Only BGZF records block sizes; plain gzip must be decoded serially
+            if (!bgzf_block_size(m_data + offset, m_size - offset, block_size)) return;
+        } else {
+#if defined(PACK_PLANNER_HAS_ZSTD)
+            block_size = ZSTD_findFrameCompressedSize(m_data + offset, m_size - offset);
+            if (ZSTD_isError(block_size)) return;
+#else
+            return;
+#endif
+        }
+        offset += block_size;
+        boundaries.push_back(offset);
+    }
+
+    // Group consecutive blocks into batches so each task has a worthwhile amount of work
+    std::size_t batch_start = 0;
+    for (std::size_t end : boundaries) {
+        if (end - batch_start >= PARALLEL_BATCH_SIZE || end == m_size) {
+            m_units.push_back({batch_start, end - batch_start});
+            batch_start = end;
+        }
+    }
+
+    // A single batch gains nothing over streaming it
+    if (m_units.size() < 2) {
+        m_units.clear();
+    }
+}
+
+void compressed_input_buffer::launch_batches() {
+    while (m_in_flight.size() < m_thread_count && m_next_batch < m_units.size()) {
+        const unit_batch& batch = m_units[m_next_batch++];
+        m_in_flight.push_back(std::async(std::launch::async, decode_region, m_format,
+                                         m_data + batch.offset, batch.size));
+    }
+}
+
+bool compressed_input_buffer::next_parallel_chunk() {
+    while (!m_in_flight.empty()) {
+        try {
+            m_output = m_in_flight.front().get();
+        } catch (const std::exception& e) {
+            m_error = e.what();
+            return false;
+        }
+        m_in_flight.pop_front();
+
+        // Keep the workers busy while the parser consumes this batch
+        launch_batches();
+
+        if (!m_output.empty()) {
+            setg(m_output.data(), m_output.data(), m_output.data() + m_output.size());
+            return true;
+        }
+    }
+    return false;
+}
+
+bool compressed_input_buffer::next_serial_chunk() {
+    m_output.resize(SERIAL_CHUNK_SIZE);
+    try {
+        const std::size_t produced = m_serial->decode(m_output.data(), m_output.size());
+        if (produced == 0) return false;
+        setg(m_output.data(), m_output.data(), m_output.data() + produced);
+        return true;
+    } catch (const std::exception& e) {
+        m_error = e.what();
+        return false;
+    }
+}
+
+compressed_input_buffer::int_type compressed_input_buffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    if (m_done) {
+        return traits_type::eof();
+    }
+
+    const bool more = m_serial ? next_serial_chunk() : next_parallel_chunk();
+    if (!more) {
+        m_done = true;
+        return traits_type::eof();
+    }
+    return traits_type::to_int_type(*gptr());
+}
@@ -0,0 +1,111 @@
+#include "energy_meter.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+namespace {
+
+std::optional<std::uint64_t> read_counter(const std::string& path) {
+    std::ifstream file(path);
+    std::uint64_t value = 0;
+    if (!(file >> value)) return std::nullopt;
+    return value;
+}
+
+std::string read_name(const std::filesystem::path& zone) {
+    std::ifstream file(zone / "name");
+    std::string name;
+    std::getline(file, name);
+    return name;
+}
+
+// Zone directories are named <control type>:<index>[:<subindex>...]
+bool is_top_level_zone(const std::string& directory) {
+    return std::count(directory.begin(), directory.end(), ':') == 1;
+}
+
+} // namespace
+
+energy_meter::energy_meter(const std::string& powercap_root) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    if (!fs::is_directory(powercap_root, error)) return;
+
+    auto add_domain = [this](const fs::path& zone, const std::string& name) {
+        const std::string energy_path = (zone / "energy_uj").string();
+        if (!read_counter(energy_path)) return;  // missing or not readable (needs root)
+        const auto range = read_counter((zone / "max_energy_range_uj").string());
+        m_domains.push_back(domain{name, energy_path, range.value_or(0)});
+    };
+
+    std::vector<fs::path> zones;
+    for (const auto& entry : fs::directory_iterator(powercap_root, error)) {
+        const std::string directory = entry.path().filename().string();
+        // Control types such as "intel-rapl" list the same zones again; take the zones only
+        if (directory.find("rapl:") != std::string::npos && is_top_level_zone(directory)) {
+            zones.push_back(entry.path());
+        }
+    }
+    std::sort(zones.begin(), zones.end());
+
+    for (const auto& zone : zones) {
+        const std::string name = read_name(zone);
+        if (name == "psys") continue;  // platform total: overlaps the packages
+        add_domain(zone, name);
+
+        std::vector<fs::path> subzones;
+        for (const auto& entry : fs::directory_iterator(zone, error)) {
+            const std::string directory = entry.path().filename().string();
+            if (directory.find("rapl:") != std::string::npos && entry.is_directory()) {
+                subzones.push_back(entry.path());
+            }
+        }
+        std::sort(subzones.begin(), subzones.end());
+        for (const auto& subzone : subzones) {
+            // core/uncore are part of the package; DRAM is not
+            if (read_name(subzone) == "dram") add_domain(subzone, name + "/dram");
+        }
+    }
+}
+
+std::vector<std::string> energy_meter::domain_names() const {
+    std::vector<std::string> names;
+    names.reserve(m_domains.size());
+    for (const auto& d : m_domains) names.push_back(d.name);
+    return names;
+}
+
+energy_sample energy_meter::sample() const {
+    energy_sample s;
+    s.microjoules.reserve(m_domains.size());
+    for (const auto& d : m_domains) {
+        s.microjoules.push_back(read_counter(d.energy_path).value_or(0));
+    }
+    s.time = std::chrono::steady_clock::now();
+    return s;
+}
+
+double energy_meter::joules(const energy_sample& from, const energy_sample& to) const noexcept {
+    const std::size_t count = std::min({m_domains.size(), from.microjoules.size(), to.microjoules.size()});
+    std::uint64_t total = 0;
+    for (std::size_t d = 0; d < count; ++d) {
+        const std::uint64_t a = from.microjoules[d];
+        const std::uint64_t b = to.microjoules[d];
+        if (b >= a) {
+            total += b - a;
+            continue;
+        }
+        // The counter restarts from 0 after max_energy_range_uj; with the range unknown
+        // (or below the earlier reading) the wrapped amount cannot be told, so count nothing
+        const std::uint64_t range = m_domains[d].max_range_uj;
+        if (range >= a) total += range - a + b;
+    }
+    return static_cast<double>(total) / 1e6;
+}
+
+double energy_meter::watts(const energy_sample& from, const energy_sample& to) const noexcept {
+    const double seconds = std::chrono::duration<double>(to.time - from.time).count();
+    return seconds > 0.0 ? joules(from, to) / seconds : 0.0;
+}
@@ -1,15 +1,25 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
 #include "pack_planner.h"
 #include "benchmark.h"
+#include "async_io.h"
+#include "compressed_input.h"
+#include "pack_validator.h"
+#include "plan_json.h"
 #include <CLI/CLI.hpp>
 
 void printUsage(const std::string& programName) {
-    std::cout << "Usage:" << std::endl;
-    std::cout << "  " << programName << "                    - Read from standard input" << std::endl;
-    std::cout << "  " << programName << " <input_file>       - Read from input file" << std::endl;
-    std::cout << "  " << programName << " --benchmark        - Run performance benchmark" << std::endl;
+    std::cout << "Usage:\n";
+    std::cout << "  " << programName << "                    - Read from standard input\n";
+    std::cout << "  " << programName << " <input_file>       - Read from input file\n";
+    std::cout << "  " << programName << " --benchmark        - Run performance benchmark\n";
 }
 
 /**
@@ -40,28 +50,41 @@ void printUsage(const std::string& programName) {
     config.max_items_per_pack = std::stoi(max_items_str);
     config.max_weight_per_pack = std::stod(max_weight_str);
 
-    // Parse items
+    // Parse items: id,length,quantity,weight[,volume]
     while (std::getline(input, line) && !line.empty()) {
         std::istringstream item_line(line);
-        std::string id_str, length_str, quantity_str, weight_str;
+        std::string id_str, length_str, quantity_str, weight_str, volume_str;
 
         if (std::getline(item_line, id_str, ',') &&
             std::getline(item_line, length_str, ',') &&
             std::getline(item_line, quantity_str, ',') &&
-            std::getline(item_line, weight_str)) {
+            std::getline(item_line, weight_str, ',')) {
 
             int id = std::stoi(id_str);
             int length = std::stoi(length_str);
             int quantity = std::stoi(quantity_str);
             double weight = std::stod(weight_str);
+            float volume = std::getline(item_line, volume_str) ? std::stof(volume_str) : 0.0f;
 
-            items.emplace_back(id, length, quantity, weight);
+            items.emplace_back(id, length, quantity, weight, volume);
         }
     }
 
     return true;
 }
 
+/**
+ * @brief Check whether a file starts with gzip or zstd magic bytes
+ * @param path Path of the file to check
+ * @return bool True if the file is compressed
+ */
+[[nodiscard]] static bool is_compressed_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    unsigned char magic[4] = {};
+    file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    return detect_compression(magic, static_cast<std::size_t>(file.gcount())) != compression_format::NONE;
+}
+
 int main(int argc, char* argv[]) {
     CLI::App app{"Pack Planner - Efficiently pack items into containers"};
 
@@ -75,6 +98,43 @@ int main(int argc, char* argv[]) {
 
     // Benchmark option
     bool run_benchmark = false;
+    int benchmark_max_size = std::numeric_limits<int>::max();
+    std::vector<unsigned int> benchmark_threads;
+    bool measure_energy = false;
+    bool run_adversarial = false;
+
+    // I/O options
+    bool async_io = false;
+    bool compressed_stdin = false;
+
+    // Memory budget for finished packs, in MiB (0 = unlimited)
+    std::size_t memory_budget_mb = 0;
+
+    // Optional pack limits (0 = unlimited)
+    int max_length = 0;
+    double max_volume = 0.0;
+
+    // Request capture and replay options
+    std::string capture_file;
+    double capture_rate = 1.0;
+    std::string replay_file;
+    double replay_speed = 0.0;
+    std::string replay_strategy_str = "original";
+
+    // Shadow strategy options
+    std::string shadow_strategy_str;
+    double shadow_rate = 1.0;
+
+    // Check the plan before reporting success
+    bool validate = false;
+
+    // Result format
+    std::string format_str = "text";
+
+    // Checkpoint options
+    std::string checkpoint_file;
+    double checkpoint_interval = 60.0;
+    bool resume = false;
 
     // Add CLI options
     app.add_flag("-i,--stdin", use_stdin, "Read input from standard input");
@@ -84,14 +144,96 @@ int main(int argc, char* argv[]) {
     app.add_option("-t,--threads", thread_count, "Number of threads for parallel strategy")
         ->check(CLI::Range(1, 64));
     app.add_flag("-b,--benchmark", run_benchmark, "Run performance benchmark");
+    app.add_option("--benchmark-max-size", benchmark_max_size,
+                   "Skip benchmark sizes above this item count (e.g. for PGO training runs)")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--benchmark-threads", benchmark_threads,
+                   "Thread counts for the parallel strategy in the benchmark, e.g. 1,2,4,8")
+        ->delimiter(',')
+        ->check(CLI::Range(1, 64));
+    app.add_flag("--energy", measure_energy,
+                 "Report RAPL energy (joules per plan and per million items) in the benchmark");
+    app.add_flag("--adversarial", run_adversarial,
+                 "Run pathological inputs on every engine; exit with 1 if any exceeds its time or memory ceiling");
+    app.add_flag("-a,--async-io", async_io,
+                 "Use double-buffered asynchronous I/O (io_uring when available)");
+    app.add_flag("-z,--compressed", compressed_stdin,
+                 "Decompress gzip/zstd standard input (files are detected automatically)");
+    app.add_option("-m,--memory-budget", memory_budget_mb,
+                   "MiB of finished packs kept in memory before spilling to disk (blocking strategy)");
+    app.add_option("--max-length", max_length, "Longest item a pack may hold (0 = unlimited)")
+        ->check(CLI::NonNegativeNumber);
+    app.add_option("--max-volume", max_volume,
+                   "Combined volume per pack, from the optional fifth item column (0 = unlimited)")
+        ->check(CLI::NonNegativeNumber);
+    app.add_option("--capture", capture_file, "Append the request and its timings to a binary trace file");
+    app.add_option("--capture-rate", capture_rate, "Fraction of requests to capture")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("--replay", replay_file, "Replay a captured trace and report latencies")
+        ->check(CLI::ExistingFile);
+    app.add_option("--replay-speed", replay_speed,
+                   "Replay pacing: 0 = back to back, 1 = original rate, N = N times faster")
+        ->check(CLI::NonNegativeNumber);
+    app.add_option("--replay-strategy", replay_strategy_str,
+                   "Strategy for replayed requests (original keeps the recorded one)")
+        ->check(CLI::IsMember({"original", "bff", "pff"}));
+    app.add_option("--shadow-strategy", shadow_strategy_str,
+                   "Also run this strategy in the background and report the difference")
+        ->check(CLI::IsMember({"bff", "pff"}));
+    app.add_option("--shadow-rate", shadow_rate, "Fraction of requests to shadow")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_flag("--validate", validate,
+                 "Verify pack limits, quantity conservation and sort order; exit with 1 on violations");
+    app.add_option("--format", format_str,
+                   "Result format: text, json (one document) or ndjson (one pack per line)")
+        ->check(CLI::IsMember({"text", "json", "ndjson"}));
+    auto* checkpoint_option = app.add_option("--checkpoint", checkpoint_file,
+                   "Write periodic checkpoints of the plan to this file (blocking strategy)");
+    app.add_option("--checkpoint-interval", checkpoint_interval, "Seconds between checkpoints")
+        ->check(CLI::NonNegativeNumber);
+    app.add_flag("--resume", resume,
+                 "Continue from the last checkpoint in the --checkpoint file (starts afresh if there is none)")
+        ->needs(checkpoint_option);
 
     // Parse command line
     CLI11_PARSE(app, argc, argv);
 
+    // Run the adversarial latency guard if requested
+    if (run_adversarial) {
+        benchmark benchmark;
+        return benchmark.run_adversarial_benchmark() ? 0 : 1;
+    }
+
     // Run benchmark if requested
     if (run_benchmark) {
         benchmark benchmark;
-        benchmark.run_benchmark();
+        benchmark.set_thread_counts(benchmark_threads);
+        if (!benchmark.set_energy_measurement(measure_energy)) {
+            std::cerr << "Warning: RAPL energy counters are not readable under /sys/class/powercap "
+                      << "(missing, or root required); continuing without energy figures\n";
+        }
+        benchmark.run_benchmark(benchmark_max_size);
+        return 0;
+    }
+
+    // Replay a captured trace instead of planning a single request
+    if (!replay_file.empty()) {
+        replay_options options;
+        options.speed = replay_speed;
+        if (replay_strategy_str != "original") {
+            options.strategy = (replay_strategy_str == "pff") ?
+                               strategy_type::PARALLEL_FIRST_FIT :
+                               strategy_type::BLOCKING_FIRST_FIT;
+            options.thread_count = thread_count;
+        }
+
+        auto report = replay_trace(replay_file, options);
+        if (!report) {
+            std::cerr << "Error: Not a valid trace file: " << replay_file << '\n';
+            return 1;
+        }
+        output_replay_report(*report, std::cout);
+        std::cout.flush();
         return 0;
     }
 
@@ -108,17 +250,83 @@ int main(int argc, char* argv[]) {
     // Set thread count for parallel strategy
     config.thread_count = thread_count;
 
+    config.memory_budget_bytes = memory_budget_mb << 20;
+    config.max_length_per_pack = max_length;
+    config.max_volume_per_pack = max_volume;
+
+    if (!capture_file.empty()) {
+        auto capture = std::make_shared<request_capture>(capture_file, capture_rate);
+        if (!capture->is_open()) {
+            std::cerr << "Error: Could not open capture file (or it is an older trace version): " << capture_file << '\n';
+            return 1;
+        }
+        planner.set_capture(std::move(capture));
+    }
+
+    std::shared_ptr<shadow_runner> shadow;
+    if (!shadow_strategy_str.empty()) {
+        shadow = std::make_shared<shadow_runner>(
+            shadow_strategy_str == "pff" ? strategy_type::PARALLEL_FIRST_FIT
+                                         : strategy_type::BLOCKING_FIRST_FIT,
+            shadow_rate, thread_count);
+        planner.set_shadow(shadow);
+    }
+
+    std::shared_ptr<plan_checkpoint> checkpoint;
+    if (!checkpoint_file.empty()) {
+        if (config.type != strategy_type::BLOCKING_FIRST_FIT) {
+            std::cerr << "Error: --checkpoint requires the blocking strategy (bff)\n";
+            return 1;
+        }
+        checkpoint = std::make_shared<plan_checkpoint>(
+            checkpoint_file, resume,
+            std::chrono::milliseconds(static_cast<long long>(checkpoint_interval * 1000.0)));
+        planner.set_checkpoint(checkpoint);
+    }
+
     bool parse_success = false;
 
+    // Compressed manifests (.gz/.zst) are recognised by their magic bytes
+    const bool read_file = !use_stdin && !input_file.empty();
+    const bool compressed_input = read_file ? is_compressed_file(input_file) : compressed_stdin;
+
     // Handle input source
-    if (use_stdin || (input_file.empty() && !run_benchmark)) {
+    if (async_io || compressed_input) {
+        // Read straight from the file descriptor (stdin pipes included)
+        int input_fd = STDIN_FILENO;
+        if (read_file) {
+            input_fd = open(input_file.c_str(), O_RDONLY);
+            if (input_fd < 0) {
+                std::cerr << "Error: Could not open input file: " << input_file << '\n';
+                return 1;
+            }
+        }
+        if (compressed_input) {
+            // Block-parallel decompression feeding the parser directly
+            compressed_input_buffer input_buffer(input_fd, static_cast<unsigned int>(thread_count));
+            std::istream input(&input_buffer);
+            parse_success = parse_input(input, config, items);
+            if (input_buffer.has_error()) {
+                std::cerr << "Error: " << input_buffer.error_message() << '\n';
+                parse_success = false;
+            }
+        } else {
+            // Double-buffered fd stream
+            async_input_buffer input_buffer(input_fd);
+            std::istream input(&input_buffer);
+            parse_success = parse_input(input, config, items) && !input_buffer.has_error();
+        }
+        if (input_fd != STDIN_FILENO) {
+            close(input_fd);
+        }
+    } else if (use_stdin || (input_file.empty() && !run_benchmark)) {
         // Read from standard input
         parse_success = parse_input(std::cin, config, items);
     } else if (!input_file.empty()) {
         // Read from file
         std::ifstream inputFile(input_file);
         if (!inputFile.is_open()) {
-            std::cerr << "Error: Could not open input file: " << input_file << std::endl;
+            std::cerr << "Error: Could not open input file: " << input_file << '\n';
             return 1;
         }
         parse_success = parse_input(inputFile, config, items);
@@ -126,28 +334,84 @@ int main(int argc, char* argv[]) {
     }
 
     if (!parse_success) {
-        std::cerr << "Error: Failed to parse input." << std::endl;
+        std::cerr << "Error: Failed to parse input.\n";
         return 1;
     }
 
     if (items.empty()) {
-        std::cerr << "Error: No items to pack." << std::endl;
+        std::cerr << "Error: No items to pack.\n";
         return 1;
     }
 
     // Plan packs
     pack_planner_result result = planner.plan_packs(config, items);
 
-    // Output results
-    planner.output_results(result.packs);
+    if (checkpoint) {
+        if (checkpoint->has_error()) {
+            std::cerr << "Error: " << checkpoint->error_message() << '\n';
+            return 1;
+        }
+        if (checkpoint->resumed()) {
+            std::cerr << "Resumed from checkpoint at item " << checkpoint->resumed_from() << '\n';
+        }
+    }
+
+    // Output goes through the double-buffered fd stream when requested
+    std::unique_ptr<async_output_buffer> output_buffer;
+    std::ostream output(std::cout.rdbuf());
+    if (async_io) {
+        std::cout.flush();
+        output_buffer = std::make_unique<async_output_buffer>(STDOUT_FILENO);
+        output.rdbuf(output_buffer.get());
+    }
+
+    const output_format format = parse_output_format(format_str);
+    if (format == output_format::TEXT) {
+        // Output results
+        planner.output_results(result, output);
+
+        // Output strategy and timing information
+        output << "\nPacking Summary:\n";
+        output << "Strategy: " << result.strategy_name << '\n';
+        output << "Sorting time: " << result.sorting_time << " ms\n";
+        output << "Packing time: " << result.packing_time << " ms\n";
+        output << "Total time: " << result.total_time << " ms\n";
+        output << "Utilization: " << result.utilization_percent << "%\n";
+
+        // Only when some items were weightless or left out
+        if (!result.diagnostics.clean()) {
+            output_input_diagnostics(result.diagnostics, output);
+        }
+    } else {
+        // Packs and metrics written directly as JSON; the summary is in "metrics"
+        write_plan_json(result, output, format);
+    }
 
-    // Output strategy and timing information
-    std::cout << "\nPacking Summary:" << std::endl;
-    std::cout << "Strategy: " << result.strategy_name << std::endl;
-    std::cout << "Sorting time: " << result.sorting_time << " ms" << std::endl;
-    std::cout << "Packing time: " << result.packing_time << " ms" << std::endl;
-    std::cout << "Total time: " << result.total_time << " ms" << std::endl;
-    std::cout << "Utilization: " << result.utilization_percent << "%" << std::endl;
+    // Reports that are not part of the result go to stderr when stdout carries JSON
+    std::ostream& report_output = format == output_format::TEXT ? output : std::cerr;
+
+    if (shadow) {
+        shadow->wait_idle();
+        output_shadow_metrics(shadow->snapshot(), report_output);
+    }
+
+    bool plan_valid = true;
+    if (validate) {
+        const validation_report report = pack_validator().validate(config, items, result);
+        output_validation_report(report, report_output);
+        plan_valid = report.ok();
+    }
+
+    output.flush();
+    if ((output_buffer && output_buffer->has_error()) || !output) {
+        std::cerr << "Error: Failed to write output.\n";
+        return 1;
+    }
+
+    // The plan has been delivered; a later --resume must not replay it
+    if (checkpoint) {
+        checkpoint->remove();
+    }
 
-    return 0;
+    return plan_valid ? 0 : 1;
 }
@@ -0,0 +1,230 @@
+#include "pack_planner_c.h"
+#include "pack_planner.h"
+#include "plan_columns.h"
+
+#include <algorithm>
+#include <exception>
+#include <new>
+#include <string>
+
+struct pack_planner_handle {
+    pack_planner planner;
+};
+
+struct pack_planner_plan {
+    plan_columns columns;
+    pack_planner_stats stats{};
+    std::string strategy_name;
+};
+
+namespace {
+
+thread_local std::string g_last_error;
+
+pack_planner_status fail(pack_planner_status status, const char* message) {
+    g_last_error = message;
+    return status;
+}
+
+// Map an exception escaping the engine onto a status; nothing may cross the C boundary
+pack_planner_status fail_from_current_exception() {
+    try {
+        throw;
+    } catch (const std::bad_alloc&) {
+        return fail(PACK_PLANNER_OUT_OF_MEMORY, "out of memory");
+    } catch (const std::exception& e) {
+        return fail(PACK_PLANNER_INTERNAL_ERROR, e.what());
+    } catch (...) {
+        return fail(PACK_PLANNER_INTERNAL_ERROR, "unknown error");
+    }
+}
+
+// Reject options from an uninitialised struct, or with fields this library does not know:
+// reserved slots, and any bytes a newer header appended, must be zero
+bool options_understood(const pack_planner_options& options) {
+    if (options.struct_size < sizeof(pack_planner_options)) return false;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&options);
+    const auto* reserved = reinterpret_cast<const unsigned char*>(options.reserved);
+    return std::all_of(reserved, bytes + options.struct_size, [](unsigned char b) { return b == 0; });
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t pack_planner_abi_version(void) {
+    return PACK_PLANNER_ABI_VERSION;
+}
+
+const char* pack_planner_last_error(void) {
+    return g_last_error.c_str();
+}
+
+void pack_planner_options_init(pack_planner_options* options) {
+    if (!options) return;
+    const pack_planner_config defaults;
+    *options = pack_planner_options{};
+    options->struct_size = sizeof(pack_planner_options);
+    options->sort_order = static_cast<int32_t>(defaults.order);
+    options->strategy = static_cast<int32_t>(defaults.type);
+    options->max_items_per_pack = defaults.max_items_per_pack;
+    options->max_weight_per_pack = defaults.max_weight_per_pack;
+    options->thread_count = defaults.thread_count;
+    options->max_length_per_pack = defaults.max_length_per_pack;
+    options->max_volume_per_pack = defaults.max_volume_per_pack;
+}
+
+pack_planner_handle* pack_planner_create(void) {
+    return new (std::nothrow) pack_planner_handle();
+}
+
+void pack_planner_destroy(pack_planner_handle* planner) {
+    delete planner;
+}
+
+pack_planner_status pack_planner_plan_columns(
+    pack_planner_handle* planner, const pack_planner_options* options,
+    const int32_t* ids, const int32_t* lengths, const int32_t* quantities,
+    const double* weights, size_t count, pack_planner_plan** out_plan) {
+    return pack_planner_plan_columns_with_volume(planner, options, ids, lengths, quantities, weights,
+                                                 nullptr, count, out_plan);
+}
+
+pack_planner_status pack_planner_plan_columns_with_volume(
+    pack_planner_handle* planner, const pack_planner_options* options,
+    const int32_t* ids, const int32_t* lengths, const int32_t* quantities,
+    const double* weights, const float* volumes, size_t count, pack_planner_plan** out_plan) {
+    if (!out_plan) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "out_plan is null");
+    }
+    *out_plan = nullptr;
+    if (!planner || !options) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "planner or options is null");
+    }
+    if (!options_understood(*options)) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT,
+                    "options not from pack_planner_options_init, or use fields this library lacks");
+    }
+    if (count > 0 && (!ids || !lengths || !quantities || !weights)) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "item column is null");
+    }
+    if (options->sort_order < 0 || options->sort_order > static_cast<int32_t>(LAST_SORT_ORDER)) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "unknown sort_order");
+    }
+    if (options->strategy < 0 || options->strategy > static_cast<int32_t>(strategy_type::PARALLEL_BEST_FIT)) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "unknown strategy");
+    }
+
+    try {
+        pack_planner_config config;
+        config.order = static_cast<sort_order>(options->sort_order);
+        config.type = static_cast<strategy_type>(options->strategy);
+        config.max_items_per_pack = options->max_items_per_pack;
+        config.max_weight_per_pack = options->max_weight_per_pack;
+        config.thread_count = options->thread_count;
+        config.max_length_per_pack = options->max_length_per_pack;
+        config.max_volume_per_pack = options->max_volume_per_pack;
+
+        std::vector<item> items;
+        items.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            items.emplace_back(ids[i], lengths[i], quantities[i], weights[i], volumes ? volumes[i] : 0.0f);
+        }
+
+        const pack_planner_result result = planner->planner.plan_packs(config, std::move(items));
+
+        auto plan = std::make_unique<pack_planner_plan>();
+        plan->columns.assign(result);
+        plan->stats.sorting_ms = result.sorting_time;
+        plan->stats.packing_ms = result.packing_time;
+        plan->stats.total_ms = result.total_time;
+        plan->stats.total_items = result.total_items;
+        plan->stats.utilization_percent = result.utilization_percent;
+        plan->strategy_name = result.strategy_name;
+
+        *out_plan = plan.release();
+        return PACK_PLANNER_OK;
+    } catch (...) {
+        return fail_from_current_exception();
+    }
+}
+
+void pack_planner_plan_free(pack_planner_plan* plan) {
+    delete plan;
+}
+
+size_t pack_planner_plan_pack_count(const pack_planner_plan* plan) {
+    return plan ? plan->columns.pack_count() : 0;
+}
+
+size_t pack_planner_plan_item_count(const pack_planner_plan* plan) {
+    return plan ? plan->columns.item_count() : 0;
+}
+
+pack_planner_status pack_planner_plan_stats(const pack_planner_plan* plan, pack_planner_stats* out_stats) {
+    if (!plan || !out_stats) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "plan or out_stats is null");
+    }
+    *out_stats = plan->stats;
+    return PACK_PLANNER_OK;
+}
+
+const char* pack_planner_plan_strategy_name(const pack_planner_plan* plan) {
+    return plan ? plan->strategy_name.c_str() : "";
+}
+
+pack_planner_status pack_planner_plan_pack(const pack_planner_plan* plan, size_t index,
+                                           pack_planner_pack_info* out_pack) {
+    if (!plan || !out_pack) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "plan or out_pack is null");
+    }
+    const plan_columns& columns = plan->columns;
+    if (index >= columns.pack_count()) {
+        return fail(PACK_PLANNER_OUT_OF_RANGE, "pack index out of range");
+    }
+    out_pack->pack_number = columns.pack_numbers[index];
+    out_pack->pack_length = columns.pack_lengths[index];
+    out_pack->total_weight = columns.pack_weights[index];
+    out_pack->first_item = columns.pack_offsets[index];
+    out_pack->item_count = columns.pack_offsets[index + 1] - columns.pack_offsets[index];
+    return PACK_PLANNER_OK;
+}
+
+pack_planner_status pack_planner_plan_item(const pack_planner_plan* plan, size_t index,
+                                           pack_planner_item_line* out_item) {
+    if (!plan || !out_item) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "plan or out_item is null");
+    }
+    const plan_columns& columns = plan->columns;
+    if (index >= columns.item_count()) {
+        return fail(PACK_PLANNER_OUT_OF_RANGE, "item index out of range");
+    }
+    out_item->id = columns.item_ids[index];
+    out_item->length = columns.item_lengths[index];
+    out_item->quantity = columns.item_quantities[index];
+    out_item->weight = columns.item_weights[index];
+    out_item->volume = columns.item_volumes[index];
+    return PACK_PLANNER_OK;
+}
+
+pack_planner_status pack_planner_plan_get_columns(const pack_planner_plan* plan,
+                                                  pack_planner_columns* out_columns) {
+    if (!plan || !out_columns) {
+        return fail(PACK_PLANNER_INVALID_ARGUMENT, "plan or out_columns is null");
+    }
+    const plan_columns& columns = plan->columns;
+    out_columns->pack_count = columns.pack_count();
+    out_columns->item_count = columns.item_count();
+    out_columns->pack_offsets = columns.pack_offsets.data();
+    out_columns->pack_numbers = columns.pack_numbers.data();
+    out_columns->pack_lengths = columns.pack_lengths.data();
+    out_columns->pack_weights = columns.pack_weights.data();
+    out_columns->item_ids = columns.item_ids.data();
+    out_columns->item_lengths = columns.item_lengths.data();
+    out_columns->item_quantities = columns.item_quantities.data();
+    out_columns->item_weights = columns.item_weights.data();
+    out_columns->item_volumes = columns.item_volumes.data();
+    return PACK_PLANNER_OK;
+}
+
+} // extern "C"
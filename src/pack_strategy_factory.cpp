@@ -4,14 +4,15 @@
 
 std::unique_ptr<pack_strategy> pack_strategy_factory::create_strategy(
     strategy_type type,
-    int thread_count) {
+    int thread_count,
+    std::shared_ptr<thread_pool> pool) {
 
     switch (type) {
         case strategy_type::BLOCKING_FIRST_FIT:
             return std::make_unique<blocking_pack_strategy>();
 
         case strategy_type::PARALLEL_FIRST_FIT:
-            return std::make_unique<parallel_pack_strategy>(thread_count);
+            return std::make_unique<parallel_pack_strategy>(thread_count, std::move(pool));
 
         default:
             return std::make_unique<blocking_pack_strategy>();
@@ -0,0 +1,254 @@
+#include "pack_validator.h"
+#include "pack_planner.h"
+#include "item_sort.h"
+#include "plan_columns.h"
+#include "thread_pool.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+// Packs per parallel task; large enough that scheduling cost stays negligible
+constexpr std::size_t PACKS_PER_TASK = 2048;
+
+// Relative slack for floating-point weight sums
+constexpr double WEIGHT_TOLERANCE = 1e-9;
+
+/**
+ * @brief Violations found by one task, the first few in detail
+ */
+struct issue_sink {
+    std::size_t limit;
+    std::size_t count = 0;
+    std::vector<validation_issue> issues;
+
+    template <typename Describe>
+    void add(validation_issue::kind type, int pack_number, int item_id, Describe&& describe) {
+        if (count++ >= limit) return;
+        std::ostringstream message;
+        describe(message);
+        issues.push_back(validation_issue{type, pack_number, item_id, message.str()});
+    }
+};
+
+bool is_out_of_order(sort_order order, std::int32_t previous_length, double previous_weight,
+                     std::int32_t length, double weight) noexcept {
+    return item_sort::precedes(order, length, weight, previous_length, previous_weight);
+}
+
+void check_packs(const plan_columns& columns, std::size_t first, std::size_t last,
+                 const pack_limits& limits, sort_order order, issue_sink& sink) {
+    const int max_items = limits.max_items;
+    const double max_weight = limits.max_weight;
+    const std::uint32_t* offsets = columns.pack_offsets.data();
+    const std::int32_t* lengths = columns.item_lengths.data();
+    const std::int32_t* quantities = columns.item_quantities.data();
+    const double* weights = columns.item_weights.data();
+    const float* volumes = columns.item_volumes.data();
+    const double weight_slack = WEIGHT_TOLERANCE * std::max(1.0, max_weight);
+    const double volume_slack = WEIGHT_TOLERANCE * std::max(1.0, limits.max_volume);
+
+    for (std::size_t p = first; p < last; ++p) {
+        const std::size_t begin = offsets[p];
+        const std::size_t end = offsets[p + 1];
+        const int pack_number = columns.pack_numbers[p];
+
+        // Plain reductions over the line columns; no branches, so they vectorize
+        long long units = 0;
+        double weight = 0.0;
+        double volume = 0.0;
+        std::int32_t longest = 0;
+        for (std::size_t j = begin; j < end; ++j) {
+            units += quantities[j];
+            weight += quantities[j] * weights[j];
+            volume += quantities[j] * static_cast<double>(volumes[j]);
+            longest = std::max(longest, lengths[j]);
+        }
+
+        if (units > max_items) {
+            sink.add(validation_issue::kind::ITEM_LIMIT, pack_number, 0, [&](std::ostream& out) {
+                out << "pack " << pack_number << " holds " << units << " units (max " << max_items << ")";
+            });
+        }
+        if (weight > max_weight + weight_slack) {
+            sink.add(validation_issue::kind::WEIGHT_LIMIT, pack_number, 0, [&](std::ostream& out) {
+                out << "pack " << pack_number << " weighs " << weight << " (max " << max_weight << ")";
+            });
+        }
+        if (limits.max_length > 0 && longest > limits.max_length) {
+            sink.add(validation_issue::kind::LENGTH_LIMIT, pack_number, 0, [&](std::ostream& out) {
+                out << "pack " << pack_number << " holds length " << longest
+                    << " (max " << limits.max_length << ")";
+            });
+        }
+        if (limits.max_volume > 0.0 && volume > limits.max_volume + volume_slack) {
+            sink.add(validation_issue::kind::VOLUME_LIMIT, pack_number, 0, [&](std::ostream& out) {
+                out << "pack " << pack_number << " holds volume " << volume
+                    << " (max " << limits.max_volume << ")";
+            });
+        }
+        const double recorded = columns.pack_weights[p];
+        if (longest != columns.pack_lengths[p] ||
+            std::abs(recorded - weight) > 1e-6 * std::max(1.0, std::abs(weight))) {
+            sink.add(validation_issue::kind::PACK_TOTALS, pack_number, 0, [&](std::ostream& out) {
+                out << "pack " << pack_number << " records length " << columns.pack_lengths[p]
+                    << " and weight " << recorded << ", its lines give " << longest << " and " << weight;
+            });
+        }
+
+        if (order == sort_order::NATURAL) continue;
+
+        // Count first, locate only on failure: the common path is a branch-free loop
+        std::size_t out_of_order = 0;
+        for (std::size_t j = std::max<std::size_t>(begin, 1); j < end; ++j) {
+            out_of_order += is_out_of_order(order, lengths[j - 1], weights[j - 1], lengths[j], weights[j]);
+        }
+        if (out_of_order == 0) continue;
+        for (std::size_t j = std::max<std::size_t>(begin, 1); j < end; ++j) {
+            if (is_out_of_order(order, lengths[j - 1], weights[j - 1], lengths[j], weights[j])) {
+                sink.add(validation_issue::kind::SORT_ORDER, pack_number, columns.item_ids[j],
+                         [&](std::ostream& out) {
+                    out << "item " << columns.item_ids[j] << " (length " << lengths[j] << ", weight "
+                        << weights[j] << ") in pack " << pack_number << " follows length "
+                        << lengths[j - 1] << ", weight " << weights[j - 1] << " against "
+                        << sort_order_to_string(order);
+                });
+            }
+        }
+    }
+}
+
+void check_quantities(const plan_columns& columns, const std::vector<item>& items,
+                      const pack_limits& limits, issue_sink& sink, std::size_t& unpackable) {
+    // +requested for each input line, -packed for each pack line; every id must net to zero
+    std::vector<std::pair<int, long long>> balance;
+    balance.reserve(items.size() + columns.item_count());
+    for (const auto& i : items) {
+        if (i.get_quantity() <= 0) continue;  // the planner skips these
+        const unit_offer unit{std::max(1, i.get_length()), 1, std::max(0.0, i.get_weight()),
+                              std::max(0.0, i.get_volume())};
+        if (!extended_constraints::admits(unit, limits)) {
+            // Not even one unit fits: expected to be left out entirely
+            ++unpackable;
+            balance.emplace_back(i.get_id(), 0);
+            continue;
+        }
+        balance.emplace_back(i.get_id(), i.get_quantity());
+    }
+    for (std::size_t j = 0; j < columns.item_count(); ++j) {
+        balance.emplace_back(columns.item_ids[j], -static_cast<long long>(columns.item_quantities[j]));
+    }
+
+    std::sort(balance.begin(), balance.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (std::size_t k = 0; k < balance.size();) {
+        const int id = balance[k].first;
+        long long net = 0;
+        for (; k < balance.size() && balance[k].first == id; ++k) {
+            net += balance[k].second;
+        }
+        if (net != 0) {
+            sink.add(validation_issue::kind::QUANTITY_MISMATCH, 0, id, [&](std::ostream& out) {
+                out << "item " << id << ": " << (net > 0 ? "missing " : "extra ")
+                    << std::llabs(net) << " units";
+            });
+        }
+    }
+}
+
+const char* issue_kind_name(validation_issue::kind type) noexcept {
+    switch (type) {
+        case validation_issue::kind::ITEM_LIMIT: return "ITEM_LIMIT";
+        case validation_issue::kind::WEIGHT_LIMIT: return "WEIGHT_LIMIT";
+        case validation_issue::kind::LENGTH_LIMIT: return "LENGTH_LIMIT";
+        case validation_issue::kind::VOLUME_LIMIT: return "VOLUME_LIMIT";
+        case validation_issue::kind::PACK_TOTALS: return "PACK_TOTALS";
+        case validation_issue::kind::QUANTITY_MISMATCH: return "QUANTITY_MISMATCH";
+        case validation_issue::kind::SORT_ORDER: return "SORT_ORDER";
+    }
+    return "UNKNOWN";
+}
+
+} // namespace
+
+validation_report pack_validator::validate(const pack_planner_config& config,
+                                           const std::vector<item>& items,
+                                           const pack_planner_result& result) const {
+    plan_columns columns;
+    columns.assign(result);
+    return validate(config, items, columns);
+}
+
+validation_report pack_validator::validate(const pack_planner_config& config,
+                                           const std::vector<item>& items,
+                                           const plan_columns& columns) const {
+    timer validate_timer;
+    validate_timer.start();
+
+    // Same sanitisation as pack_planner::plan_packs
+    const pack_limits limits = config.limits();
+
+    const std::size_t pack_count = columns.pack_count();
+    const std::size_t chunk_count = (pack_count + PACKS_PER_TASK - 1) / PACKS_PER_TASK;
+
+    // One sink per task, plus the last task reconciling quantities
+    std::vector<issue_sink> sinks(chunk_count + 1, issue_sink{m_max_reported_issues});
+    std::size_t unpackable = 0;
+
+    auto run_task = [&](std::size_t task) {
+        if (task == chunk_count) {
+            check_quantities(columns, items, limits, sinks[task], unpackable);
+            return;
+        }
+        const std::size_t first = task * PACKS_PER_TASK;
+        check_packs(columns, first, std::min(pack_count, first + PACKS_PER_TASK),
+                    limits, config.order, sinks[task]);
+    };
+    if (chunk_count <= 1) {
+        // Small plans: handing off to the pool would cost more than the checks
+        for (std::size_t task = 0; task <= chunk_count; ++task) run_task(task);
+    } else {
+        thread_pool::shared().run_batch(chunk_count + 1, run_task);
+    }
+
+    validation_report report;
+    report.packs_checked = pack_count;
+    report.lines_checked = columns.item_count();
+    report.unpackable_items = unpackable;
+    for (auto& sink : sinks) {
+        report.issue_count += sink.count;
+        for (auto& issue : sink.issues) {
+            if (report.issues.size() >= m_max_reported_issues) break;
+            report.issues.push_back(std::move(issue));
+        }
+    }
+    report.elapsed_ms = validate_timer.stop();
+    return report;
+}
+
+void output_validation_report(const validation_report& report, std::ostream& output) {
+    output << "\nValidation: " << (report.ok() ? "PASSED" : "FAILED") << '\n';
+    output << "Packs checked: " << report.packs_checked << ", Lines checked: " << report.lines_checked
+           << '\n';
+    if (report.unpackable_items > 0) {
+        output << "Unpackable items (one unit exceeds a pack limit): " << report.unpackable_items << '\n';
+    }
+    output << "Validation time: " << std::fixed << std::setprecision(3) << report.elapsed_ms << " ms"
+           << '\n';
+    output << std::defaultfloat;
+    if (report.ok()) return;
+
+    output << "Violations: " << report.issue_count << '\n';
+    for (const auto& issue : report.issues) {
+        output << "  [" << issue_kind_name(issue.type) << "] " << issue.message << '\n';
+    }
+    if (report.issue_count > report.issues.size()) {
+        output << "  ... " << report.issue_count - report.issues.size() << " more\n";
+    }
+}
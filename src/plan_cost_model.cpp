@@ -0,0 +1,134 @@
+#include "plan_cost_model.h"
+#include "pack_planner.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+void plan_cost_model::add_sample(strategy_type type, std::size_t item_count, double ms) {
+    m_samples[static_cast<std::size_t>(type)].push_back(sample{static_cast<double>(item_count), ms});
+}
+
+void plan_cost_model::fit() {
+    for (std::size_t s = 0; s < STRATEGY_COUNT; ++s) {
+        const auto& samples = m_samples[s];
+        if (samples.empty()) {
+            m_costs[s].reset();
+            continue;
+        }
+
+        double sum_x = 0.0, sum_y = 0.0;
+        for (const auto& point : samples) {
+            sum_x += point.items;
+            sum_y += point.ms;
+        }
+        const double n = static_cast<double>(samples.size());
+        const double mean_x = sum_x / n;
+        const double mean_y = sum_y / n;
+
+        double sxx = 0.0, sxy = 0.0;
+        for (const auto& point : samples) {
+            sxx += (point.items - mean_x) * (point.items - mean_x);
+            sxy += (point.items - mean_x) * (point.ms - mean_y);
+        }
+
+        plan_cost cost;
+        cost.samples = samples.size();
+        if (sxx > 0.0 && sxy >= 0.0) {
+            cost.ms_per_item = sxy / sxx;
+            cost.fixed_ms = mean_y - cost.ms_per_item * mean_x;
+            if (cost.fixed_ms < 0.0) {
+                // Refit through the origin rather than predict negative latency for small requests
+                cost.fixed_ms = 0.0;
+                cost.ms_per_item = sum_x > 0.0 ? sum_y / sum_x : 0.0;
+            }
+        } else {
+            // One distinct size (or noise that slopes downwards): rate through the origin
+            cost.ms_per_item = sum_x > 0.0 ? sum_y / sum_x : 0.0;
+            cost.fixed_ms = sum_x > 0.0 ? 0.0 : mean_y;
+        }
+        cost.ms_per_item = std::max(0.0, cost.ms_per_item);
+        cost.fixed_ms = std::max(0.0, cost.fixed_ms);
+        m_costs[s] = cost;
+    }
+}
+
+void plan_cost_model::calibrate(const std::vector<strategy_type>& strategies,
+                                const std::vector<std::size_t>& sizes,
+                                int repetitions, int thread_count) {
+    const std::size_t largest = sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end());
+    const std::vector<item> workload = calibration_items(largest);
+
+    pack_planner planner;
+    pack_planner_config config;
+    config.thread_count = thread_count;
+
+    for (const auto type : strategies) {
+        m_samples[static_cast<std::size_t>(type)].clear();
+        config.type = type;
+
+        for (const auto size : sizes) {
+            const std::vector<item> items(workload.begin(), workload.begin() + size);
+            double best = std::numeric_limits<double>::max();
+            // Keep the fastest run: slower ones measure interference, not the planner
+            for (int run = 0; run < std::max(1, repetitions); ++run) {
+                best = std::min(best, planner.plan_packs(config, items).total_time);
+            }
+            add_sample(type, size, best);
+        }
+    }
+    fit();
+}
+
+const plan_cost* plan_cost_model::cost(strategy_type type) const noexcept {
+    const auto& fitted = m_costs[static_cast<std::size_t>(type)];
+    return fitted ? &*fitted : nullptr;
+}
+
+std::optional<double> plan_cost_model::predict_ms(strategy_type type, std::size_t item_count) const noexcept {
+    const plan_cost* fitted = cost(type);
+    if (!fitted) return std::nullopt;
+    return fitted->predict_ms(item_count);
+}
+
+std::optional<strategy_type> plan_cost_model::fastest(std::size_t item_count) const noexcept {
+    std::optional<strategy_type> best;
+    double best_ms = std::numeric_limits<double>::max();
+    for (const auto type : default_strategies()) {
+        const auto predicted = predict_ms(type, item_count);
+        if (predicted && *predicted < best_ms) {
+            best_ms = *predicted;
+            best = type;
+        }
+    }
+    return best;
+}
+
+void plan_cost_model::clear() noexcept {
+    for (auto& samples : m_samples) samples.clear();
+    for (auto& fitted : m_costs) fitted.reset();
+}
+
+std::vector<item> plan_cost_model::calibration_items(std::size_t count, std::uint32_t seed) {
+    // Same mix as the benchmark: 70% light items, 30% heavy ones that always split
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> length_dist(500, 10000);
+    std::uniform_int_distribution<> quantity_dist(10, 100);
+    std::uniform_real_distribution<> lightweight_dist(0.5, 6.0);
+    std::uniform_real_distribution<> heavyweight_dist(6.1, 30.0);
+
+    std::vector<item> items;
+    items.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const int length = length_dist(gen);
+        const int quantity = quantity_dist(gen);
+        const double weight = i % 10 < 7 ? lightweight_dist(gen) : heavyweight_dist(gen);
+        items.emplace_back(static_cast<int>(1000 + i), length, quantity, weight);
+    }
+    return items;
+}
+
+std::vector<strategy_type> plan_cost_model::default_strategies() {
+    return {strategy_type::BLOCKING_FIRST_FIT, strategy_type::PARALLEL_FIRST_FIT,
+            strategy_type::BLOCKING_BEST_FIT, strategy_type::PARALLEL_BEST_FIT};
+}
@@ -0,0 +1,316 @@
+// Python extension module `pack_planner` (built with -DPACK_PLANNER_PYTHON=ON)
+//
+// Item columns are read in place through the buffer protocol (NumPy arrays,
+// array.array, memoryviews), and result columns are returned as buffers over
+// memory owned by the module, wrapped by numpy.asarray when NumPy is
+// installed. Planning runs with the GIL released.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pack_planner.h"
+
+namespace {
+
+/**
+ * @brief Result columns shared by the buffer objects that expose them
+ */
+struct plan_output {
+    std::vector<std::int32_t> pack_index;   // per line: 0-based pack position
+    std::vector<std::int32_t> item_index;   // per line: row in the input columns
+    std::vector<std::int32_t> item_id;      // per line: ids[item_index]
+    std::vector<std::int32_t> quantity;     // per line
+    std::vector<std::int32_t> pack_lengths; // per pack
+    std::vector<double> pack_weights;       // per pack
+};
+
+// Read-only 1-D buffer over one column of a plan_output; keeps the output alive
+struct column_object {
+    PyObject_HEAD
+    std::shared_ptr<plan_output>* owner;
+    const void* data;
+    Py_ssize_t length;
+    Py_ssize_t itemsize;
+    const char* format;
+};
+
+int column_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+    auto* column = reinterpret_cast<column_object*>(self);
+    // SAFETY: The vectors are never resized after the plan is built, so the pointer stays valid
+    if (PyBuffer_FillInfo(view, self, const_cast<void*>(column->data),
+                          column->length * column->itemsize, 1, flags) < 0) {
+        return -1;
+    }
+    view->itemsize = column->itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(column->format) : nullptr;
+    view->shape = (flags & PyBUF_ND) ? &column->length : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &column->itemsize : nullptr;
+    return 0;
+}
+
+void column_dealloc(PyObject* self) {
+    delete reinterpret_cast<column_object*>(self)->owner;
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyBufferProcs column_buffer_procs = {column_getbuffer, nullptr};
+
+PyTypeObject column_type = [] {
+    PyTypeObject type{PyVarObject_HEAD_INIT(nullptr, 0)};
+    type.tp_name = "pack_planner.Column";
+    type.tp_basicsize = sizeof(column_object);
+    type.tp_dealloc = column_dealloc;
+    type.tp_as_buffer = &column_buffer_procs;
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    type.tp_doc = "Read-only result column (supports the buffer protocol)";
+    return type;
+}();
+
+template <typename T>
+PyObject* make_column(const std::shared_ptr<plan_output>& output, const std::vector<T>& values,
+                      const char* format, PyObject* numpy) {
+    auto* column = PyObject_New(column_object, &column_type);
+    if (!column) return nullptr;
+    column->owner = new std::shared_ptr<plan_output>(output);
+    column->data = values.data();
+    column->length = static_cast<Py_ssize_t>(values.size());
+    column->itemsize = sizeof(T);
+    column->format = format;
+
+    PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(column));
+    Py_DECREF(column);
+    if (!view || !numpy) return view;
+
+    // numpy.asarray over the memoryview shares the memory (no copy)
+    PyObject* array = PyObject_CallMethod(numpy, "asarray", "O", view);
+    Py_DECREF(view);
+    return array;
+}
+
+/**
+ * @brief One item column borrowed from a Python buffer
+ */
+class input_column {
+public:
+    ~input_column() {
+        if (m_acquired) PyBuffer_Release(&m_view);
+    }
+
+    /**
+     * @brief Acquire a C-contiguous 1-D buffer of integers or floats
+     * @param object Buffer exporter (e.g. a NumPy array)
+     * @param name Column name for error messages
+     * @param floating True for the weight column
+     * @return bool False with a Python exception set on failure
+     */
+    bool acquire(PyObject* object, const char* name, bool floating) {
+        m_name = name;
+        if (PyObject_GetBuffer(object, &m_view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+            return false;
+        }
+        m_acquired = true;
+        if (m_view.ndim != 1) {
+            PyErr_Format(PyExc_ValueError, "%s must be one-dimensional", name);
+            return false;
+        }
+
+        // Skip byte-order/alignment prefixes such as '<' or '='
+        const char* format = m_view.format ? m_view.format : "B";
+        while (*format == '<' || *format == '=' || *format == '@') ++format;
+        const char code = format[0];
+        if (format[0] == '\0' || format[1] != '\0') code_error(format);
+        else if (floating && code == 'd') m_kind = kind::f64;
+        else if (floating && code == 'f') m_kind = kind::f32;
+        else if (std::strchr("ilq", code) && m_view.itemsize == 4) m_kind = kind::i32;
+        else if (std::strchr("ilq", code) && m_view.itemsize == 8) m_kind = kind::i64;
+        else code_error(format);
+        return m_kind != kind::none;
+    }
+
+    [[nodiscard]] Py_ssize_t size() const noexcept { return m_view.len / m_view.itemsize; }
+
+    /**
+     * @brief Check that a 64-bit integer column fits the int fields of an item
+     * @return bool False with OverflowError set if a value is out of range
+     */
+    bool check_int_range() const {
+        if (m_kind != kind::i64) return true;
+        const auto* values = static_cast<const std::int64_t*>(m_view.buf);
+        for (Py_ssize_t i = 0, n = size(); i < n; ++i) {
+            if (values[i] < std::numeric_limits<int>::min() || values[i] > std::numeric_limits<int>::max()) {
+                PyErr_Format(PyExc_OverflowError, "%s[%zd] = %lld does not fit a 32-bit integer",
+                             m_name, i, static_cast<long long>(values[i]));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Called with the GIL released: reads the exporter's memory directly
+    [[nodiscard]] double real(Py_ssize_t i) const noexcept {
+        switch (m_kind) {
+            case kind::f64: return static_cast<const double*>(m_view.buf)[i];
+            case kind::f32: return static_cast<const float*>(m_view.buf)[i];
+            case kind::i64: return static_cast<double>(static_cast<const std::int64_t*>(m_view.buf)[i]);
+            default: return static_cast<double>(integer(i));
+        }
+    }
+
+    // 64-bit values are range-checked by check_int_range() before planning
+    [[nodiscard]] int integer(Py_ssize_t i) const noexcept {
+        if (m_kind == kind::i64) return static_cast<int>(static_cast<const std::int64_t*>(m_view.buf)[i]);
+        return static_cast<const std::int32_t*>(m_view.buf)[i];
+    }
+
+private:
+    enum class kind { none, i32, i64, f32, f64 };
+
+    void code_error(const char* format) {
+        PyErr_Format(PyExc_TypeError, "%s has unsupported element type '%s'", m_name, format);
+        m_kind = kind::none;
+    }
+
+    Py_buffer m_view{};
+    bool m_acquired = false;
+    kind m_kind = kind::none;
+    const char* m_name = "";
+};
+
+PyObject* plan(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"ids", "lengths", "quantities", "weights", "max_items",
+                                     "max_weight", "sort_order", "strategy", "threads",
+                                     "max_length", "max_volume", "volumes", nullptr};
+    PyObject *ids_obj, *lengths_obj, *quantities_obj, *weights_obj;
+    PyObject* volumes_obj = Py_None;
+    pack_planner_config config;
+    int order = static_cast<int>(config.order);
+    int strategy = static_cast<int>(config.type);
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOOO|idiiiidO", const_cast<char**>(keywords),
+                                     &ids_obj, &lengths_obj, &quantities_obj, &weights_obj,
+                                     &config.max_items_per_pack, &config.max_weight_per_pack,
+                                     &order, &strategy, &config.thread_count,
+                                     &config.max_length_per_pack, &config.max_volume_per_pack, &volumes_obj)) {
+        return nullptr;
+    }
+    if (order < 0 || order > static_cast<int>(LAST_SORT_ORDER)) {
+        PyErr_SetString(PyExc_ValueError, "unknown sort_order");
+        return nullptr;
+    }
+    if (strategy < 0 || strategy > static_cast<int>(strategy_type::PARALLEL_BEST_FIT)) {
+        PyErr_SetString(PyExc_ValueError, "unknown strategy");
+        return nullptr;
+    }
+    config.order = static_cast<sort_order>(order);
+    config.type = static_cast<strategy_type>(strategy);
+
+    input_column ids, lengths, quantities, weights, volumes;
+    const bool has_volumes = volumes_obj != Py_None;
+    if (!ids.acquire(ids_obj, "ids", false) || !lengths.acquire(lengths_obj, "lengths", false) ||
+        !quantities.acquire(quantities_obj, "quantities", false) ||
+        !weights.acquire(weights_obj, "weights", true) ||
+        (has_volumes && !volumes.acquire(volumes_obj, "volumes", true))) {
+        return nullptr;
+    }
+    const Py_ssize_t count = ids.size();
+    if (lengths.size() != count || quantities.size() != count || weights.size() != count ||
+        (has_volumes && volumes.size() != count)) {
+        PyErr_SetString(PyExc_ValueError, "ids, lengths, quantities, weights and volumes must have the same length");
+        return nullptr;
+    }
+    // Rows are carried in the int item id; ids, lengths and quantities are ints too
+    if (count > std::numeric_limits<int>::max()) {
+        PyErr_Format(PyExc_OverflowError, "%zd rows exceed the limit of %d", count, std::numeric_limits<int>::max());
+        return nullptr;
+    }
+    if (!ids.check_int_range() || !lengths.check_int_range() || !quantities.check_int_range()) {
+        return nullptr;
+    }
+
+    auto output = std::make_shared<plan_output>();
+    pack_planner_result result;
+    std::string error;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        // The item id carries the input row so lines map back to the caller's columns
+        std::vector<item> items;
+        items.reserve(static_cast<std::size_t>(count));
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            items.emplace_back(static_cast<int>(i), lengths.integer(i), quantities.integer(i), weights.real(i),
+                               has_volumes ? static_cast<float>(volumes.real(i)) : 0.0f);
+        }
+
+        pack_planner planner;
+        result = planner.plan_packs(config, std::move(items));
+
+        std::int32_t position = 0;
+        auto append = [&](const pack& p) {
+            if (p.is_empty()) return;
+            for (const auto& line : p.get_items()) {
+                output->pack_index.push_back(position);
+                output->item_index.push_back(line.get_id());
+                output->item_id.push_back(ids.integer(line.get_id()));
+                output->quantity.push_back(line.get_quantity());
+            }
+            output->pack_lengths.push_back(p.get_pack_length());
+            output->pack_weights.push_back(p.get_total_weight());
+            ++position;
+        };
+        if (result.spill) result.spill->for_each(append);
+        for (const auto& p : result.packs) append(p);
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    if (!error.empty()) {
+        PyErr_SetString(PyExc_RuntimeError, error.c_str());
+        return nullptr;
+    }
+
+    PyObject* numpy = PyImport_ImportModule("numpy");
+    if (!numpy) PyErr_Clear();  // Without NumPy the columns are returned as memoryviews
+
+    PyObject* planned = Py_BuildValue(
+        "{s:N,s:N,s:N,s:N,s:N,s:N,s:d,s:d,s:d,s:i,s:d,s:s}",
+        "pack_index", make_column(output, output->pack_index, "i", numpy),
+        "item_index", make_column(output, output->item_index, "i", numpy),
+        "item_id", make_column(output, output->item_id, "i", numpy),
+        "quantity", make_column(output, output->quantity, "i", numpy),
+        "pack_lengths", make_column(output, output->pack_lengths, "i", numpy),
+        "pack_weights", make_column(output, output->pack_weights, "d", numpy),
+        "sorting_time", result.sorting_time,
+        "packing_time", result.packing_time,
+        "total_time", result.total_time,
+        "total_items", result.total_items,
+        "utilization_percent", result.utilization_percent,
+        "strategy_name", result.strategy_name.c_str());
+    Py_XDECREF(numpy);
+    return planned;
+}
+
+PyMethodDef methods[] = {
+    {"plan", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(plan)), METH_VARARGS | METH_KEYWORDS,
+     "plan(ids, lengths, quantities, weights, max_items=100, max_weight=200.0, sort_order=0, strategy=0, threads=4,\n"
+     "     max_length=0, max_volume=0.0, volumes=None)\n\n"
+     "Plan packs for items given as equally long 1-D columns (int32/int64 integers,\n"
+     "float32/float64 or integer weights and volumes). max_length and max_volume\n"
+     "limit each pack's longest item and combined volume (0 = unlimited). Returns a dict of per-line columns (pack_index,\n"
+     "item_index into the input, item_id, quantity), per-pack columns (pack_lengths,\n"
+     "pack_weights) and planning statistics."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyModuleDef module = {PyModuleDef_HEAD_INIT, "pack_planner", "Native pack planner", -1, methods};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_pack_planner(void) {
+    if (PyType_Ready(&column_type) < 0) return nullptr;
+    return PyModule_Create(&module);
+}
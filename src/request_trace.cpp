@@ -0,0 +1,437 @@
+#include "request_trace.h"
+#include "pack_planner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <thread>
+
+namespace {
+
+constexpr char TRACE_MAGIC[8] = {'P', 'P', 'T', 'R', 'A', 'C', 'E', '2'};
+// Version 1 traces have no length or volume limits and no item volume; still readable
+constexpr char TRACE_MAGIC_V1[8] = {'P', 'P', 'T', 'R', 'A', 'C', 'E', '1'};
+
+// Upper bound on items per record; larger requests are not captured, and larger
+// counts in a trace are treated as corruption
+constexpr std::uint32_t MAX_TRACE_ITEMS = 1u << 30;
+
+#pragma pack(push, 1)
+struct record_header_v1 {
+    std::uint64_t timestamp_us;
+    std::uint8_t order;
+    std::uint8_t type;
+    std::uint16_t reserved;
+    std::int32_t thread_count;
+    std::int32_t max_items;
+    double max_weight;
+    std::uint64_t memory_budget;
+    double sorting_ms;
+    double packing_ms;
+    double total_ms;
+    std::uint32_t item_count;
+};
+
+struct item_record_v1 {
+    std::int32_t id;
+    std::int32_t length;
+    std::int32_t quantity;
+    double weight;
+};
+
+struct record_header {
+    std::uint64_t timestamp_us;
+    std::uint8_t order;
+    std::uint8_t type;
+    std::uint16_t reserved;
+    std::int32_t thread_count;
+    std::int32_t max_items;
+    double max_weight;
+    std::uint64_t memory_budget;
+    double sorting_ms;
+    double packing_ms;
+    double total_ms;
+    std::int32_t max_length;
+    double max_volume;
+    std::uint32_t item_count;
+};
+
+struct item_record {
+    std::int32_t id;
+    std::int32_t length;
+    std::int32_t quantity;
+    double weight;
+    float volume;
+};
+#pragma pack(pop)
+
+[[nodiscard]] std::uint64_t now_us() noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// request_capture
+// ---------------------------------------------------------------------------
+
+request_capture::request_capture(const std::string& path, double sample_rate, std::uint32_t seed,
+                                 std::size_t max_queue)
+    : m_sample_rate(std::clamp(sample_rate, 0.0, 1.0)),
+      m_max_queue(std::max<std::size_t>(1, max_queue)),
+      m_rng(seed != 0 ? seed : std::random_device{}()) {
+    // Read access only to check the format of an existing trace; writes always append
+    m_file = std::fopen(path.c_str(), "a+b");
+    if (!m_file) return;
+
+    if (std::fseek(m_file, 0, SEEK_END) == 0 && std::ftell(m_file) == 0) {
+        // New (empty) trace: write the header
+        m_error = std::fwrite(TRACE_MAGIC, sizeof(TRACE_MAGIC), 1, m_file) != 1 || std::fflush(m_file) != 0;
+    } else {
+        // Only append to a trace of the current version (a version 1 trace needs a new file)
+        char magic[sizeof(TRACE_MAGIC)];
+        m_error = std::fseek(m_file, 0, SEEK_SET) != 0 || std::fread(magic, sizeof(magic), 1, m_file) != 1 ||
+                  std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0 || std::fseek(m_file, 0, SEEK_END) != 0;
+    }
+    m_writer = std::thread(&request_capture::run, this);
+}
+
+request_capture::~request_capture() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_work_ready.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    if (m_file) std::fclose(m_file);
+}
+
+bool request_capture::should_sample() {
+    if (m_sample_rate >= 1.0) return true;
+    if (m_sample_rate <= 0.0) return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::uniform_real_distribution<double>(0.0, 1.0)(m_rng) < m_sample_rate;
+}
+
+bool request_capture::record(const pack_planner_config& config, std::vector<item> items,
+                             const pack_planner_result& result) {
+    if (items.size() > MAX_TRACE_ITEMS) {
+        // The format cannot hold the whole request; skip it rather than record part of it
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_dropped;
+        return false;
+    }
+
+    trace_record next;
+    next.timestamp_us = now_us();
+    next.order = config.order;
+    next.type = config.type;
+    next.thread_count = config.thread_count;
+    next.max_items_per_pack = config.max_items_per_pack;
+    next.max_weight_per_pack = config.max_weight_per_pack;
+    next.max_length_per_pack = config.max_length_per_pack;
+    next.max_volume_per_pack = config.max_volume_per_pack;
+    next.memory_budget_bytes = config.memory_budget_bytes;
+    next.sorting_time = result.sorting_time;
+    next.packing_time = result.packing_time;
+    next.total_time = result.total_time;
+    next.items = std::move(items);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!is_open() || m_stop || m_queue.size() >= m_max_queue) {
+            // Never make the request wait for the trace
+            ++m_dropped;
+            return false;
+        }
+        m_queue.push_back(std::move(next));
+    }
+    m_work_ready.notify_one();
+    return true;
+}
+
+void request_capture::wait_idle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+std::size_t request_capture::captured() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_captured;
+}
+
+std::size_t request_capture::dropped() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+void request_capture::run() {
+    std::vector<char> encoded;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_work_ready.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) break;  // stopping and drained
+
+        trace_record next = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_busy = true;
+        lock.unlock();
+
+        record_header header{};
+        header.timestamp_us = next.timestamp_us;
+        header.order = static_cast<std::uint8_t>(next.order);
+        header.type = static_cast<std::uint8_t>(next.type);
+        header.thread_count = next.thread_count;
+        header.max_items = next.max_items_per_pack;
+        header.max_weight = next.max_weight_per_pack;
+        header.memory_budget = next.memory_budget_bytes;
+        header.sorting_ms = next.sorting_time;
+        header.packing_ms = next.packing_time;
+        header.total_ms = next.total_time;
+        header.max_length = next.max_length_per_pack;
+        header.max_volume = next.max_volume_per_pack;
+        header.item_count = static_cast<std::uint32_t>(next.items.size());
+
+        // One write per record, so appends from several captures never interleave
+        encoded.resize(sizeof(header) + std::size_t{header.item_count} * sizeof(item_record));
+        std::memcpy(encoded.data(), &header, sizeof(header));
+        char* out = encoded.data() + sizeof(header);
+        for (std::uint32_t i = 0; i < header.item_count; ++i, out += sizeof(item_record)) {
+            const item& it = next.items[i];
+            const item_record rec{it.get_id(), it.get_length(), it.get_quantity(), it.get_weight(),
+                                  static_cast<float>(it.get_volume())};
+            std::memcpy(out, &rec, sizeof(rec));
+        }
+
+        bool ok = !m_error && std::fwrite(encoded.data(), 1, encoded.size(), m_file) == encoded.size();
+        // Flush per record so a crash or kill loses at most the records still queued
+        ok = ok && std::fflush(m_file) == 0;
+
+        lock.lock();
+        if (ok) {
+            ++m_captured;
+        } else {
+            m_error = true;
+        }
+        m_busy = false;
+        if (m_queue.empty()) {
+            m_idle.notify_all();
+        }
+    }
+    m_idle.notify_all();
+}
+
+// ---------------------------------------------------------------------------
+// trace_reader
+// ---------------------------------------------------------------------------
+
+trace_reader::trace_reader(const std::string& path) {
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file) return;
+
+    // The file size bounds each record's item count before anything is allocated
+    long size = -1;
+    if (std::fseek(m_file, 0, SEEK_END) == 0) size = std::ftell(m_file);
+    char magic[sizeof(TRACE_MAGIC)];
+    if (size < 0 || std::fseek(m_file, 0, SEEK_SET) != 0) {
+        m_error = true;
+        return;
+    }
+    m_size = static_cast<std::uint64_t>(size);
+    if (std::fread(magic, sizeof(magic), 1, m_file) != 1) {
+        m_error = true;
+    } else if (std::memcmp(magic, TRACE_MAGIC_V1, sizeof(magic)) == 0) {
+        m_version = 1;
+    } else if (std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+        m_error = true;
+    }
+}
+
+trace_reader::~trace_reader() {
+    if (m_file) std::fclose(m_file);
+}
+
+bool trace_reader::next(trace_record& record) {
+    if (!is_open()) return false;
+
+    record_header header{};
+    std::size_t got = 0;
+    if (m_version == 1) {
+        // Version 1 records lack the length and volume fields; read them into the current layout
+        record_header_v1 v1{};
+        got = std::fread(&v1, 1, sizeof(v1), m_file);
+        header = record_header{v1.timestamp_us, v1.order, v1.type, v1.reserved, v1.thread_count,
+                               v1.max_items, v1.max_weight, v1.memory_budget, v1.sorting_ms,
+                               v1.packing_ms, v1.total_ms, 0, 0.0, v1.item_count};
+        if (got == sizeof(v1)) got = sizeof(header);
+    } else {
+        got = std::fread(&header, 1, sizeof(header), m_file);
+    }
+    if (got == 0 && std::feof(m_file)) return false;  // clean end of trace
+    const long position = std::ftell(m_file);
+    const std::uint64_t item_bytes = std::uint64_t{header.item_count} *
+        (m_version == 1 ? sizeof(item_record_v1) : sizeof(item_record));
+    if (got != sizeof(header) || header.item_count > MAX_TRACE_ITEMS || position < 0 ||
+        item_bytes > m_size - static_cast<std::uint64_t>(position) ||
+        header.order > static_cast<std::uint8_t>(LAST_SORT_ORDER) ||
+        header.type > static_cast<std::uint8_t>(strategy_type::PARALLEL_BEST_FIT)) {
+        m_error = true;
+        return false;
+    }
+
+    std::vector<item_record> encoded(header.item_count);
+    bool ok = true;
+    if (m_version == 1) {
+        for (auto& e : encoded) {
+            item_record_v1 v1{};
+            if (std::fread(&v1, sizeof(v1), 1, m_file) != 1) {
+                ok = false;
+                break;
+            }
+            e = item_record{v1.id, v1.length, v1.quantity, v1.weight, 0.0f};
+        }
+    } else if (!encoded.empty()) {
+        ok = std::fread(encoded.data(), sizeof(item_record), encoded.size(), m_file) == encoded.size();
+    }
+    if (!ok) {
+        m_error = true;
+        return false;
+    }
+
+    record.timestamp_us = header.timestamp_us;
+    record.order = static_cast<sort_order>(header.order);
+    record.type = static_cast<strategy_type>(header.type);
+    record.thread_count = header.thread_count;
+    record.max_items_per_pack = header.max_items;
+    record.max_weight_per_pack = header.max_weight;
+    record.max_length_per_pack = header.max_length;
+    record.max_volume_per_pack = header.max_volume;
+    record.memory_budget_bytes = header.memory_budget;
+    record.sorting_time = header.sorting_ms;
+    record.packing_time = header.packing_ms;
+    record.total_time = header.total_ms;
+
+    record.items.clear();
+    record.items.reserve(encoded.size());
+    for (const auto& e : encoded) {
+        record.items.emplace_back(e.id, e.length, e.quantity, e.weight, e.volume);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// replay
+// ---------------------------------------------------------------------------
+
+latency_summary summarize_latencies(std::vector<double>& latencies) {
+    latency_summary summary;
+    if (latencies.empty()) return summary;
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        // Nearest-rank percentile
+        const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * latencies.size()));
+        return latencies[std::clamp<std::size_t>(rank, 1, latencies.size()) - 1];
+    };
+
+    double sum = 0.0;
+    for (double l : latencies) sum += l;
+
+    summary.mean = sum / latencies.size();
+    summary.p50 = percentile(50.0);
+    summary.p90 = percentile(90.0);
+    summary.p99 = percentile(99.0);
+    summary.max = latencies.back();
+    return summary;
+}
+
+std::optional<replay_report> replay_trace(const std::string& path, const replay_options& options) {
+    trace_reader reader(path);
+    if (!reader.is_open()) return std::nullopt;
+
+    replay_report report;
+    std::vector<double> replayed;
+    std::vector<double> original;
+
+    pack_planner planner;
+    trace_record record;
+    std::uint64_t first_timestamp = 0;
+
+    const auto replay_start = std::chrono::steady_clock::now();
+    while (reader.next(record)) {
+        if (report.requests == 0) first_timestamp = record.timestamp_us;
+
+        // Honour the recorded inter-arrival gaps, compressed by the speed factor. Paced
+        // latency runs from the scheduled arrival, so a request held up behind a slow one
+        // is charged for its wait (no coordinated omission)
+        auto arrival = std::chrono::steady_clock::now();
+        if (options.speed > 0.0) {
+            arrival = replay_start;
+            if (record.timestamp_us > first_timestamp) {
+                arrival += std::chrono::microseconds(static_cast<long long>(
+                    (record.timestamp_us - first_timestamp) / options.speed));
+            }
+            std::this_thread::sleep_until(arrival);
+        }
+
+        pack_planner_config config;
+        config.order = record.order;
+        config.type = options.strategy.value_or(record.type);
+        config.thread_count = (options.strategy && options.thread_count > 0)
+            ? options.thread_count : record.thread_count;
+        config.max_items_per_pack = record.max_items_per_pack;
+        config.max_weight_per_pack = record.max_weight_per_pack;
+        config.max_length_per_pack = record.max_length_per_pack;
+        config.max_volume_per_pack = record.max_volume_per_pack;
+        config.memory_budget_bytes = record.memory_budget_bytes;
+
+        for (const auto& i : record.items) {
+            if (i.get_quantity() > 0) report.total_items += i.get_quantity();
+        }
+
+        pack_planner_result result = planner.plan_packs(config, std::move(record.items));
+        replayed.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - arrival).count());
+        original.push_back(record.total_time);
+
+        ++report.requests;
+    }
+    report.wall_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - replay_start).count();
+    report.trace_error = reader.has_error();
+
+    report.replayed = summarize_latencies(replayed);
+    report.original = summarize_latencies(original);
+    return report;
+}
+
+void output_replay_report(const replay_report& report, std::ostream& output) {
+    output << "=== TRACE REPLAY ===\n";
+    output << "Requests: " << report.requests << ", Items: " << report.total_items << '\n';
+    output << std::fixed << std::setprecision(3);
+    output << "Replay wall time: " << report.wall_time << " ms\n";
+    output << '\n';
+    output << "Latency(ms) Mean        P50         P90         P99         Max\n";
+    output << "----------------------------------------------------------------------\n";
+
+    auto row = [&](const char* name, const latency_summary& s) {
+        output << std::left << std::setw(12) << name
+               << std::left << std::setw(12) << s.mean
+               << std::left << std::setw(12) << s.p50
+               << std::left << std::setw(12) << s.p90
+               << std::left << std::setw(12) << s.p99
+               << s.max << '\n';
+    };
+    row("Replayed", report.replayed);
+    row("Original", report.original);
+
+    if (report.trace_error) {
+        output << "Warning: trace ended with a truncated or malformed record\n";
+    }
+}
@@ -0,0 +1,137 @@
+#include "shadow_runner.h"
+#include "pack_planner.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <iomanip>
+
+shadow_runner::shadow_runner(strategy_type candidate, double sample_rate, int thread_count,
+                             std::size_t max_queue, std::uint32_t seed)
+    : m_candidate(candidate),
+      m_sample_rate(std::clamp(sample_rate, 0.0, 1.0)),
+      m_thread_count(thread_count),
+      m_max_queue(std::max<std::size_t>(1, max_queue)),
+      m_rng(seed != 0 ? seed : std::random_device{}()) {
+    if (candidate == strategy_type::PARALLEL_FIRST_FIT) {
+        // The shadow worker runs chunks too, so one pooled thread fewer gives thread_count in all
+        m_pool = std::make_shared<thread_pool>(static_cast<unsigned int>(std::clamp(thread_count, 2, 32) - 1));
+    }
+    m_metrics.candidate_name = pack_strategy_factory::create_strategy(candidate, thread_count)->get_name();
+    m_worker = std::thread(&shadow_runner::run, this);
+}
+
+shadow_runner::~shadow_runner() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_work_ready.notify_one();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+bool shadow_runner::should_sample() {
+    if (m_sample_rate >= 1.0) return true;
+    if (m_sample_rate <= 0.0) return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::uniform_real_distribution<double>(0.0, 1.0)(m_rng) < m_sample_rate;
+}
+
+bool shadow_runner::submit(const pack_limits& limits, std::vector<item>&& sorted_items,
+                           const pack_planner_result& primary) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_metrics.submitted;
+        if (m_stop || m_queue.size() >= m_max_queue) {
+            // Never make the primary wait for the shadow
+            ++m_metrics.dropped;
+            return false;
+        }
+        m_queue.push_back(job{std::move(sorted_items), limits, primary.packing_time,
+                              primary.pack_count(), primary.utilization_percent});
+    }
+    m_work_ready.notify_one();
+    return true;
+}
+
+void shadow_runner::wait_idle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+shadow_metrics shadow_runner::snapshot() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_metrics;
+}
+
+void shadow_runner::run() {
+    // The items arrive sorted, so the candidate plans them in natural order
+    pack_planner planner;
+    planner.set_thread_pool(m_pool);
+    pack_planner_config config;
+    config.order = sort_order::NATURAL;
+    config.type = m_candidate;
+    config.thread_count = m_thread_count;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_work_ready.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) break;  // stopping and drained
+
+        job next = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_busy = true;
+        lock.unlock();
+
+        config.max_items_per_pack = next.limits.max_items;
+        config.max_weight_per_pack = next.limits.max_weight;
+        config.max_length_per_pack = next.limits.max_length;
+        config.max_volume_per_pack = next.limits.max_volume;
+        config.input_lines = next.limits.input_lines;
+        const pack_planner_result candidate = planner.plan_packs(config, std::move(next.items));
+
+        lock.lock();
+        const double latency_delta = candidate.packing_time - next.primary_packing_ms;
+        const long long pack_delta = static_cast<long long>(candidate.pack_count()) -
+                                     static_cast<long long>(next.primary_packs);
+
+        m_metrics.completed++;
+        m_metrics.primary_packing_ms += next.primary_packing_ms;
+        m_metrics.candidate_packing_ms += candidate.packing_time;
+        m_metrics.max_latency_delta_ms = m_metrics.completed == 1
+            ? latency_delta : std::max(m_metrics.max_latency_delta_ms, latency_delta);
+        m_metrics.pack_count_delta += pack_delta;
+        m_metrics.utilization_delta += candidate.utilization_percent - next.primary_utilization;
+        if (latency_delta < 0.0) m_metrics.candidate_faster++;
+        if (pack_delta < 0) m_metrics.candidate_fewer_packs++;
+
+        m_busy = false;
+        if (m_queue.empty()) {
+            m_idle.notify_all();
+        }
+    }
+    m_idle.notify_all();
+}
+
+void output_shadow_metrics(const shadow_metrics& metrics, std::ostream& output) {
+    output << "\nShadow Comparison (" << metrics.candidate_name << " vs primary):\n";
+    output << "Requests: " << metrics.completed << " evaluated, "
+           << metrics.dropped << " dropped of " << metrics.submitted << '\n';
+    if (metrics.completed == 0) return;
+
+    const auto old_flags = output.flags();
+    const auto old_precision = output.precision();
+    output << std::fixed << std::setprecision(3);
+    output << "Packing time delta: " << std::showpos << metrics.mean_latency_delta_ms()
+           << " ms mean, " << metrics.max_latency_delta_ms << " ms max" << std::noshowpos
+           << " (candidate faster on " << metrics.candidate_faster << ")\n";
+    output << "Pack count delta: " << std::showpos << metrics.mean_pack_count_delta()
+           << std::noshowpos << " mean (candidate fewer on " << metrics.candidate_fewer_packs << ")"
+           << '\n';
+    output << "Utilization delta: " << std::showpos << metrics.mean_utilization_delta()
+           << std::noshowpos << " points mean\n";
+    output.flags(old_flags);
+    output.precision(old_precision);
+}
@@ -0,0 +1 @@
+#include "wasm_profiler.h"
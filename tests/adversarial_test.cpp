@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+#include "adversarial_cases.h"
+
+// Adversarial Latency Guard Tests
+namespace {
+
+#ifdef NDEBUG
+constexpr double TIME_SCALE = 1.0;
+#else
+constexpr double TIME_SCALE = 10.0;   // unoptimized builds
+#endif
+
+const adversarial_case& find_case(const std::vector<adversarial_case>& cases, const std::string& name) {
+    for (const auto& c : cases) {
+        if (c.name == name) return c;
+    }
+    throw std::invalid_argument("no adversarial case " + name);
+}
+
+} // namespace
+
+class AdversarialTest : public ::testing::TestWithParam<adversarial_engine> {
+protected:
+    static const std::vector<adversarial_case>& cases() {
+        static const std::vector<adversarial_case> all = adversarial_cases();
+        return all;
+    }
+};
+
+TEST_P(AdversarialTest, EveryCaseStaysWithinItsCeilings) {
+    for (const auto& c : cases()) {
+        SCOPED_TRACE(c.name);
+        const adversarial_run run = run_adversarial_case(c, GetParam());
+        EXPECT_LE(run.elapsed_ms, c.time_ceiling_ms * TIME_SCALE);
+        EXPECT_LE(run.memory_bytes, c.memory_ceiling_bytes);
+    }
+}
+
+TEST_P(AdversarialTest, TinyWeightsStillPackUnits) {
+    const auto& c = find_case(cases(), "tiny-weight-huge-quantity");
+    const adversarial_run run = run_adversarial_case(c, GetParam());
+    EXPECT_GT(run.pack_count, 0u);
+    if (GetParam() != adversarial_engine::SPILLING) {
+        EXPECT_GT(run.packed_units, 0);
+    }
+}
+
+TEST_P(AdversarialTest, OverweightUnitsProduceNoPacks) {
+    const auto& c = find_case(cases(), "weight-just-above-max");
+    const adversarial_run run = run_adversarial_case(c, GetParam());
+    EXPECT_EQ(run.packed_units, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, AdversarialTest,
+                         ::testing::Values(adversarial_engine::BLOCKING, adversarial_engine::PARALLEL,
+                                           adversarial_engine::SPILLING, adversarial_engine::SESSION),
+                         [](const ::testing::TestParamInfo<adversarial_engine>& info) {
+                             return std::string(adversarial_engine_name(info.param));
+                         });
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "async_io.h"
+
+// Async I/O Stream Buffer Tests
+class AsyncIoTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Enough lines to span many 4 KiB buffers
+        std::ostringstream oss;
+        oss << "NATURAL,100,200.0\n";
+        for (int i = 0; i < 20000; ++i) {
+            oss << (1000 + i) << "," << (500 + i % 97) << "," << (1 + i % 50) << ",1.250\n";
+        }
+        content = oss.str();
+
+        char name[] = "/tmp/async_io_testXXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    [[nodiscard]] std::string read_file() const {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    std::string content;
+    std::string path;
+};
+
+TEST_F(AsyncIoTest, ReadsRegularFile) {
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    std::string result;
+    {
+        async_input_buffer buffer(fd, 4096);
+        std::istream input(&buffer);
+        std::string line;
+        while (std::getline(input, line)) {
+            result += line;
+            result += '\n';
+        }
+        EXPECT_FALSE(buffer.has_error());
+    }
+    close(fd);
+
+    EXPECT_EQ(result, content);
+}
+
+TEST_F(AsyncIoTest, ReadsPipe) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    // Feed the pipe in small pieces so reads return short counts
+    std::thread writer([&]() {
+        const char* data = content.data();
+        size_t remaining = content.size();
+        while (remaining > 0) {
+            const size_t chunk = std::min<size_t>(remaining, 1000);
+            const ssize_t written = write(fds[1], data, chunk);
+            if (written <= 0) break;
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        close(fds[1]);
+    });
+
+    std::string result;
+    {
+        async_input_buffer buffer(fds[0], 4096);
+        std::istream input(&buffer);
+        result.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    writer.join();
+    close(fds[0]);
+
+    EXPECT_EQ(result, content);
+}
+
+TEST_F(AsyncIoTest, PipeHeldOpenAfterManifestDoesNotBlock) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const std::string manifest = "NATURAL,10,40.0\n1,100,3,2.0\n2,200,4,1.0\n\n";
+    ASSERT_EQ(write(fds[1], manifest.data(), manifest.size()), static_cast<ssize_t>(manifest.size()));
+
+    // Parse up to the blank line and destroy the buffer, then destroy one never read; the writer stays open
+    std::atomic<int> finished{0};
+    std::thread reader([&]() {
+        {
+            async_input_buffer buffer(fds[0], 4096);
+            std::istream input(&buffer);
+            std::string line;
+            int lines = 0;
+            while (std::getline(input, line) && !line.empty()) ++lines;
+            EXPECT_EQ(lines, 3);
+        }
+        finished = 1;
+        {
+            async_input_buffer untouched(fds[0], 4096);
+        }
+        finished = 2;
+    });
+
+    for (int i = 0; i < 300 && finished < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(finished.load(), 2);
+
+    // Unblock the reader if it is still waiting, so the test ends either way
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+}
+
+TEST_F(AsyncIoTest, EmptyInput) {
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    async_input_buffer buffer(fd, 4096);
+    std::istream input(&buffer);
+    std::string line;
+    EXPECT_FALSE(std::getline(input, line));
+    EXPECT_FALSE(buffer.has_error());
+    close(fd);
+}
+
+TEST_F(AsyncIoTest, WritesFile) {
+    int fd = open(path.c_str(), O_WRONLY | O_TRUNC);
+    ASSERT_GE(fd, 0);
+    {
+        async_output_buffer buffer(fd, 4096);
+        std::ostream output(&buffer);
+        // Mix small writes and one larger than a whole buffer
+        output << content.substr(0, 100);
+        output << content.substr(100, 10000);
+        output << content.substr(10100);
+        output.flush();
+        EXPECT_FALSE(buffer.has_error());
+    }
+    close(fd);
+
+    EXPECT_EQ(read_file(), content);
+}
+
+TEST_F(AsyncIoTest, FlushMakesDataVisible) {
+    int fd = open(path.c_str(), O_WRONLY | O_TRUNC);
+    ASSERT_GE(fd, 0);
+
+    async_output_buffer buffer(fd, 4096);
+    std::ostream output(&buffer);
+    output << "Pack Number: 1" << std::flush;
+    EXPECT_EQ(read_file(), "Pack Number: 1");
+
+    output << "\nPack Number: 2\n";
+    output.flush();
+    EXPECT_EQ(read_file(), "Pack Number: 1\nPack Number: 2\n");
+    close(fd);
+}
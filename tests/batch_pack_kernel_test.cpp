@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "batch_pack_kernel.h"
+#include "blocking_pack_strategy.h"
+#include "pack_planner.h"
+
+// Batch Pack Kernel Tests
+class BatchPackKernelTest : public ::testing::Test {
+protected:
+    static void expect_same_packs(const std::vector<pack>& actual, const std::vector<pack>& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t p = 0; p < expected.size(); ++p) {
+            EXPECT_EQ(actual[p].get_pack_number(), expected[p].get_pack_number());
+            EXPECT_EQ(actual[p].get_total_items(), expected[p].get_total_items());
+            EXPECT_EQ(actual[p].get_total_weight(), expected[p].get_total_weight());
+            EXPECT_EQ(actual[p].get_pack_length(), expected[p].get_pack_length());
+            const auto& a = actual[p].get_items();
+            const auto& e = expected[p].get_items();
+            ASSERT_EQ(a.size(), e.size());
+            for (std::size_t i = 0; i < e.size(); ++i) {
+                EXPECT_EQ(a[i].get_id(), e[i].get_id());
+                EXPECT_EQ(a[i].get_quantity(), e[i].get_quantity());
+                EXPECT_EQ(a[i].get_weight(), e[i].get_weight());
+            }
+        }
+    }
+
+    // Small orders of mixed lines: ordinary, weightless, NaN, too heavy, without units
+    static std::vector<std::vector<item>> random_orders(std::size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> lines(0, 40), length(1, 5000), quantity(-2, 30), kind(0, 19);
+        std::uniform_real_distribution<double> weight(0.01, 12.0);
+        std::vector<std::vector<item>> orders(count);
+        int id = 0;
+        for (auto& order : orders) {
+            for (int n = lines(rng); n > 0; --n) {
+                const int k = kind(rng);
+                const double w = k == 0 ? 0.0 : k == 1 ? std::nan("") : k == 2 ? 500.0 : k == 3 ? -1.0 : weight(rng);
+                order.emplace_back(++id, length(rng), quantity(rng), w);
+            }
+        }
+        return orders;
+    }
+};
+
+TEST_F(BatchPackKernelTest, MatchesBlockingOnEveryOrder) {
+    const auto orders = random_orders(300, 7);
+    blocking_pack_strategy blocking;
+    for (const auto& [max_items, max_weight] : {std::pair{10, 50.0}, std::pair{3, 7.5}, std::pair{100, 1000.0}}) {
+        const auto batched = batch_pack::pack_orders(orders, max_items, max_weight);
+        ASSERT_EQ(batched.size(), orders.size());
+        for (std::size_t o = 0; o < orders.size(); ++o) {
+            SCOPED_TRACE(o);
+            expect_same_packs(batched[o], blocking.pack_items(orders[o], max_items, max_weight));
+        }
+    }
+}
+
+TEST_F(BatchPackKernelTest, RefillsLanesAcrossEmptyAndUnequalOrders) {
+    std::vector<std::vector<item>> orders(3 * batch_pack::LANES + 1);
+    for (std::size_t o = 0; o < orders.size(); ++o) {
+        // Every third order is empty or has no units; the rest grow with o
+        if (o % 3 == 1) continue;
+        if (o % 3 == 2) {
+            orders[o].emplace_back(static_cast<int>(o), 10, 0, 1.0);
+            continue;
+        }
+        for (std::size_t i = 0; i < o + 1; ++i) {
+            orders[o].emplace_back(static_cast<int>(o * 100 + i), 10, 1 + static_cast<int>(i % 4), 2.0);
+        }
+    }
+    const auto batched = batch_pack::pack_orders(orders, 5, 20.0);
+    blocking_pack_strategy blocking;
+    for (std::size_t o = 0; o < orders.size(); ++o) {
+        SCOPED_TRACE(o);
+        expect_same_packs(batched[o], blocking.pack_items(orders[o], 5, 20.0));
+    }
+    EXPECT_TRUE(batch_pack::pack_orders({}, 5, 20.0).empty());
+}
+
+TEST_F(BatchPackKernelTest, StopsAtThePackCapLikeBlocking) {
+    // One unit per pack: 5000 units need 5000 packs, past the cap of 1000 packs for a one-line order
+    const std::vector<std::vector<item>> orders = {{item(1, 10, 5000, 1.0), item(2, 10, 3, 1.0)},
+                                                   {item(3, 10, 2, 1.0)}};
+    const auto batched = batch_pack::pack_orders(orders, 1, 10.0);
+    blocking_pack_strategy blocking;
+    expect_same_packs(batched[0], blocking.pack_items(orders[0], 1, 10.0));
+    expect_same_packs(batched[1], blocking.pack_items(orders[1], 1, 10.0));
+    EXPECT_EQ(batched[0].size(), 1000u);
+}
+
+TEST_F(BatchPackKernelTest, PlanOrdersMatchesPlanPacks) {
+    const auto orders = random_orders(50, 11);
+    pack_planner_config config;
+    config.max_items_per_pack = 12;
+    config.max_weight_per_pack = 40.0;
+    config.order = sort_order::LONG_TO_SHORT;
+
+    pack_planner planner;
+    const auto batched = planner.plan_orders(config, orders);
+    ASSERT_EQ(batched.size(), orders.size());
+    for (std::size_t o = 0; o < orders.size(); ++o) {
+        SCOPED_TRACE(o);
+        const auto single = planner.plan_packs(config, orders[o]);
+        expect_same_packs(batched[o].packs, single.packs);
+        EXPECT_EQ(batched[o].total_items, single.total_items);
+        EXPECT_EQ(batched[o].utilization_percent, single.utilization_percent);
+        EXPECT_EQ(batched[o].strategy_name, single.strategy_name);
+        EXPECT_EQ(batched[o].diagnostics.dropped(), single.diagnostics.dropped());
+    }
+
+    // Optional limits take the per-order path and still agree
+    config.max_length_per_pack = 2500;
+    const auto limited = planner.plan_orders(config, orders);
+    for (std::size_t o = 0; o < orders.size(); ++o) {
+        expect_same_packs(limited[o].packs, planner.plan_packs(config, orders[o]).packs);
+    }
+}
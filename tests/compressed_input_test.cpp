@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "compressed_input.h"
+
+#if defined(PACK_PLANNER_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+// Compressed Input Tests
+class CompressedInputTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::ostringstream oss;
+        oss << "LONG_TO_SHORT,100,200.0\n";
+        for (int i = 0; i < 50000; ++i) {
+            oss << (1000 + i) << "," << (500 + i % 997) << "," << (1 + i % 90) << ",2.750\n";
+        }
+        content = oss.str();
+
+        char name[] = "/tmp/compressed_input_testXXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    void write_file(const std::string& data) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    [[nodiscard]] std::string read_back(unsigned int threads, compression_format* format = nullptr,
+                                        bool* parallel = nullptr, bool* error = nullptr) const {
+        int fd = open(path.c_str(), O_RDONLY);
+        EXPECT_GE(fd, 0);
+        std::string result;
+        {
+            compressed_input_buffer buffer(fd, threads);
+            std::istream input(&buffer);
+            result.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+            if (format) *format = buffer.format();
+            if (parallel) *parallel = buffer.is_parallel();
+            if (error) *error = buffer.has_error();
+        }
+        close(fd);
+        return result;
+    }
+
+    std::string content;
+    std::string path;
+};
+
+#if defined(PACK_PLANNER_HAS_ZLIB)
+namespace {
+
+// Compress one gzip member
+std::string gzip_member(const std::string& data) {
+    z_stream zs{};
+    EXPECT_EQ(deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    std::string out(deflateBound(&zs, data.size()) + 32, '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(out.data());
+    zs.avail_out = static_cast<uInt>(out.size());
+    EXPECT_EQ(deflate(&zs, Z_FINISH), Z_STREAM_END);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+// Compress into BGZF blocks the way bgzip does
+std::string bgzf(const std::string& data) {
+    std::string out;
+    for (size_t offset = 0; offset < data.size(); offset += 60000) {
+        const std::string chunk = data.substr(offset, 60000);
+
+        z_stream zs{};
+        EXPECT_EQ(deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY), Z_OK);
+        std::string raw(deflateBound(&zs, chunk.size()), '\0');
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(chunk.data()));
+        zs.avail_in = static_cast<uInt>(chunk.size());
+        zs.next_out = reinterpret_cast<Bytef*>(raw.data());
+        zs.avail_out = static_cast<uInt>(raw.size());
+        EXPECT_EQ(deflate(&zs, Z_FINISH), Z_STREAM_END);
+        raw.resize(zs.total_out);
+        deflateEnd(&zs);
+
+        const size_t block_size = 18 + raw.size() + 8;
+        const unsigned char header[18] = {
+            0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0, 'B', 'C', 2, 0,
+            static_cast<unsigned char>((block_size - 1) & 0xff),
+            static_cast<unsigned char>((block_size - 1) >> 8)
+        };
+        out.append(reinterpret_cast<const char*>(header), sizeof(header));
+        out += raw;
+
+        const uLong crc = crc32(0, reinterpret_cast<const Bytef*>(chunk.data()),
+                                static_cast<uInt>(chunk.size()));
+        for (uLong v : {crc, static_cast<uLong>(chunk.size())}) {
+            for (int b = 0; b < 4; ++b) out.push_back(static_cast<char>((v >> (8 * b)) & 0xff));
+        }
+    }
+    return out;
+}
+
+} // namespace
+#endif
+
+TEST_F(CompressedInputTest, DetectCompression) {
+    const unsigned char gz[] = {0x1f, 0x8b, 8, 0};
+    const unsigned char zst[] = {0x28, 0xb5, 0x2f, 0xfd};
+    const unsigned char text[] = {'N', 'A', 'T', 'U'};
+
+    EXPECT_EQ(detect_compression(gz, sizeof(gz)), compression_format::GZIP);
+    EXPECT_EQ(detect_compression(zst, sizeof(zst)), compression_format::ZSTD);
+    EXPECT_EQ(detect_compression(text, sizeof(text)), compression_format::NONE);
+    EXPECT_EQ(detect_compression(gz, 1), compression_format::NONE);
+}
+
+TEST_F(CompressedInputTest, PlainTextPassesThrough) {
+    write_file(content);
+
+    compression_format format = compression_format::GZIP;
+    EXPECT_EQ(read_back(4, &format), content);
+    EXPECT_EQ(format, compression_format::NONE);
+}
+
+TEST_F(CompressedInputTest, PlainTextFromPipe) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const std::string small = content.substr(0, 4000);
+    ASSERT_EQ(write(fds[1], small.data(), small.size()), static_cast<ssize_t>(small.size()));
+    close(fds[1]);
+
+    std::string result;
+    {
+        compressed_input_buffer buffer(fds[0]);
+        std::istream input(&buffer);
+        result.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    close(fds[0]);
+
+    EXPECT_EQ(result, small);
+}
+
+#if defined(PACK_PLANNER_HAS_ZLIB)
+TEST_F(CompressedInputTest, GzipSingleMember) {
+    write_file(gzip_member(content));
+
+    compression_format format = compression_format::NONE;
+    bool parallel = true;
+    EXPECT_EQ(read_back(4, &format, &parallel), content);
+    EXPECT_EQ(format, compression_format::GZIP);
+    EXPECT_FALSE(parallel);
+}
+
+TEST_F(CompressedInputTest, GzipConcatenatedMembers) {
+    const size_t half = content.size() / 2;
+    write_file(gzip_member(content.substr(0, half)) + gzip_member(content.substr(half)));
+
+    EXPECT_EQ(read_back(4), content);
+}
+
+TEST_F(CompressedInputTest, BgzfDecodedInParallel) {
+    // Repeat to get several batches worth of blocks
+    std::string large;
+    for (int i = 0; i < 8; ++i) large += content;
+    write_file(bgzf(large));
+
+    bool parallel = false;
+    bool error = true;
+    EXPECT_EQ(read_back(4, nullptr, &parallel, &error), large);
+    EXPECT_TRUE(parallel);
+    EXPECT_FALSE(error);
+
+    // Same output with a single worker
+    EXPECT_EQ(read_back(1), large);
+}
+
+TEST_F(CompressedInputTest, TruncatedGzipReportsError) {
+    std::string compressed = gzip_member(content);
+    compressed.resize(compressed.size() / 2);
+    write_file(compressed);
+
+    bool error = false;
+    const std::string result = read_back(4, nullptr, nullptr, &error);
+    EXPECT_TRUE(error);
+    EXPECT_LT(result.size(), content.size());
+}
+#endif
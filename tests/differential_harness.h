@@ -0,0 +1,454 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "blocking_pack_strategy.h"
+#include "item_sort.h"
+#include "pack_cursor.h"
+#include "pack_planner.h"
+#include "pack_validator.h"
+#include "parallel_pack_strategy.h"
+#include "plan_columns.h"
+#include "simd_kernels.h"
+
+/**
+ * @brief Differential checks of the optimized packing paths against a reference packer
+ *
+ * Shared by the property tests (differential_test.cpp) and the libFuzzer
+ * target (pack_planner_fuzz.cpp): a case is decoded from raw bytes, packed by
+ * every strategy and kernel, and compared with reference_pack(), a plain
+ * next-fit implementation written for clarity rather than speed.
+ */
+namespace differential {
+
+/**
+ * @brief One randomized planning request
+ */
+struct fuzz_case {
+    pack_planner_config config;
+    std::vector<item> items;
+    unsigned cursor_seed = 0;   // drives the pack_cursor increment sizes
+};
+
+/**
+ * @brief Decode a planning request from arbitrary bytes
+ *
+ * Every byte string decodes to a valid request; missing bytes read as zero.
+ * Lengths, quantities and weights include non-positive and oversized values.
+ *
+ * @param data Input bytes
+ * @param size Number of bytes
+ * @return fuzz_case Decoded request
+ */
+inline fuzz_case decode_case(const std::uint8_t* data, std::size_t size) {
+    std::size_t pos = 0;
+    auto next = [&]() -> unsigned { return pos < size ? data[pos++] : 0u; };
+    auto next16 = [&]() -> unsigned { const unsigned lo = next(); return lo | (next() << 8); };
+
+    fuzz_case c;
+    c.config.max_items_per_pack = 1 + static_cast<int>(next16() % 300);
+    c.config.max_weight_per_pack = (1 + next16() % 4000) / 8.0;
+    c.config.order = static_cast<sort_order>(next() % (static_cast<unsigned>(LAST_SORT_ORDER) + 1));
+    c.config.thread_count = 1 + static_cast<int>(next() % 8);
+    const unsigned budget = next();
+    c.config.memory_budget_bytes = budget % 4 == 0 ? 256 + budget * 64 : 0;
+    c.cursor_seed = next();
+
+    constexpr std::size_t MAX_ITEMS = 20000;
+    while (pos < size && c.items.size() < MAX_ITEMS) {
+        const int length = static_cast<int>(next16() % 2000) - 50;
+        const unsigned q = next();
+        const int quantity = q == 255 ? -3 : static_cast<int>(q % 17);
+        const unsigned w = next16();
+        const double weight = (w >> 10) == 0x3F ? c.config.max_weight_per_pack * 2.0  // never fits
+                                                : (w % 1024) / 32.0;
+        c.items.emplace_back(static_cast<int>(c.items.size()) + 1, length, quantity, weight);
+    }
+    return c;
+}
+
+/**
+ * @brief Reference next-fit packer
+ *
+ * Walks the items in order and fills the open pack with as many units as the
+ * unit and weight limits allow, opening a new pack when nothing more fits.
+ * Units heavier than max_weight are left out. No safety caps.
+ * Throws std::logic_error if pack::add_partial_item accepts a different amount.
+ *
+ * @param items Items in packing order
+ * @param max_items Maximum units per pack
+ * @param max_weight Maximum weight per pack
+ * @return std::vector<pack> Packs numbered from 1; the last one may be empty
+ */
+inline std::vector<pack> reference_pack(const std::vector<item>& items, int max_items, double max_weight) {
+    max_items = std::max(1, max_items);
+    max_weight = std::max(0.1, max_weight);
+
+    std::vector<pack> packs;
+    packs.emplace_back(1);
+    int units = 0;
+    double weight = 0.0;
+
+    for (const auto& i : items) {
+        const double unit_weight = std::max(0.0, i.get_weight());
+        if (i.get_quantity() <= 0 || unit_weight > max_weight) continue;
+
+        int remaining = i.get_quantity();
+        while (remaining > 0) {
+            const double fit = unit_weight == 0.0 ? remaining : (max_weight - weight) / unit_weight;
+            const int by_weight = fit >= remaining ? remaining : fit <= 0.0 ? 0 : static_cast<int>(fit);
+            const int take = std::min({max_items - units, by_weight, remaining});
+            if (take > 0) {
+                // pack only stores the line here; the amount was decided above
+                if (packs.back().add_partial_item(i.get_id(), i.get_length(), take, i.get_weight(),
+                                                  max_items, max_weight) != take) {
+                    throw std::logic_error("pack::add_partial_item disagrees with the reference limits");
+                }
+                units += take;
+                weight += take * unit_weight;
+                remaining -= take;
+            } else if (packs.back().is_empty()) {
+                break;
+            } else {
+                packs.emplace_back(static_cast<int>(packs.size()) + 1);
+                units = 0;
+                weight = 0.0;
+            }
+        }
+    }
+    return packs;
+}
+
+/**
+ * @brief Collects the first mismatch found while checking a case
+ */
+class mismatch_log {
+public:
+    template <typename... Parts>
+    void fail(const Parts&... parts) {
+        if (!m_message.empty()) return;
+        std::ostringstream out;
+        (out << ... << parts);
+        m_message = out.str();
+    }
+
+    [[nodiscard]] bool failed() const noexcept { return !m_message.empty(); }
+    [[nodiscard]] const std::string& message() const noexcept { return m_message; }
+
+private:
+    std::string m_message;
+};
+
+inline std::string describe_pack(const pack& p) {
+    std::ostringstream out;
+    out << "#" << p.get_pack_number() << "[";
+    for (const auto& line : p.get_items()) {
+        out << line.get_id() << "x" << line.get_quantity() << " ";
+    }
+    out << "]";
+    return out.str();
+}
+
+inline bool same_pack(const pack& a, const pack& b) {
+    const auto& x = a.get_items();
+    const auto& y = b.get_items();
+    if (x.size() != y.size() || a.get_total_items() != b.get_total_items() ||
+        a.get_pack_length() != b.get_pack_length() || a.get_total_weight() != b.get_total_weight()) {
+        return false;
+    }
+    for (std::size_t k = 0; k < x.size(); ++k) {
+        if (x[k].get_id() != y[k].get_id() || x[k].get_length() != y[k].get_length() ||
+            x[k].get_quantity() != y[k].get_quantity() || x[k].get_weight() != y[k].get_weight()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline std::vector<pack> non_empty(std::vector<pack> packs) {
+    packs.erase(std::remove_if(packs.begin(), packs.end(), [](const pack& p) { return p.is_empty(); }),
+                packs.end());
+    return packs;
+}
+
+// Packs of a result in output order, spilled packs first
+inline std::vector<pack> all_packs(const pack_planner_result& result) {
+    std::vector<pack> packs;
+    if (result.spill) result.spill->for_each([&](const pack& p) { packs.push_back(p); });
+    packs.insert(packs.end(), result.packs.begin(), result.packs.end());
+    return non_empty(std::move(packs));
+}
+
+/**
+ * @brief Require identical packs, in order and with the same numbers
+ */
+inline void expect_same_packs(mismatch_log& log, const char* what, const std::vector<pack>& expected,
+                              const std::vector<pack>& actual) {
+    const auto want = non_empty(expected);
+    const auto got = non_empty(actual);
+    if (want.size() != got.size()) {
+        log.fail(what, ": ", got.size(), " packs, reference has ", want.size());
+        return;
+    }
+    for (std::size_t p = 0; p < want.size(); ++p) {
+        if (!same_pack(want[p], got[p]) || want[p].get_pack_number() != got[p].get_pack_number()) {
+            log.fail(what, ": pack ", p, " is ", describe_pack(got[p]), ", reference has ",
+                     describe_pack(want[p]));
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Require the same packs in any order, ignoring pack numbers
+ */
+inline void expect_same_pack_set(mismatch_log& log, const char* what, std::vector<pack> expected,
+                                 std::vector<pack> actual) {
+    expected = non_empty(std::move(expected));
+    actual = non_empty(std::move(actual));
+    auto key = [](const pack& p) {
+        std::ostringstream out;
+        for (const auto& line : p.get_items()) {
+            out << line.get_id() << ':' << line.get_quantity() << ':' << line.get_length() << ' ';
+        }
+        return out.str();
+    };
+    auto by_key = [&](const pack& a, const pack& b) { return key(a) < key(b); };
+    std::sort(expected.begin(), expected.end(), by_key);
+    std::sort(actual.begin(), actual.end(), by_key);
+    if (expected.size() != actual.size()) {
+        log.fail(what, ": ", actual.size(), " packs, reference has ", expected.size());
+        return;
+    }
+    for (std::size_t p = 0; p < expected.size(); ++p) {
+        if (!same_pack(expected[p], actual[p])) {
+            log.fail(what, ": ", describe_pack(actual[p]), " has no match in the reference");
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Check the column kernels against naive loops over the same data
+ */
+inline void check_kernels(mismatch_log& log, const std::vector<item>& items,
+                          const std::vector<pack>& packs, const plan_columns& columns) {
+    // plan_columns: offsets from the prefix-sum kernel, totals from the reduction kernels
+    if (columns.pack_count() != packs.size()) {
+        log.fail("plan_columns: ", columns.pack_count(), " packs, expected ", packs.size());
+        return;
+    }
+    std::size_t line = 0;
+    long long quantity = 0;
+    double weight = 0.0;
+    for (std::size_t p = 0; p < packs.size(); ++p) {
+        if (columns.pack_offsets[p] != line || columns.pack_numbers[p] != packs[p].get_pack_number() ||
+            columns.pack_lengths[p] != packs[p].get_pack_length() ||
+            columns.pack_weights[p] != packs[p].get_total_weight()) {
+            log.fail("plan_columns: pack ", p, " differs from ", describe_pack(packs[p]));
+            return;
+        }
+        for (const auto& i : packs[p].get_items()) {
+            if (columns.item_ids[line] != i.get_id() || columns.item_quantities[line] != i.get_quantity()) {
+                log.fail("plan_columns: line ", line, " differs from item ", i.get_id());
+                return;
+            }
+            quantity += i.get_quantity();
+            ++line;
+        }
+        weight += packs[p].get_total_weight();
+    }
+    if (columns.pack_offsets[packs.size()] != line) log.fail("plan_columns: end offset ", line);
+    if (columns.total_quantity() != quantity) {
+        log.fail("sum_positive: ", columns.total_quantity(), ", expected ", quantity);
+    }
+    if (std::abs(columns.total_weight() - weight) > 1e-9 * std::max(1.0, weight)) {
+        log.fail("sum: ", columns.total_weight(), ", expected ", weight);
+    }
+
+    // Sort keys: sorting them must give the stable length order of the rows
+    std::vector<std::int32_t> lengths;
+    lengths.reserve(items.size());
+    for (const auto& i : items) lengths.push_back(i.get_length());
+    for (bool descending : {false, true}) {
+        std::vector<std::uint64_t> keys(lengths.size());
+        simd_kernels::build_sort_keys(lengths.data(), lengths.size(), descending, keys.data());
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<std::uint32_t> expected(lengths.size());
+        for (std::uint32_t r = 0; r < expected.size(); ++r) expected[r] = r;
+        std::stable_sort(expected.begin(), expected.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return descending ? lengths[a] > lengths[b] : lengths[a] < lengths[b];
+        });
+        for (std::size_t r = 0; r < keys.size(); ++r) {
+            if (static_cast<std::uint32_t>(keys[r]) != expected[r]) {
+                log.fail("build_sort_keys: row ", r, (descending ? " (descending)" : ""), " is ",
+                         static_cast<std::uint32_t>(keys[r]), ", expected ", expected[r]);
+                return;
+            }
+        }
+    }
+    // Item sort: radix sorting must match a stable comparison sort for every order
+    for (int o = 1; o <= static_cast<int>(LAST_SORT_ORDER); ++o) {
+        const auto order = static_cast<sort_order>(o);
+        const bool by_length = order != sort_order::HEAVY_TO_LIGHT;
+        const bool by_weight = order >= sort_order::HEAVY_TO_LIGHT;
+        const bool descending = order == sort_order::LONG_TO_SHORT ||
+                                order == sort_order::LONG_TO_SHORT_HEAVY_FIRST;
+
+        std::vector<item> expected = items;
+        std::stable_sort(expected.begin(), expected.end(), [&](const item& a, const item& b) {
+            const int length_a = std::max(1, a.get_length());
+            const int length_b = std::max(1, b.get_length());
+            if (by_length && length_a != length_b) {
+                return descending ? length_a > length_b : length_a < length_b;
+            }
+            return by_weight && std::max(0.0, a.get_weight()) > std::max(0.0, b.get_weight());
+        });
+        std::vector<item> actual = items;
+        item_sort::sort(actual, order);
+
+        for (std::size_t r = 0; r < actual.size(); ++r) {
+            if (actual[r].get_id() != expected[r].get_id() ||
+                actual[r].get_length() != expected[r].get_length() ||
+                actual[r].get_quantity() != expected[r].get_quantity()) {
+                log.fail("item_sort: row ", r, " under ", sort_order_to_string(order), " is item ",
+                         actual[r].get_id(), ", expected ", expected[r].get_id());
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Outcome of checking one case
+ */
+struct case_outcome {
+    bool compared = false;   // false if the case hits the engine's safety caps and was only decoded
+    std::string mismatch;    // empty when every path matched the reference
+};
+
+/**
+ * @brief Pack one case with every strategy and kernel and compare against the reference
+ *
+ * Blocking, the sequential parallel fallback, the memory-capped (spilling)
+ * blocking path and pack_cursor in random increments must reproduce the
+ * reference exactly. The multi-threaded parallel path packs fixed chunks
+ * independently, so it must produce the reference packs of each chunk, in
+ * any order; the planner cuts its chunks after screening out unpackable
+ * items. Every planner result must also pass pack_validator and report the
+ * screened-out lines in its diagnostics.
+ *
+ * Cases whose reference plan exceeds the strategies' pack caps (where they
+ * deliberately drop units) are skipped.
+ *
+ * @param c Case to check
+ * @return case_outcome Whether the case was compared, and the first mismatch
+ */
+inline case_outcome check_case(const fuzz_case& c) {
+    case_outcome outcome;
+    mismatch_log log;
+
+    const int max_items = std::max(1, c.config.max_items_per_pack);
+    const double max_weight = std::max(0.1, c.config.max_weight_per_pack);
+    const int threads = std::clamp(c.config.thread_count, 1, 32);
+
+    std::vector<item> sorted = c.items;
+    pack_planner::sort_items(sorted, c.config.order);
+    const auto reference = reference_pack(sorted, max_items, max_weight);
+
+    // The planner screens out unpackable items before its strategy runs, so its
+    // parallel chunks are cut from the packable items only
+    std::vector<item> packable;
+    for (const auto& i : sorted) {
+        if (i.get_quantity() > 0 && !(std::max(0.0, i.get_weight()) > max_weight)) packable.push_back(i);
+    }
+
+    // Same caps as blocking_pack_strategy / pack_cursor and the parallel workers
+    if (reference.size() > std::min<std::size_t>(100000, packable.size() / 10 + 1000)) return outcome;
+
+    // Reference packs of each parallel chunk; false if a worker would hit its caps
+    auto chunk_reference_of = [&](const std::vector<item>& items, std::vector<pack>& out) {
+        const std::size_t chunk = items.size() / threads;
+        const std::size_t remainder = items.size() % threads;
+        std::size_t begin = 0;
+        for (int t = 0; t < threads; ++t) {
+            const std::size_t end = begin + chunk + (static_cast<std::size_t>(t) < remainder ? 1 : 0);
+            const std::vector<item> part(items.begin() + begin, items.begin() + end);
+            auto packs = reference_pack(part, max_items, max_weight);
+            if (packs.size() > std::min<std::size_t>(20000, part.size() / 10 + 500)) return false;
+            out.insert(out.end(), packs.begin(), packs.end());
+            begin = end;
+        }
+        return out.size() <= std::min<std::size_t>(200000, items.size() / 5 + 10000);
+    };
+    const bool chunked = sorted.size() >= 5000 && threads > 1;
+    std::vector<pack> chunk_reference;
+    if (chunked && !chunk_reference_of(sorted, chunk_reference)) return outcome;
+    const bool planner_chunked = packable.size() >= 5000 && threads > 1;
+    std::vector<pack> planner_chunk_reference;
+    if (planner_chunked && !chunk_reference_of(packable, planner_chunk_reference)) return outcome;
+    outcome.compared = true;
+
+    // Strategies directly on the sorted items
+    blocking_pack_strategy blocking;
+    expect_same_packs(log, "blocking", reference, blocking.pack_items(sorted, max_items, max_weight));
+    parallel_pack_strategy parallel(threads);
+    if (chunked) {
+        expect_same_pack_set(log, "parallel", chunk_reference, parallel.pack_items(sorted, max_items, max_weight));
+    } else {
+        expect_same_packs(log, "parallel", reference, parallel.pack_items(sorted, max_items, max_weight));
+    }
+
+    // pack_cursor in pseudo-random increments
+    pack_cursor cursor(sorted, max_items, max_weight);
+    unsigned state = c.cursor_seed * 2654435761u + 1;
+    while (!cursor.done()) {
+        state = state * 1103515245u + 12345u;
+        cursor.advance(1 + (state >> 16) % 64);
+    }
+    expect_same_packs(log, "pack_cursor", reference, cursor.take_packs());
+
+    // Full planner runs, each validated independently as well
+    pack_validator validator(1);
+    for (auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::PARALLEL_FIRST_FIT}) {
+        pack_planner_config config = c.config;
+        config.type = type;
+        if (type == strategy_type::PARALLEL_FIRST_FIT) config.memory_budget_bytes = 0;
+        pack_planner planner;
+        const auto result = planner.plan_packs(config, c.items);
+        const auto packs = all_packs(result);
+        if (result.diagnostics.dropped() != sorted.size() - packable.size()) {
+            log.fail("planner: diagnostics report ", result.diagnostics.dropped(), " dropped lines, expected ",
+                     sorted.size() - packable.size());
+        }
+
+        const char* what = type == strategy_type::BLOCKING_FIRST_FIT
+            ? (config.memory_budget_bytes > 0 ? "planner (spilling)" : "planner (blocking)")
+            : "planner (parallel)";
+        if (type == strategy_type::PARALLEL_FIRST_FIT && planner_chunked) {
+            expect_same_pack_set(log, what, planner_chunk_reference, packs);
+        } else {
+            expect_same_packs(log, what, reference, packs);
+        }
+
+        plan_columns columns;
+        columns.assign(result);
+        const auto report = validator.validate(config, c.items, columns);
+        if (!report.ok()) {
+            log.fail(what, ": invalid plan: ", report.issues.front().message);
+        }
+        check_kernels(log, c.items, packs, columns);
+    }
+
+    outcome.mismatch = log.message();
+    return outcome;
+}
+
+} // namespace differential
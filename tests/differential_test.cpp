@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "differential_harness.h"
+
+// Differential Tests: every strategy and kernel against the reference packer
+namespace {
+
+differential::fuzz_case random_case(std::mt19937& rng, std::size_t min_items, std::size_t max_items) {
+    std::uniform_int_distribution<std::size_t> count(min_items, max_items);
+    std::vector<std::uint8_t> bytes(8 + 5 * count(rng));
+    for (auto& b : bytes) b = static_cast<std::uint8_t>(rng());
+    return differential::decode_case(bytes.data(), bytes.size());
+}
+
+} // namespace
+
+TEST(DifferentialTest, ReferencePackerHonoursLimits) {
+    const std::vector<item> items = {item(1, 10, 7, 2.0), item(2, 20, 3, 50.0), item(3, 30, 4, 0.0)};
+    const auto packs = differential::reference_pack(items, 5, 10.0);
+
+    ASSERT_EQ(packs.size(), 3u);
+    EXPECT_EQ(packs[0].get_total_items(), 5);   // 5 x item 1 hits the unit limit
+    EXPECT_EQ(packs[1].get_total_items(), 5);   // 2 x item 1, item 2 too heavy, 3 of 4 zero-weight units
+    EXPECT_EQ(packs[2].get_total_items(), 1);
+}
+
+TEST(DifferentialTest, SmallRandomCasesMatchReference) {
+    std::mt19937 rng(20240601);
+    int compared = 0;
+    for (int n = 0; n < 400; ++n) {
+        const auto c = random_case(rng, 0, 400);
+        const auto outcome = differential::check_case(c);
+        compared += outcome.compared;
+        ASSERT_EQ(outcome.mismatch, "") << "case " << n << ": " << c.items.size() << " items, max_items "
+                                        << c.config.max_items_per_pack << ", max_weight "
+                                        << c.config.max_weight_per_pack;
+    }
+    EXPECT_GT(compared, 200);  // most cases stay within the strategies' pack caps
+}
+
+TEST(DifferentialTest, LargeCasesCoverChunkedParallelPath) {
+    std::mt19937 rng(77);
+    int compared = 0;
+    for (int n = 0; n < 8; ++n) {
+        auto c = random_case(rng, 5000, 8000);
+        // Generous limits keep the pack count under the caps of every chunk
+        c.config.max_items_per_pack = std::max(c.config.max_items_per_pack, 200);
+        c.config.max_weight_per_pack = std::max(c.config.max_weight_per_pack, 2000.0);
+        c.config.thread_count = 2 + n % 7;
+        const auto outcome = differential::check_case(c);
+        compared += outcome.compared;
+        ASSERT_EQ(outcome.mismatch, "") << "case " << n << ": " << c.items.size() << " items";
+    }
+    EXPECT_GT(compared, 4);
+}
+
+TEST(DifferentialTest, DecodesAnyBytes) {
+    // Short, empty and degenerate inputs must decode into cases that check cleanly
+    const std::vector<std::vector<std::uint8_t>> inputs = {
+        {}, {0}, {255, 255, 255, 255, 255, 255, 255, 255}, std::vector<std::uint8_t>(64, 0),
+        std::vector<std::uint8_t>(64, 255)};
+    for (const auto& bytes : inputs) {
+        const auto c = differential::decode_case(bytes.data(), bytes.size());
+        EXPECT_GE(c.config.max_items_per_pack, 1);
+        EXPECT_GT(c.config.max_weight_per_pack, 0.0);
+        EXPECT_EQ(differential::check_case(c).mismatch, "");
+    }
+}
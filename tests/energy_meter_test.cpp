@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "energy_meter.h"
+
+// Energy Meter Tests (against a fake powercap tree)
+class EnergyMeterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() /
+               ("powercap_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root / "intel-rapl");  // control type entry, not a zone
+    }
+
+    void TearDown() override { std::filesystem::remove_all(root); }
+
+    void make_zone(const std::filesystem::path& zone, const std::string& name, std::uint64_t energy,
+                   std::uint64_t range = 262143328850ull) {
+        std::filesystem::create_directories(zone);
+        std::ofstream(zone / "name") << name << "\n";
+        write_energy(zone, energy);
+        std::ofstream(zone / "max_energy_range_uj") << range << "\n";
+    }
+
+    static void write_energy(const std::filesystem::path& zone, std::uint64_t energy) {
+        std::ofstream(zone / "energy_uj") << energy << "\n";
+    }
+
+    std::filesystem::path root;
+};
+
+TEST_F(EnergyMeterTest, UnavailableWithoutCounters) {
+    EXPECT_FALSE(energy_meter((root / "missing").string()).available());
+    EXPECT_FALSE(energy_meter(root.string()).available());
+}
+
+TEST_F(EnergyMeterTest, SumsPackagesAndDramOnly) {
+    const auto package = root / "intel-rapl:0";
+    make_zone(package, "package-0", 1000000);
+    make_zone(package / "intel-rapl:0:0", "core", 500000);
+    make_zone(package / "intel-rapl:0:1", "dram", 200000);
+    make_zone(root / "intel-rapl:1", "psys", 9000000);
+
+    energy_meter meter(root.string());
+    ASSERT_TRUE(meter.available());
+    EXPECT_EQ(meter.domain_names(), (std::vector<std::string>{"package-0", "package-0/dram"}));
+
+    const energy_sample before = meter.sample();
+    write_energy(package, 3500000);                     // +2.5 J
+    write_energy(package / "intel-rapl:0:0", 900000);   // core: already in the package
+    write_energy(package / "intel-rapl:0:1", 700000);   // +0.5 J
+    const energy_sample after = meter.sample();
+
+    EXPECT_DOUBLE_EQ(meter.joules(before, after), 3.0);
+    EXPECT_GE(meter.watts(before, after), 0.0);
+}
+
+TEST_F(EnergyMeterTest, HandlesCounterWraparound) {
+    const auto package = root / "intel-rapl:0";
+    make_zone(package, "package-0", 9000000, 10000000);
+
+    energy_meter meter(root.string());
+    const energy_sample before = meter.sample();
+    write_energy(package, 500000);  // wrapped after 10 J
+    const energy_sample after = meter.sample();
+
+    EXPECT_DOUBLE_EQ(meter.joules(before, after), 1.5);
+}
+
+TEST_F(EnergyMeterTest, BackwardsCounterWithUnknownRangeCountsNothing) {
+    const auto package = root / "intel-rapl:0";
+    make_zone(package, "package-0", 9000000, 10000000);
+    make_zone(root / "intel-rapl:1", "package-1", 9000000, 0);   // range unreadable
+    std::filesystem::remove(root / "intel-rapl:1" / "max_energy_range_uj");
+
+    energy_meter meter(root.string());
+    ASSERT_EQ(meter.domain_names().size(), 2u);
+    const energy_sample before = meter.sample();
+    write_energy(package, 9500000);                  // +0.5 J
+    write_energy(root / "intel-rapl:1", 400000);     // went backwards, wrap point unknown
+    const energy_sample after = meter.sample();
+
+    EXPECT_DOUBLE_EQ(meter.joules(before, after), 0.5);
+}
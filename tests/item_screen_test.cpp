@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "item_screen.h"
+#include "pack_planner.h"
+
+// Item Screen Tests
+class ItemScreenTest : public ::testing::Test {
+protected:
+    static std::vector<int> ids(const std::vector<item>& items) {
+        std::vector<int> out;
+        for (const auto& i : items) out.push_back(i.get_id());
+        return out;
+    }
+};
+
+TEST_F(ItemScreenTest, ClassifiesEveryKind) {
+    const pack_limits limits{10, 50.0};
+    EXPECT_EQ(classify_item<default_constraints>(item(1, 100, 2, 1.5), limits), item_class::VALID);
+    EXPECT_EQ(classify_item<default_constraints>(item(2, 100, 2, 0.0), limits), item_class::ZERO_WEIGHT);
+    EXPECT_EQ(classify_item<default_constraints>(item(3, 100, 2, -4.0), limits), item_class::ZERO_WEIGHT);
+    EXPECT_EQ(classify_item<default_constraints>(item(4, 100, 2, std::nan("")), limits),
+              item_class::ZERO_WEIGHT);
+    EXPECT_EQ(classify_item<default_constraints>(item(5, 100, 2, 50.0), limits), item_class::VALID);
+    EXPECT_EQ(classify_item<default_constraints>(item(6, 100, 2, std::nextafter(50.0, 100.0)), limits),
+              item_class::OVERSIZE);
+    EXPECT_EQ(classify_item<default_constraints>(item(7, 100, 0, 1.0), limits), item_class::INVALID);
+    // Quantity is checked first: a non-positive quantity is invalid whatever its weight
+    EXPECT_EQ(classify_item<default_constraints>(item(8, 100, -3, 500.0), limits), item_class::INVALID);
+}
+
+TEST_F(ItemScreenTest, OptionalLimitsMakeItemsOversize) {
+    pack_limits limits{10, 50.0};
+    limits.max_length = 200;
+    limits.max_volume = 2.0;
+    EXPECT_EQ(classify_item<extended_constraints>(item(1, 200, 1, 1.0, 2.0f), limits), item_class::VALID);
+    EXPECT_EQ(classify_item<extended_constraints>(item(2, 201, 1, 1.0), limits), item_class::OVERSIZE);
+    EXPECT_EQ(classify_item<extended_constraints>(item(3, 100, 1, 1.0, 2.5f), limits), item_class::OVERSIZE);
+}
+
+TEST_F(ItemScreenTest, CompactsInOrderAndCounts) {
+    std::vector<item> items = {
+        item(1, 10, 4, 1.0), item(2, 10, 0, 1.0), item(3, 10, 5, 99.0), item(4, 10, 6, 0.0),
+        item(5, 10, -2, 1.0), item(6, 10, 7, 2.0),
+    };
+    const auto diagnostics = screen_items(items, pack_limits{10, 50.0});
+
+    EXPECT_EQ(ids(items), (std::vector<int>{1, 4, 6}));
+    EXPECT_EQ(diagnostics.count(item_class::VALID), 2u);
+    EXPECT_EQ(diagnostics.count(item_class::ZERO_WEIGHT), 1u);
+    EXPECT_EQ(diagnostics.count(item_class::OVERSIZE), 1u);
+    EXPECT_EQ(diagnostics.count(item_class::INVALID), 2u);
+    EXPECT_EQ(diagnostics.unit_count(item_class::VALID), 11);
+    EXPECT_EQ(diagnostics.unit_count(item_class::OVERSIZE), 5);
+    EXPECT_EQ(diagnostics.unit_count(item_class::INVALID), 0);
+    EXPECT_EQ(diagnostics.examples[static_cast<std::size_t>(item_class::INVALID)], (std::vector<int>{2, 5}));
+    EXPECT_TRUE(diagnostics.examples[static_cast<std::size_t>(item_class::VALID)].empty());
+    EXPECT_EQ(diagnostics.dropped(), 3u);
+    EXPECT_FALSE(diagnostics.clean());
+
+    std::ostringstream report;
+    output_input_diagnostics(diagnostics, report);
+    EXPECT_NE(report.str().find("Dropped oversize items: 1 (5 units), e.g. IDs 3"), std::string::npos);
+    EXPECT_NE(report.str().find("Dropped invalid items: 2 (0 units), e.g. IDs 2 5"), std::string::npos);
+}
+
+TEST_F(ItemScreenTest, KeepsAFewExampleIds) {
+    std::vector<item> items;
+    for (int i = 0; i < 100; ++i) items.emplace_back(i + 1, 10, 0, 1.0);
+    const auto diagnostics = screen_items(items, pack_limits{10, 50.0});
+
+    EXPECT_TRUE(items.empty());
+    EXPECT_EQ(diagnostics.count(item_class::INVALID), 100u);
+    EXPECT_EQ(diagnostics.examples[static_cast<std::size_t>(item_class::INVALID)],
+              (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST_F(ItemScreenTest, PlannerMatchesUnscreenedStrategyAndReportsDrops) {
+    pack_planner_config config;
+    // Loose enough that no strategy reaches its pack cap, which scales with the item count
+    config.max_items_per_pack = 50;
+    config.max_weight_per_pack = 200.0;
+    config.order = sort_order::SHORT_TO_LONG;
+    std::vector<item> items;
+    for (int i = 0; i < 3000; ++i) {
+        // Every 5th item too heavy, every 7th without units, every 11th weightless
+        const double weight = i % 5 == 0 ? 250.0 : i % 11 == 0 ? 0.0 : 0.5 + (i % 9);
+        items.emplace_back(i + 1, 1 + (i * 37) % 900, i % 7 == 0 ? 0 : 1 + i % 6, weight);
+    }
+
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);
+
+    std::vector<item> sorted = items;
+    pack_planner::sort_items(sorted, config.order);
+    blocking_pack_strategy blocking;
+    const auto expected = blocking.pack_items(sorted, config.max_items_per_pack, config.max_weight_per_pack);
+
+    ASSERT_EQ(result.packs.size(), expected.size());
+    for (std::size_t p = 0; p < expected.size(); ++p) {
+        ASSERT_EQ(ids(result.packs[p].get_items()), ids(expected[p].get_items()));
+        EXPECT_EQ(result.packs[p].get_total_weight(), expected[p].get_total_weight());
+    }
+
+    std::size_t oversize = 0, invalid = 0;
+    int requested = 0;
+    for (int i = 0; i < 3000; ++i) {
+        invalid += i % 7 == 0;
+        oversize += i % 7 != 0 && i % 5 == 0;
+        requested += i % 7 == 0 ? 0 : 1 + i % 6;
+    }
+    EXPECT_EQ(result.diagnostics.count(item_class::OVERSIZE), oversize);
+    EXPECT_EQ(result.diagnostics.count(item_class::INVALID), invalid);
+    EXPECT_GT(result.diagnostics.count(item_class::ZERO_WEIGHT), 0u);
+    EXPECT_EQ(result.total_items, requested);   // dropped oversize units still count as requested
+}
+
+TEST_F(ItemScreenTest, PackCapsCountTheDroppedLines) {
+    // 20000 lines, 18000 of them without units: the cap stays at 20000 / 10 + 1000 = 3000 packs,
+    // not the 1200 that the 2000 kept lines would give, while 4000 single-unit packs are needed
+    std::vector<item> items;
+    for (int i = 0; i < 20000; ++i) {
+        items.emplace_back(i + 1, 10, i % 10 == 0 ? 2 : 0, 1.0);
+    }
+    pack_planner_config config;
+    config.max_items_per_pack = 1;
+    config.max_weight_per_pack = 10.0;
+
+    const auto expected = blocking_pack_strategy().pack_items(items, 1, 10.0);
+    ASSERT_EQ(expected.size(), 3000u);
+
+    pack_planner planner;
+    for (auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::PARALLEL_FIRST_FIT}) {
+        config.type = type;
+        const auto result = planner.plan_packs(config, items);
+        EXPECT_EQ(result.diagnostics.lines(), 20000u);
+        EXPECT_EQ(result.packs.size(), expected.size());
+    }
+
+    config.type = strategy_type::BLOCKING_FIRST_FIT;
+    const auto batched = planner.plan_orders(config, {items, items});
+    ASSERT_EQ(batched.size(), 2u);
+    EXPECT_EQ(batched[0].packs.size(), expected.size());
+    EXPECT_EQ(batched[1].packs.size(), expected.size());
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "item_sort.h"
+
+// Item Sort Tests
+namespace {
+
+std::vector<int> ids_of(const std::vector<item>& items) {
+    std::vector<int> ids;
+    for (const auto& i : items) ids.push_back(i.get_id());
+    return ids;
+}
+
+std::vector<item> random_items(std::size_t count, int max_length, int weight_steps) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> length_dist(-5, max_length);   // lengths below 1 sort as 1
+    std::uniform_int_distribution<> weight_dist(-2, weight_steps);
+    std::vector<item> items;
+    for (std::size_t i = 0; i < count; ++i) {
+        items.emplace_back(static_cast<int>(i), length_dist(gen), 1, weight_dist(gen) * 0.25);
+    }
+    return items;
+}
+
+} // namespace
+
+TEST(ItemSortTest, ParsesAndNamesEveryOrder) {
+    EXPECT_EQ(parse_sort_order("HEAVY_TO_LIGHT"), sort_order::HEAVY_TO_LIGHT);
+    EXPECT_EQ(parse_sort_order("SHORT_TO_LONG_HEAVY_FIRST"), sort_order::SHORT_TO_LONG_HEAVY_FIRST);
+    EXPECT_EQ(parse_sort_order("LONG_TO_SHORT_HEAVY_FIRST"), sort_order::LONG_TO_SHORT_HEAVY_FIRST);
+    EXPECT_EQ(sort_order_to_string(sort_order::HEAVY_TO_LIGHT), "HTL");
+    EXPECT_EQ(sort_order_to_string(sort_order::SHORT_TO_LONG_HEAVY_FIRST), "STLH");
+    EXPECT_EQ(sort_order_to_string(sort_order::LONG_TO_SHORT_HEAVY_FIRST), "LTSH");
+}
+
+TEST(ItemSortTest, HeavyToLightIsStable) {
+    std::vector<item> items = {item(1, 10, 1, 2.0), item(2, 20, 1, 5.0), item(3, 30, 1, 2.0),
+                               item(4, 40, 1, -1.0), item(5, 50, 1, 5.0), item(6, 60, 1, 0.0)};
+    item_sort::sort(items, sort_order::HEAVY_TO_LIGHT);
+    // Negative weights pack as 0, so they tie with weightless items
+    EXPECT_EQ(ids_of(items), (std::vector<int>{2, 5, 1, 3, 4, 6}));
+}
+
+TEST(ItemSortTest, CompositeOrdersBreakLengthTiesByWeight) {
+    const std::vector<item> input = {item(1, 300, 1, 1.0), item(2, 100, 1, 1.0), item(3, 300, 1, 4.0),
+                                     item(4, 100, 1, 9.0), item(5, 300, 1, 4.0)};
+    std::vector<item> items = input;
+    item_sort::sort(items, sort_order::SHORT_TO_LONG_HEAVY_FIRST);
+    EXPECT_EQ(ids_of(items), (std::vector<int>{4, 2, 3, 5, 1}));
+
+    items = input;
+    item_sort::sort(items, sort_order::LONG_TO_SHORT_HEAVY_FIRST);
+    EXPECT_EQ(ids_of(items), (std::vector<int>{3, 5, 1, 4, 2}));
+}
+
+TEST(ItemSortTest, RadixPathMatchesStableComparisonSort) {
+    for (const int max_length : {40, 70000, 1 << 30}) {
+        const auto input = random_items(5000, max_length, 40);
+        for (const sort_order order : {sort_order::SHORT_TO_LONG, sort_order::LONG_TO_SHORT,
+                                       sort_order::HEAVY_TO_LIGHT, sort_order::SHORT_TO_LONG_HEAVY_FIRST,
+                                       sort_order::LONG_TO_SHORT_HEAVY_FIRST}) {
+            std::vector<item> expected = input;
+            std::stable_sort(expected.begin(), expected.end(), [order](const item& a, const item& b) {
+                return item_sort::precedes(order, a.get_length(), a.get_weight(),
+                                           b.get_length(), b.get_weight());
+            });
+            std::vector<item> actual = input;
+            item_sort::sort(actual, order);
+            EXPECT_EQ(ids_of(actual), ids_of(expected)) << sort_order_to_string(order) << " " << max_length;
+        }
+    }
+}
+
+TEST(ItemSortTest, NaturalKeepsInputOrder) {
+    const auto input = random_items(1000, 100, 10);
+    std::vector<item> items = input;
+    item_sort::sort(items, sort_order::NATURAL);
+    EXPECT_EQ(ids_of(items), ids_of(input));
+}
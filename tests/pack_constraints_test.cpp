@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "pack_constraints.h"
+#include "pack_cursor.h"
+#include "pack_planner.h"
+#include "pack_validator.h"
+
+// Pack Constraint Tests
+namespace {
+
+std::vector<item> mixed_items(int count) {
+    std::vector<item> items;
+    items.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        items.emplace_back(i + 1, 100 + (i * 37) % 900, 1 + i % 13, 0.5 + (i % 7) * 0.75,
+                           0.25f + static_cast<float>(i % 5));
+    }
+    return items;
+}
+
+int total_units(const std::vector<pack>& packs) {
+    int units = 0;
+    for (const auto& p : packs) units += p.get_total_items();
+    return units;
+}
+
+} // namespace
+
+TEST(PackConstraintsTest, FitIsTheMinimumOverTheList) {
+    const pack_limits limits{10, 20.0, 500, 6.0};
+    const pack_totals totals{4, 12.0, 1.0};
+    const unit_offer offer{300, 8, 2.0, 2.0};
+
+    EXPECT_EQ(item_count_constraint::fit(totals, offer, limits), 6);
+    EXPECT_EQ(weight_constraint::fit(totals, offer, limits), 4);
+    EXPECT_EQ(length_constraint::fit(totals, offer, limits), 8);
+    EXPECT_EQ(volume_constraint::fit(totals, offer, limits), 2);
+
+    EXPECT_EQ(default_constraints::fit(totals, offer, limits), 4);
+    EXPECT_EQ(extended_constraints::fit(totals, offer, limits), 2);
+    EXPECT_EQ(extended_constraints::fit(totals, unit_offer{501, 8, 2.0, 2.0}, limits), 0);
+}
+
+TEST(PackConstraintsTest, OptionalLimitsAreOffAtZero) {
+    const pack_limits limits{10, 20.0};
+    EXPECT_FALSE(limits.has_extended());
+    const unit_offer huge{1 << 30, 3, 1.0, 1e12};
+    EXPECT_TRUE(extended_constraints::admits(huge, limits));
+    EXPECT_EQ(extended_constraints::fit(pack_totals{0, 0.0, 0.0}, huge, limits), 3);
+}
+
+TEST(PackConstraintsTest, ExtendedListMatchesDefaultWithoutOptionalLimits) {
+    const auto items = mixed_items(3000);
+    pack_planner_config config;
+    config.max_items_per_pack = 25;
+    config.max_weight_per_pack = 40.0;
+
+    blocking_pack_strategy strategy;
+    const auto expected = strategy.pack_items(items, config.max_items_per_pack, config.max_weight_per_pack);
+
+    pack_cursor cursor(items, config.limits());
+    cursor.run();
+    const auto& actual = cursor.packs();
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t p = 0; p < actual.size(); ++p) {
+        EXPECT_EQ(actual[p].get_total_items(), expected[p].get_total_items());
+        EXPECT_DOUBLE_EQ(actual[p].get_total_weight(), expected[p].get_total_weight());
+    }
+}
+
+TEST(PackConstraintsTest, LengthAndVolumeLimitsHoldOnEveryEngine) {
+    const auto items = mixed_items(6000);   // enough for pff to split into chunks
+    pack_planner_config config;
+    config.max_items_per_pack = 60;
+    config.max_weight_per_pack = 120.0;
+    config.max_length_per_pack = 800;
+    config.max_volume_per_pack = 80.0;
+
+    int skipped_units = 0;
+    for (const auto& i : items) {
+        if (i.get_length() > config.max_length_per_pack) skipped_units += i.get_quantity();
+    }
+    ASSERT_GT(skipped_units, 0);
+
+    for (const strategy_type type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::PARALLEL_FIRST_FIT}) {
+        config.type = type;
+        config.thread_count = 4;
+        pack_planner planner;
+        const auto result = planner.plan_packs(config, items);
+
+        for (const auto& p : result.packs) {
+            EXPECT_LE(p.get_total_items(), config.max_items_per_pack);
+            EXPECT_LE(p.get_total_weight(), config.max_weight_per_pack + 1e-9);
+            EXPECT_LE(p.get_pack_length(), config.max_length_per_pack);
+            EXPECT_LE(p.get_total_volume(), config.max_volume_per_pack + 1e-9);
+        }
+        EXPECT_EQ(total_units(result.packs), result.total_items - skipped_units);
+
+        const validation_report report = pack_validator().validate(config, items, result);
+        EXPECT_TRUE(report.ok()) << (report.issues.empty() ? "" : report.issues.front().message);
+        EXPECT_GT(report.unpackable_items, 0u);
+    }
+}
+
+TEST(PackConstraintsTest, ValidatorReportsLengthViolations) {
+    const std::vector<item> items = {item(1, 900, 2, 1.0), item(2, 100, 3, 1.0)};
+    pack_planner_config config;
+    config.order = sort_order::NATURAL;
+
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);   // planned without a length limit
+
+    config.max_length_per_pack = 500;
+    const validation_report report = pack_validator().validate(config, items, result);
+    ASSERT_FALSE(report.ok());
+    EXPECT_EQ(report.issues.front().type, validation_issue::kind::LENGTH_LIMIT);
+}
+
+TEST(PackConstraintsTest, ValidatorReportsVolumeViolations) {
+    const std::vector<item> items = {item(1, 100, 4, 1.0, 1.0f), item(2, 100, 2, 1.0, 0.5f)};
+    pack_planner_config config;
+    config.order = sort_order::NATURAL;
+
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);   // planned without a volume limit
+
+    config.max_volume_per_pack = 2.5;
+    const validation_report report = pack_validator().validate(config, items, result);
+    ASSERT_FALSE(report.ok());
+    EXPECT_EQ(report.issues.front().type, validation_issue::kind::VOLUME_LIMIT);
+
+    config.max_volume_per_pack = 5.0;
+    EXPECT_TRUE(pack_validator().validate(config, items, result).ok());
+}
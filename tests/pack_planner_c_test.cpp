@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "pack_planner.h"
+#include "pack_planner_c.h"
+#include "plan_columns.h"
+
+// C ABI Tests
+class PackPlannerCTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 300; ++i) {
+            ids.push_back(i + 1);
+            lengths.push_back(10 + (i * 53) % 700);
+            quantities.push_back(1 + i % 11);
+            weights.push_back(0.25 + (i % 9) * 0.5);
+        }
+        planner = pack_planner_create();
+        ASSERT_NE(planner, nullptr);
+        pack_planner_options_init(&options);
+        options.max_items_per_pack = 15;
+        options.max_weight_per_pack = 40.0;
+    }
+
+    void TearDown() override { pack_planner_destroy(planner); }
+
+    pack_planner_plan* plan() {
+        pack_planner_plan* out = nullptr;
+        EXPECT_EQ(pack_planner_plan_columns(planner, &options, ids.data(), lengths.data(),
+                                            quantities.data(), weights.data(), ids.size(), &out),
+                  PACK_PLANNER_OK);
+        return out;
+    }
+
+    std::vector<int32_t> ids, lengths, quantities;
+    std::vector<double> weights;
+    pack_planner_handle* planner = nullptr;
+    pack_planner_options options{};
+};
+
+TEST_F(PackPlannerCTest, MatchesTheEngine) {
+    for (int32_t strategy = 0; strategy <= 3; ++strategy) {
+        options.strategy = strategy;
+        options.sort_order = strategy % 3;
+        pack_planner_plan* result = plan();
+        ASSERT_NE(result, nullptr);
+
+        pack_planner_config config;
+        config.type = static_cast<strategy_type>(strategy);
+        config.order = static_cast<sort_order>(strategy % 3);
+        config.max_items_per_pack = 15;
+        config.max_weight_per_pack = 40.0;
+        std::vector<item> items;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            items.emplace_back(ids[i], lengths[i], quantities[i], weights[i]);
+        }
+        pack_planner engine;
+        plan_columns expected;
+        expected.assign(engine.plan_packs(config, items));
+
+        pack_planner_columns columns{};
+        ASSERT_EQ(pack_planner_plan_get_columns(result, &columns), PACK_PLANNER_OK);
+        ASSERT_EQ(columns.pack_count, expected.pack_count());
+        ASSERT_EQ(columns.item_count, expected.item_count());
+        EXPECT_EQ(std::vector<uint32_t>(columns.pack_offsets, columns.pack_offsets + columns.pack_count + 1),
+                  expected.pack_offsets);
+        EXPECT_EQ(std::vector<int32_t>(columns.item_ids, columns.item_ids + columns.item_count),
+                  expected.item_ids);
+        EXPECT_EQ(std::vector<int32_t>(columns.item_quantities, columns.item_quantities + columns.item_count),
+                  expected.item_quantities);
+
+        pack_planner_stats stats{};
+        ASSERT_EQ(pack_planner_plan_stats(result, &stats), PACK_PLANNER_OK);
+        EXPECT_EQ(stats.total_items, expected.total_quantity());
+        EXPECT_FALSE(std::string(pack_planner_plan_strategy_name(result)).empty());
+
+        pack_planner_plan_free(result);
+    }
+}
+
+TEST_F(PackPlannerCTest, PassesLengthAndVolumeLimits) {
+    std::vector<float> volumes;
+    for (size_t i = 0; i < ids.size(); ++i) volumes.push_back(0.1f + static_cast<float>(i % 5) * 0.2f);
+    options.max_length_per_pack = 600;
+    options.max_volume_per_pack = 3.0;
+
+    pack_planner_plan* result = nullptr;
+    ASSERT_EQ(pack_planner_plan_columns_with_volume(planner, &options, ids.data(), lengths.data(),
+                                                    quantities.data(), weights.data(), volumes.data(),
+                                                    ids.size(), &result),
+              PACK_PLANNER_OK);
+
+    pack_planner_config config;
+    config.max_items_per_pack = 15;
+    config.max_weight_per_pack = 40.0;
+    config.max_length_per_pack = 600;
+    config.max_volume_per_pack = 3.0;
+    std::vector<item> items;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        items.emplace_back(ids[i], lengths[i], quantities[i], weights[i], volumes[i]);
+    }
+    pack_planner engine;
+    plan_columns expected;
+    expected.assign(engine.plan_packs(config, items));
+
+    pack_planner_columns columns{};
+    ASSERT_EQ(pack_planner_plan_get_columns(result, &columns), PACK_PLANNER_OK);
+    ASSERT_EQ(columns.pack_count, expected.pack_count());
+    EXPECT_EQ(std::vector<int32_t>(columns.item_ids, columns.item_ids + columns.item_count), expected.item_ids);
+    EXPECT_EQ(std::vector<float>(columns.item_volumes, columns.item_volumes + columns.item_count),
+              expected.item_volumes);
+    for (size_t j = 0; j < columns.item_count; ++j) {
+        EXPECT_LE(columns.item_lengths[j], 600);
+    }
+    pack_planner_plan_free(result);
+}
+
+TEST_F(PackPlannerCTest, IteratesPacksAndLines) {
+    pack_planner_plan* result = plan();
+    ASSERT_NE(result, nullptr);
+
+    size_t lines = 0;
+    for (size_t p = 0; p < pack_planner_plan_pack_count(result); ++p) {
+        pack_planner_pack_info info{};
+        ASSERT_EQ(pack_planner_plan_pack(result, p, &info), PACK_PLANNER_OK);
+        EXPECT_EQ(info.first_item, lines);
+
+        int quantity = 0;
+        double weight = 0.0;
+        for (uint32_t k = 0; k < info.item_count; ++k) {
+            pack_planner_item_line line{};
+            ASSERT_EQ(pack_planner_plan_item(result, info.first_item + k, &line), PACK_PLANNER_OK);
+            quantity += line.quantity;
+            weight += line.quantity * line.weight;
+        }
+        EXPECT_LE(quantity, options.max_items_per_pack);
+        EXPECT_NEAR(weight, info.total_weight, 1e-9);
+        lines += info.item_count;
+    }
+    EXPECT_EQ(lines, pack_planner_plan_item_count(result));
+
+    pack_planner_pack_info info{};
+    EXPECT_EQ(pack_planner_plan_pack(result, pack_planner_plan_pack_count(result), &info),
+              PACK_PLANNER_OUT_OF_RANGE);
+    pack_planner_item_line line{};
+    EXPECT_EQ(pack_planner_plan_item(result, lines, &line), PACK_PLANNER_OUT_OF_RANGE);
+    EXPECT_STREQ(pack_planner_last_error(), "item index out of range");
+
+    pack_planner_plan_free(result);
+}
+
+TEST_F(PackPlannerCTest, RejectsInvalidArguments) {
+    pack_planner_plan* out = nullptr;
+    EXPECT_EQ(pack_planner_plan_columns(planner, &options, nullptr, lengths.data(), quantities.data(),
+                                        weights.data(), ids.size(), &out),
+              PACK_PLANNER_INVALID_ARGUMENT);
+    EXPECT_EQ(out, nullptr);
+
+    options.strategy = 7;
+    EXPECT_EQ(pack_planner_plan_columns(planner, &options, ids.data(), lengths.data(), quantities.data(),
+                                        weights.data(), ids.size(), &out),
+              PACK_PLANNER_INVALID_ARGUMENT);
+    EXPECT_STREQ(pack_planner_last_error(), "unknown strategy");
+
+    EXPECT_EQ(pack_planner_plan_columns(planner, &options, nullptr, nullptr, nullptr, nullptr, 0, nullptr),
+              PACK_PLANNER_INVALID_ARGUMENT);
+    EXPECT_EQ(pack_planner_plan_stats(nullptr, nullptr), PACK_PLANNER_INVALID_ARGUMENT);
+    EXPECT_EQ(pack_planner_plan_pack_count(nullptr), 0u);
+    pack_planner_plan_free(nullptr);
+    pack_planner_destroy(nullptr);
+}
+
+TEST_F(PackPlannerCTest, ChecksOptionsStructSize) {
+    pack_planner_plan* out = nullptr;
+    pack_planner_options unset = options;
+    unset.struct_size = 0;
+    EXPECT_EQ(pack_planner_plan_columns(planner, &unset, nullptr, nullptr, nullptr, nullptr, 0, &out),
+              PACK_PLANNER_INVALID_ARGUMENT);
+
+    pack_planner_options future = options;
+    future.reserved[2] = 1;
+    EXPECT_EQ(pack_planner_plan_columns(planner, &future, nullptr, nullptr, nullptr, nullptr, 0, &out),
+              PACK_PLANNER_INVALID_ARGUMENT);
+    EXPECT_EQ(out, nullptr);
+
+    // A newer caller's larger struct is fine while its extra fields stay zero
+    struct {
+        pack_planner_options base;
+        uint64_t appended;
+    } larger{options, 0};
+    larger.base.struct_size = sizeof(larger);
+    ASSERT_EQ(pack_planner_plan_columns(planner, &larger.base, nullptr, nullptr, nullptr, nullptr, 0, &out),
+              PACK_PLANNER_OK);
+    pack_planner_plan_free(out);
+    larger.appended = 5;
+    EXPECT_EQ(pack_planner_plan_columns(planner, &larger.base, nullptr, nullptr, nullptr, nullptr, 0, &out),
+              PACK_PLANNER_INVALID_ARGUMENT);
+}
+
+TEST_F(PackPlannerCTest, EmptyRequestAndVersion) {
+    EXPECT_EQ(pack_planner_abi_version(), static_cast<uint32_t>(PACK_PLANNER_ABI_VERSION));
+
+    pack_planner_plan* out = nullptr;
+    ASSERT_EQ(pack_planner_plan_columns(planner, &options, nullptr, nullptr, nullptr, nullptr, 0, &out),
+              PACK_PLANNER_OK);
+    EXPECT_EQ(pack_planner_plan_pack_count(out), 0u);
+    EXPECT_EQ(pack_planner_plan_item_count(out), 0u);
+    pack_planner_plan_free(out);
+}
+
+TEST_F(PackPlannerCTest, PlansOutliveTheirPlanner) {
+    pack_planner_plan* result = plan();
+    ASSERT_NE(result, nullptr);
+    const size_t packs = pack_planner_plan_pack_count(result);
+
+    pack_planner_destroy(planner);
+    planner = nullptr;
+
+    EXPECT_EQ(pack_planner_plan_pack_count(result), packs);
+    pack_planner_pack_info info{};
+    EXPECT_EQ(pack_planner_plan_pack(result, 0, &info), PACK_PLANNER_OK);
+    pack_planner_plan_free(result);
+}
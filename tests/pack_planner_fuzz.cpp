@@ -0,0 +1,56 @@
+// libFuzzer target: differential check of every strategy and kernel against the
+// reference packer (built with -DPACK_PLANNER_FUZZ=ON).
+//
+//   ./pack_planner_fuzz -max_len=60000 corpus/
+//
+// Without Clang the target links a small driver instead, which replays the
+// files given on the command line or, with none, runs random inputs.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "differential_harness.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    const auto c = differential::decode_case(data, size);
+    const auto outcome = differential::check_case(c);
+    if (!outcome.mismatch.empty()) {
+        std::fprintf(stderr, "Mismatch (%zu items): %s\n", c.items.size(), outcome.mismatch.c_str());
+        std::abort();
+    }
+    return 0;
+}
+
+#ifdef PACK_PLANNER_FUZZ_STANDALONE
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        for (int a = 1; a < argc; ++a) {
+            std::ifstream file(argv[a], std::ios::binary);
+            if (!file) {
+                std::fprintf(stderr, "Cannot read %s\n", argv[a]);
+                return 1;
+            }
+            const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                                  std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+        }
+        std::printf("Replayed %d inputs\n", argc - 1);
+        return 0;
+    }
+
+    std::mt19937 rng(std::random_device{}());
+    constexpr int RUNS = 2000;
+    for (int run = 0; run < RUNS; ++run) {
+        std::vector<std::uint8_t> bytes(rng() % 4096);
+        for (auto& b : bytes) b = static_cast<std::uint8_t>(rng());
+        LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+    }
+    std::printf("%d random inputs matched the reference\n", RUNS);
+    return 0;
+}
+#endif
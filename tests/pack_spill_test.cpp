@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "pack_planner.h"
+#include "pack_spill.h"
+
+// Pack Spill Tests
+class PackSpillTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> length_dist(50, 5000);
+        std::uniform_int_distribution<int> quantity_dist(1, 60);
+        std::uniform_real_distribution<double> weight_dist(0.1, 12.0);
+
+        for (int i = 0; i < 20000; ++i) {
+            items.emplace_back(i + 1, length_dist(rng), quantity_dist(rng), weight_dist(rng));
+        }
+
+        config.order = sort_order::NATURAL;
+        config.max_items_per_pack = 40;
+        config.max_weight_per_pack = 120.0;
+        config.type = strategy_type::BLOCKING_FIRST_FIT;
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+};
+
+TEST_F(PackSpillTest, RoundTrip) {
+    pack_spill spill;
+    ASSERT_TRUE(spill.is_open());
+
+    pack p1(1);
+    (void)p1.add_partial_item(1, 100, 5, 2.5, 10, 25.0);
+    (void)p1.add_partial_item(2, 300, 2, 0.3, 10, 25.0);
+    pack p2(2);
+    (void)p2.add_partial_item(3, 50, 9, 1.1, 10, 25.0);
+
+    EXPECT_TRUE(spill.write(p1));
+    EXPECT_TRUE(spill.write(p2));
+    EXPECT_EQ(spill.pack_count(), 2u);
+    EXPECT_EQ(spill.non_empty_count(), 2u);
+    EXPECT_DOUBLE_EQ(spill.total_weight(), p1.get_total_weight() + p2.get_total_weight());
+
+    std::vector<pack> read_back;
+    EXPECT_TRUE(spill.for_each([&](const pack& p) { read_back.push_back(p); }));
+    ASSERT_EQ(read_back.size(), 2u);
+    EXPECT_EQ(read_back[0].to_string(), p1.to_string());
+    EXPECT_EQ(read_back[1].to_string(), p2.to_string());
+    EXPECT_EQ(read_back[0].get_total_weight(), p1.get_total_weight());
+    EXPECT_EQ(read_back[0].get_pack_length(), 300);
+
+    // Appending after a read keeps the earlier records
+    EXPECT_TRUE(spill.write(p1));
+    int count = 0;
+    EXPECT_TRUE(spill.for_each([&](const pack&) { ++count; }));
+    EXPECT_EQ(count, 3);
+}
+
+TEST_F(PackSpillTest, BudgetedPlanMatchesUnbudgeted) {
+    pack_planner planner;
+    auto reference = planner.plan_packs(config, items);
+    ASSERT_EQ(reference.spill, nullptr);
+
+    config.memory_budget_bytes = 16 * 1024;
+    auto budgeted = planner.plan_packs(config, items);
+
+    ASSERT_NE(budgeted.spill, nullptr);
+    EXPECT_GT(budgeted.spill->pack_count(), 0u);
+    EXPECT_LT(budgeted.packs.size(), reference.packs.size());
+    EXPECT_EQ(budgeted.pack_count(), reference.pack_count());
+    EXPECT_EQ(budgeted.total_items, reference.total_items);
+    EXPECT_DOUBLE_EQ(budgeted.utilization_percent, reference.utilization_percent);
+
+    std::ostringstream expected, actual;
+    planner.output_results(reference, expected);
+    planner.output_results(budgeted, actual);
+    EXPECT_EQ(actual.str(), expected.str());
+}
+
+TEST_F(PackSpillTest, BudgetLargerThanPlanDoesNotSpill) {
+    pack_planner planner;
+    config.memory_budget_bytes = std::size_t{1} << 30;
+    auto result = planner.plan_packs(config, items);
+
+    EXPECT_EQ(result.spill, nullptr);
+    EXPECT_GT(result.packs.size(), 1u);
+}
+
+TEST_F(PackSpillTest, ParallelStrategyIgnoresBudget) {
+    pack_planner planner;
+    config.type = strategy_type::PARALLEL_FIRST_FIT;
+    config.memory_budget_bytes = 1024;
+    auto result = planner.plan_packs(config, items);
+
+    EXPECT_EQ(result.spill, nullptr);
+    EXPECT_EQ(result.pack_count(), result.packs.size());
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <climits>
 #include "pack.h"
 
 // Pack Class Tests
@@ -140,6 +141,16 @@ TEST_F(PackTest, AddPartialItemZeroCase) {
     EXPECT_EQ(added, 0);
 }
 
+TEST_F(PackTest, AddPartialItemTinyWeightHugeQuantity) {
+    // remaining weight / unit weight exceeds INT_MAX: the item limit must still apply
+    EXPECT_EQ(pack1.add_partial_item(7, 10, INT_MAX, 1e-9, default_max_items, default_max_weight),
+              default_max_items);
+
+    pack pack2(2);
+    EXPECT_EQ(pack2.add_partial_item(8, 10, INT_MAX, 1e-9, INT_MAX, default_max_weight), INT_MAX);
+    EXPECT_NEAR(pack2.get_total_weight(), INT_MAX * 1e-9, 1e-9);
+}
+
 TEST_F(PackTest, IsFull) {
     EXPECT_FALSE(pack1.is_full(default_max_items, default_max_weight));
 
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "pack_planner.h"
+#include "pack_validator.h"
+#include "plan_columns.h"
+
+// Pack Validator Tests
+class PackValidatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 5000; ++i) {
+            items.emplace_back(i + 1, 10 + (i * 37) % 900, 1 + i % 9, 0.5 + (i % 7) * 0.75);
+        }
+        config.max_items_per_pack = 25;
+        config.max_weight_per_pack = 60.0;
+        config.order = sort_order::SHORT_TO_LONG;
+    }
+
+    plan_columns planned() {
+        pack_planner planner;
+        plan_columns columns;
+        columns.assign(planner.plan_packs(config, items));
+        return columns;
+    }
+
+    static bool has_issue(const validation_report& report, validation_issue::kind type) {
+        for (const auto& issue : report.issues) {
+            if (issue.type == type) return true;
+        }
+        return false;
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+    pack_validator validator;
+};
+
+TEST_F(PackValidatorTest, AcceptsPlannerOutput) {
+    for (auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::PARALLEL_FIRST_FIT}) {
+        for (auto order : {sort_order::NATURAL, sort_order::SHORT_TO_LONG, sort_order::LONG_TO_SHORT}) {
+            config.type = type;
+            config.order = order;
+            pack_planner planner;
+            const auto report = validator.validate(config, items, planner.plan_packs(config, items));
+            EXPECT_TRUE(report.ok()) << (report.issues.empty() ? "" : report.issues.front().message);
+            EXPECT_GT(report.packs_checked, 0u);
+            EXPECT_GE(report.lines_checked, report.packs_checked);
+        }
+    }
+}
+
+TEST_F(PackValidatorTest, AcceptsSpilledPlans) {
+    config.memory_budget_bytes = 4096;
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);
+    ASSERT_NE(result.spill, nullptr);
+    EXPECT_TRUE(validator.validate(config, items, result).ok());
+}
+
+TEST_F(PackValidatorTest, DetectsItemAndWeightLimits) {
+    auto columns = planned();
+    config.max_items_per_pack = 5;
+    config.max_weight_per_pack = 10.0;
+
+    const auto report = validator.validate(config, items, columns);
+    EXPECT_FALSE(report.ok());
+    EXPECT_TRUE(has_issue(report, validation_issue::kind::ITEM_LIMIT));
+    EXPECT_TRUE(has_issue(report, validation_issue::kind::WEIGHT_LIMIT));
+}
+
+TEST_F(PackValidatorTest, DetectsLostAndDuplicatedUnits) {
+    auto columns = planned();
+    columns.item_quantities[3] -= 1;
+
+    auto report = validator.validate(config, items, columns);
+    ASSERT_FALSE(report.ok());
+    EXPECT_TRUE(has_issue(report, validation_issue::kind::PACK_TOTALS));  // its pack weight no longer adds up
+    bool reported = false;
+    for (const auto& issue : report.issues) {
+        if (issue.type == validation_issue::kind::QUANTITY_MISMATCH) {
+            EXPECT_EQ(issue.item_id, columns.item_ids[3]);
+            reported = true;
+        }
+    }
+    EXPECT_TRUE(reported);
+
+    columns = planned();
+    columns.item_ids[0] = columns.item_ids[1];
+    report = validator.validate(config, items, columns);
+    EXPECT_EQ(report.issue_count, 2u);  // one id short, one id over
+}
+
+TEST_F(PackValidatorTest, DetectsSortOrderAndPackTotals) {
+    auto columns = planned();
+    std::swap(columns.item_lengths[10], columns.item_lengths[40]);
+    auto report = validator.validate(config, items, columns);
+    EXPECT_TRUE(has_issue(report, validation_issue::kind::SORT_ORDER));
+
+    columns = planned();
+    columns.pack_weights[2] += 1.0;
+    report = validator.validate(config, items, columns);
+    EXPECT_TRUE(has_issue(report, validation_issue::kind::PACK_TOTALS));
+}
+
+TEST_F(PackValidatorTest, UnpackableItemsAreExpectedToBeLeftOut) {
+    items.emplace_back(99999, 50, 3, 500.0);
+    config.order = sort_order::NATURAL;
+    pack_planner planner;
+    const auto report = validator.validate(config, items, planner.plan_packs(config, items));
+    EXPECT_TRUE(report.ok());
+    EXPECT_EQ(report.unpackable_items, 1u);
+}
+
+TEST_F(PackValidatorTest, CapsReportedIssues) {
+    auto columns = planned();
+    for (auto& q : columns.item_quantities) q += 1;
+
+    const auto report = pack_validator(4).validate(config, items, columns);
+    EXPECT_EQ(report.issues.size(), 4u);
+    EXPECT_GT(report.issue_count, 4u);
+}
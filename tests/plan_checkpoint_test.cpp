@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "blocking_pack_strategy.h"
+#include "pack_planner.h"
+#include "plan_checkpoint.h"
+
+// Plan Checkpoint Tests
+class PlanCheckpointTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+                ("pack_planner_checkpoint_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                 "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin")).string();
+        std::remove(path.c_str());
+
+        for (int i = 0; i < 20000; ++i) {
+            items.emplace_back(i + 1, 10 + (i * 7919) % 5000, 1 + (i * 31) % 9, 0.25 + (i % 13) * 0.75);
+        }
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    // Checkpoint every 500 placement steps
+    std::unique_ptr<plan_checkpoint> make_checkpoint(bool resume) const {
+        return std::make_unique<plan_checkpoint>(path, resume, std::chrono::milliseconds(0), 500);
+    }
+
+    // Every pack of a run, spilled ones first
+    static std::vector<pack> all_packs(std::vector<pack> packs, const pack_spill& spill) {
+        std::vector<pack> out;
+        spill.for_each([&](const pack& p) { out.push_back(p); });
+        std::move(packs.begin(), packs.end(), std::back_inserter(out));
+        return out;
+    }
+
+    static void expect_same_packs(const std::vector<pack>& actual, const std::vector<pack>& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t p = 0; p < expected.size(); ++p) {
+            EXPECT_EQ(actual[p].to_string(), expected[p].to_string());
+            EXPECT_EQ(actual[p].get_total_weight(), expected[p].get_total_weight());
+        }
+    }
+
+    std::string read_file() const {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    }
+
+    void write_file(const std::string& bytes) const {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(),
+                                                                      static_cast<std::streamsize>(bytes.size()));
+    }
+
+    std::string path;
+    std::vector<item> items;
+    const pack_limits limits{7, 25.0};
+};
+
+TEST_F(PlanCheckpointTest, UninterruptedRunMatchesBlocking) {
+    const auto expected = blocking_pack_strategy().pack_items(items, limits);
+
+    auto checkpoint = make_checkpoint(false);
+    pack_spill spill;
+    const auto packs = checkpoint->pack_items(items, limits, 0, spill);
+
+    ASSERT_FALSE(checkpoint->has_error());
+    EXPECT_FALSE(checkpoint->resumed());
+    EXPECT_GT(checkpoint->checkpoints_written(), 10u);
+    EXPECT_EQ(items.size(), 20000u);   // handed back to the caller
+    expect_same_packs(packs, expected);
+}
+
+TEST_F(PlanCheckpointTest, ResumesFromAnyInterruption) {
+    const auto expected = blocking_pack_strategy().pack_items(items, limits);
+    {
+        pack_spill spill;
+        (void)make_checkpoint(false)->pack_items(items, limits, 0, spill);
+    }
+    const std::string full = read_file();
+
+    // Cut the file anywhere, as a preempted write would, including mid-entry
+    for (std::size_t cut : {std::size_t{0}, std::size_t{10}, full.size() / 7, full.size() / 3 + 5,
+                            full.size() / 2 + 1, full.size() - 3, full.size()}) {
+        SCOPED_TRACE(cut);
+        write_file(full.substr(0, cut));
+
+        auto checkpoint = make_checkpoint(true);
+        pack_spill spill;
+        const auto packs = checkpoint->pack_items(items, limits, 0, spill);
+
+        ASSERT_FALSE(checkpoint->has_error());
+        EXPECT_EQ(checkpoint->resumed(), cut >= full.size() / 7);   // the first state entry is near the start
+        expect_same_packs(packs, expected);
+    }
+}
+
+TEST_F(PlanCheckpointTest, ResumesUnderAMemoryBudget) {
+    const auto expected = blocking_pack_strategy().pack_items(items, limits);
+    {
+        pack_spill spill;
+        (void)make_checkpoint(false)->pack_items(items, limits, 0, spill);
+    }
+    const std::string full = read_file();
+    write_file(full.substr(0, full.size() / 2));
+
+    auto checkpoint = make_checkpoint(true);
+    pack_spill spill;
+    auto packs = checkpoint->pack_items(items, limits, 16 * 1024, spill);
+
+    ASSERT_FALSE(checkpoint->has_error());
+    EXPECT_TRUE(checkpoint->resumed());
+    EXPECT_GT(spill.pack_count(), 0u);
+    expect_same_packs(all_packs(std::move(packs), spill), expected);
+}
+
+TEST_F(PlanCheckpointTest, RefusesCheckpointOfOtherInput) {
+    {
+        pack_spill spill;
+        (void)make_checkpoint(false)->pack_items(items, limits, 0, spill);
+    }
+    items[123] = item(124, 10, 2, 1.0);
+
+    auto checkpoint = make_checkpoint(true);
+    pack_spill spill;
+    EXPECT_TRUE(checkpoint->pack_items(items, limits, 0, spill).empty());
+    EXPECT_TRUE(checkpoint->has_error());
+    EXPECT_NE(checkpoint->error_message().find("different input"), std::string::npos);
+    EXPECT_EQ(items.size(), 20000u);
+}
+
+TEST_F(PlanCheckpointTest, PlannerOutputIsUnchangedAndResumable) {
+    pack_planner_config config;
+    config.max_items_per_pack = limits.max_items;
+    config.max_weight_per_pack = limits.max_weight;
+    config.order = sort_order::LONG_TO_SHORT;
+
+    pack_planner plain;
+    std::ostringstream expected;
+    plain.output_results(plain.plan_packs(config, items), expected);
+
+    // First run writes checkpoints; a resumed second run from half of them gives the same text
+    pack_planner first;
+    auto checkpoint = std::make_shared<plan_checkpoint>(path, false, std::chrono::milliseconds(0), 500);
+    first.set_checkpoint(checkpoint);
+    std::ostringstream first_output;
+    first.output_results(first.plan_packs(config, items), first_output);
+    EXPECT_EQ(first_output.str(), expected.str());
+    checkpoint.reset();
+
+    const std::string full = read_file();
+    write_file(full.substr(0, full.size() / 2));
+
+    pack_planner second;
+    checkpoint = std::make_shared<plan_checkpoint>(path, true, std::chrono::milliseconds(0), 500);
+    second.set_checkpoint(checkpoint);
+    std::ostringstream second_output;
+    second.output_results(second.plan_packs(config, items), second_output);
+    EXPECT_TRUE(checkpoint->resumed());
+    EXPECT_EQ(second_output.str(), expected.str());
+
+    EXPECT_TRUE(checkpoint->remove());
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
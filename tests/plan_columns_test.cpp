@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "pack_planner.h"
+#include "plan_columns.h"
+
+// Plan Columns Tests
+class PlanColumnsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 200; ++i) {
+            items.emplace_back(i + 1, 10 + (i * 37) % 500, 1 + i % 9, 0.5 + (i % 7) * 0.75);
+        }
+        config.max_items_per_pack = 12;
+        config.max_weight_per_pack = 30.0;
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+};
+
+TEST_F(PlanColumnsTest, MatchesPacks) {
+    pack_planner planner;
+    auto result = planner.plan_packs(config, items);
+
+    plan_columns columns;
+    columns.assign(result);
+
+    ASSERT_EQ(columns.pack_offsets.size(), columns.pack_count() + 1);
+    EXPECT_EQ(columns.pack_offsets.front(), 0u);
+    EXPECT_EQ(columns.pack_offsets.back(), columns.item_count());
+
+    std::size_t p = 0;
+    for (const auto& original : result.packs) {
+        if (original.is_empty()) continue;
+        ASSERT_LT(p, columns.pack_count());
+
+        EXPECT_EQ(columns.pack_numbers[p], original.get_pack_number());
+        EXPECT_EQ(columns.pack_lengths[p], original.get_pack_length());
+        EXPECT_EQ(columns.pack_weights[p], original.get_total_weight());
+
+        const auto& original_items = original.get_items();
+        ASSERT_EQ(columns.pack_offsets[p + 1] - columns.pack_offsets[p], original_items.size());
+        for (std::size_t k = 0; k < original_items.size(); ++k) {
+            const std::size_t at = columns.pack_offsets[p] + k;
+            EXPECT_EQ(columns.item_ids[at], original_items[k].get_id());
+            EXPECT_EQ(columns.item_lengths[at], original_items[k].get_length());
+            EXPECT_EQ(columns.item_quantities[at], original_items[k].get_quantity());
+            EXPECT_EQ(columns.item_weights[at], original_items[k].get_weight());
+        }
+        ++p;
+    }
+    EXPECT_EQ(p, columns.pack_count());
+
+    double weight = 0.0;
+    for (const auto& original : result.packs) weight += original.get_total_weight();
+    EXPECT_NEAR(columns.total_weight(), weight, 1e-6);
+    EXPECT_EQ(columns.total_quantity(), result.total_items);
+}
+
+TEST_F(PlanColumnsTest, IncludesSpilledPacksInOrder) {
+    pack_planner planner;
+    auto reference = planner.plan_packs(config, items);
+
+    config.memory_budget_bytes = 512;
+    auto budgeted = planner.plan_packs(config, items);
+    ASSERT_NE(budgeted.spill, nullptr);
+
+    plan_columns expected, actual;
+    expected.assign(reference);
+    actual.assign(budgeted);
+
+    EXPECT_EQ(actual.pack_offsets, expected.pack_offsets);
+    EXPECT_EQ(actual.pack_numbers, expected.pack_numbers);
+    EXPECT_EQ(actual.item_ids, expected.item_ids);
+    EXPECT_EQ(actual.item_quantities, expected.item_quantities);
+}
+
+TEST_F(PlanColumnsTest, ReassignReplacesContents) {
+    pack_planner planner;
+    plan_columns columns;
+    columns.assign(planner.plan_packs(config, items));
+
+    columns.assign(planner.plan_packs(config, {item(1, 100, 2, 1.0)}));
+    EXPECT_EQ(columns.pack_count(), 1u);
+    EXPECT_EQ(columns.item_count(), 1u);
+    EXPECT_EQ(columns.pack_offsets, (std::vector<std::uint32_t>{0, 1}));
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "plan_cost_model.h"
+
+// Plan Cost Model Tests
+TEST(PlanCostModelTest, FitsLinearSamplesExactly) {
+    plan_cost_model model;
+    for (std::size_t n : {1000u, 2000u, 4000u, 8000u}) {
+        model.add_sample(strategy_type::BLOCKING_FIRST_FIT, n, 0.5 + 0.002 * n);
+    }
+    model.fit();
+
+    const plan_cost* cost = model.cost(strategy_type::BLOCKING_FIRST_FIT);
+    ASSERT_NE(cost, nullptr);
+    EXPECT_NEAR(cost->fixed_ms, 0.5, 1e-9);
+    EXPECT_NEAR(cost->ms_per_item, 0.002, 1e-12);
+    EXPECT_EQ(cost->samples, 4u);
+    EXPECT_NEAR(*model.predict_ms(strategy_type::BLOCKING_FIRST_FIT, 100000), 200.5, 1e-6);
+}
+
+TEST(PlanCostModelTest, UncalibratedStrategyHasNoPrediction) {
+    plan_cost_model model;
+    model.add_sample(strategy_type::BLOCKING_FIRST_FIT, 1000, 1.0);
+    model.fit();
+
+    EXPECT_EQ(model.cost(strategy_type::PARALLEL_BEST_FIT), nullptr);
+    EXPECT_FALSE(model.predict_ms(strategy_type::PARALLEL_BEST_FIT, 1000).has_value());
+    EXPECT_EQ(model.fastest(1000), strategy_type::BLOCKING_FIRST_FIT);
+
+    model.clear();
+    EXPECT_FALSE(model.fastest(1000).has_value());
+}
+
+TEST(PlanCostModelTest, NoisySamplesNeverPredictNegativeLatency) {
+    plan_cost_model model;
+    // A single size: rate through the origin
+    model.add_sample(strategy_type::BLOCKING_BEST_FIT, 2000, 4.0);
+    model.add_sample(strategy_type::BLOCKING_BEST_FIT, 2000, 6.0);
+    // Downward slope from timer noise
+    model.add_sample(strategy_type::PARALLEL_FIRST_FIT, 1000, 3.0);
+    model.add_sample(strategy_type::PARALLEL_FIRST_FIT, 4000, 2.0);
+    // Steep slope that would put the intercept below zero
+    model.add_sample(strategy_type::PARALLEL_BEST_FIT, 1000, 0.1);
+    model.add_sample(strategy_type::PARALLEL_BEST_FIT, 2000, 10.0);
+    model.fit();
+
+    EXPECT_NEAR(model.cost(strategy_type::BLOCKING_BEST_FIT)->ms_per_item, 10.0 / 4000, 1e-12);
+    for (auto type : {strategy_type::BLOCKING_BEST_FIT, strategy_type::PARALLEL_FIRST_FIT,
+                      strategy_type::PARALLEL_BEST_FIT}) {
+        const plan_cost* cost = model.cost(type);
+        ASSERT_NE(cost, nullptr);
+        EXPECT_GE(cost->fixed_ms, 0.0);
+        EXPECT_GE(cost->ms_per_item, 0.0);
+        EXPECT_GE(*model.predict_ms(type, 1), 0.0);
+    }
+}
+
+TEST(PlanCostModelTest, CalibrationMeasuresThePlanner) {
+    plan_cost_model model;
+    model.calibrate({strategy_type::BLOCKING_FIRST_FIT}, {500, 2000, 8000}, 2);
+
+    const plan_cost* cost = model.cost(strategy_type::BLOCKING_FIRST_FIT);
+    ASSERT_NE(cost, nullptr);
+    EXPECT_EQ(cost->samples, 3u);
+    EXPECT_FALSE(model.predict_ms(strategy_type::PARALLEL_FIRST_FIT, 1000).has_value());
+    EXPECT_LE(*model.predict_ms(strategy_type::BLOCKING_FIRST_FIT, 1000),
+              *model.predict_ms(strategy_type::BLOCKING_FIRST_FIT, 1000000));
+}
+
+TEST(PlanCostModelTest, CalibrationItemsAreDeterministic) {
+    const auto first = plan_cost_model::calibration_items(100, 7);
+    const auto second = plan_cost_model::calibration_items(100, 7);
+    ASSERT_EQ(first.size(), 100u);
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(first[i].get_length(), second[i].get_length());
+        EXPECT_EQ(first[i].get_quantity(), second[i].get_quantity());
+        EXPECT_EQ(first[i].get_weight(), second[i].get_weight());
+    }
+}
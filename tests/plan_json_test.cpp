@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "pack_planner.h"
+#include "plan_json.h"
+
+// Plan JSON Tests
+class PlanJsonTest : public ::testing::Test {
+protected:
+    static pack_planner_result single_pack_result() {
+        pack p(7);
+        (void)p.add_item(item(1, 120, 2, 1.5), 100, 200.0);
+        (void)p.add_item(item(2, 80, 1, 0.1), 100, 200.0);
+
+        pack_planner_result result;
+        result.packs.push_back(p);
+        result.packs.emplace_back(8);   // empty packs are not written
+        result.sorting_time = 0.25;
+        result.packing_time = 1.0;
+        result.total_time = 1.25;
+        result.total_items = 3;
+        result.utilization_percent = 1.55;
+        result.strategy_name = "Blocking \"First\" Fit";
+        return result;
+    }
+
+    static std::string write(const pack_planner_result& result, output_format format) {
+        std::ostringstream out;
+        write_plan_json(result, out, format);
+        return out.str();
+    }
+};
+
+TEST_F(PlanJsonTest, WritesDocument) {
+    EXPECT_EQ(write(single_pack_result(), output_format::JSON),
+              "{\"packs\":[{\"packNumber\":7,\"packLength\":120,\"totalItems\":3,\"totalWeight\":3.1,"
+              "\"items\":[{\"id\":1,\"length\":120,\"quantity\":2,\"weight\":1.5,\"totalWeight\":3},"
+              "{\"id\":2,\"length\":80,\"quantity\":1,\"weight\":0.1,\"totalWeight\":0.1}]}],"
+              "\"metrics\":{\"sortingTimeMs\":0.25,\"packingTimeMs\":1,\"totalTimeMs\":1.25,"
+              "\"totalItems\":3,\"utilizationPercent\":1.55,"
+              "\"strategyUsed\":\"Blocking \\\"First\\\" Fit\",\"packCount\":1,"
+              "\"input\":{\"valid\":0,\"zeroWeight\":{\"items\":0,\"units\":0,\"exampleIds\":[]},"
+              "\"oversize\":{\"items\":0,\"units\":0,\"exampleIds\":[]},"
+              "\"invalid\":{\"items\":0,\"units\":0,\"exampleIds\":[]}}}}\n");
+}
+
+TEST_F(PlanJsonTest, WritesOnePackPerLine) {
+    pack_planner_config config;
+    config.max_items_per_pack = 5;
+    std::vector<item> items;
+    for (int i = 0; i < 40; ++i) items.emplace_back(i + 1, 10 + i, 3, 0.5);
+
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);
+    std::istringstream lines(write(result, output_format::NDJSON));
+
+    std::string line;
+    std::size_t packs = 0;
+    while (std::getline(lines, line) && line.rfind("{\"packNumber\":", 0) == 0) {
+        EXPECT_EQ(line.back(), '}');
+        ++packs;
+    }
+    EXPECT_EQ(packs, result.pack_count());
+    EXPECT_EQ(line.rfind("{\"metrics\":{", 0), 0u);
+    EXPECT_NE(line.find("\"packCount\":" + std::to_string(packs) + ","), std::string::npos);
+    EXPECT_FALSE(std::getline(lines, line));
+}
+
+TEST_F(PlanJsonTest, DoublesRoundTripAndNonFiniteIsNull) {
+    auto result = single_pack_result();
+    result.packs.front() = pack(1);
+    const double weight = 0.1 + 0.2;   // needs 17 significant digits
+    (void)result.packs.front().add_item(item(3, 1, 1, weight), 100, 200.0);
+    result.utilization_percent = std::numeric_limits<double>::quiet_NaN();
+
+    const std::string json = write(result, output_format::JSON);
+    const auto at = json.find("\"weight\":") + 9;
+    EXPECT_EQ(std::strtod(json.c_str() + at, nullptr), weight);
+    EXPECT_NE(json.find("\"utilizationPercent\":null"), std::string::npos);
+}
+
+TEST_F(PlanJsonTest, IncludesSpilledPacksAndVolumes) {
+    pack_planner_config config;
+    config.max_items_per_pack = 4;
+    config.memory_budget_bytes = 4096;
+    std::vector<item> items;
+    for (int i = 0; i < 2000; ++i) items.emplace_back(i + 1, 100, 2, 1.0, 0.5f);
+
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);
+    ASSERT_TRUE(result.spill);
+
+    const std::string json = write(result, output_format::JSON);
+    EXPECT_NE(json.find("\"packCount\":" + std::to_string(result.pack_count()) + ","), std::string::npos);
+    EXPECT_NE(json.find("\"totalVolume\":2,"), std::string::npos);
+    EXPECT_NE(json.find("\"volume\":0.5}"), std::string::npos);
+}
+
+TEST_F(PlanJsonTest, ParsesFormatNames) {
+    EXPECT_EQ(parse_output_format("json"), output_format::JSON);
+    EXPECT_EQ(parse_output_format("ndjson"), output_format::NDJSON);
+    EXPECT_EQ(parse_output_format("text"), output_format::TEXT);
+    EXPECT_EQ(parse_output_format("xml"), output_format::TEXT);
+}
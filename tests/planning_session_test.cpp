@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "blocking_pack_strategy.h"
+#include "pack_cursor.h"
+#include "pack_planner.h"
+#include "planning_session.h"
+
+// Pack Cursor and Planning Session Tests
+class PlanningSessionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<int> length_dist(1, 2000);
+        std::uniform_int_distribution<int> quantity_dist(-2, 40);
+        std::uniform_real_distribution<double> weight_dist(0.1, 15.0);
+
+        for (int i = 0; i < 30000; ++i) {
+            items.emplace_back(i + 1, length_dist(rng), quantity_dist(rng), weight_dist(rng));
+        }
+        // An item heavier than any pack allows
+        items.emplace_back(999999, 10, 3, 500.0);
+
+        config.order = sort_order::LONG_TO_SHORT;
+        config.max_items_per_pack = 30;
+        config.max_weight_per_pack = 100.0;
+    }
+
+    static std::string render(const std::vector<pack>& packs) {
+        std::ostringstream out;
+        pack_planner().output_results(packs, out);
+        return out.str();
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+};
+
+TEST_F(PlanningSessionTest, CursorIncrementsMatchBlocking) {
+    blocking_pack_strategy blocking;
+    const auto expected = blocking.pack_items(items, config.max_items_per_pack, config.max_weight_per_pack);
+
+    for (size_t increment : {size_t{1}, size_t{7}, size_t{1000}}) {
+        pack_cursor cursor(items, config.max_items_per_pack, config.max_weight_per_pack);
+        while (!cursor.done()) {
+            EXPECT_GT(cursor.advance(increment), 0u);
+        }
+        EXPECT_DOUBLE_EQ(cursor.progress(), 1.0);
+        EXPECT_EQ(cursor.packs().size(), expected.size());
+        EXPECT_EQ(render(cursor.packs()), render(expected));
+    }
+}
+
+TEST_F(PlanningSessionTest, CursorRespectsStepBudget) {
+    pack_cursor cursor(items, config.max_items_per_pack, config.max_weight_per_pack);
+    EXPECT_EQ(cursor.advance(10), 10u);
+    EXPECT_FALSE(cursor.done());
+    EXPECT_LE(cursor.position(), 10u);
+    EXPECT_GT(cursor.progress(), 0.0);
+    EXPECT_LT(cursor.progress(), 1.0);
+}
+
+TEST_F(PlanningSessionTest, SlicedSessionMatchesPlanPacks) {
+    pack_planner planner;
+    auto expected = planner.plan_packs(config, items);
+
+    planning_session session(config, items);
+    EXPECT_FALSE(session.done());
+    EXPECT_DOUBLE_EQ(session.progress(), 0.0);
+    while (!session.step(0.05)) {
+        EXPECT_LE(session.progress(), 1.0);
+    }
+    EXPECT_GE(session.steps(), 1u);
+
+    auto result = session.result();
+    EXPECT_EQ(result.total_items, expected.total_items);
+    EXPECT_DOUBLE_EQ(result.utilization_percent, expected.utilization_percent);
+    EXPECT_EQ(render(result.packs), render(expected.packs));
+}
+
+TEST_F(PlanningSessionTest, ResultFinishesPendingWork) {
+    planning_session session(config, items);
+    auto result = session.result();
+    EXPECT_TRUE(session.done());
+    EXPECT_GT(result.packs.size(), 1u);
+    EXPECT_GE(result.total_time, result.sorting_time);
+}
+
+TEST_F(PlanningSessionTest, EmptyInput) {
+    planning_session session(config, {});
+    EXPECT_TRUE(session.step(1.0));
+    auto result = session.result();
+    EXPECT_EQ(result.total_items, 0);
+    EXPECT_EQ(result.packs.size(), 1u);
+    EXPECT_TRUE(result.packs.front().is_empty());
+}
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "pack_planner.h"
+#include "request_trace.h"
+
+// Request Trace Tests
+class RequestTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+                ("pack_planner_trace_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                 "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin")).string();
+        std::remove(path.c_str());
+
+        items = {
+            item(1, 300, 4, 2.5),
+            item(2, 100, 10, 1.0),
+            item(3, 200, 3, 7.25),
+        };
+        config.order = sort_order::SHORT_TO_LONG;
+        config.max_items_per_pack = 6;
+        config.max_weight_per_pack = 20.0;
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    std::string path;
+    std::vector<item> items;
+    pack_planner_config config;
+};
+
+TEST_F(RequestTraceTest, CaptureRoundTrip) {
+    pack_planner planner;
+    auto capture = std::make_shared<request_capture>(path);
+    ASSERT_TRUE(capture->is_open());
+    planner.set_capture(capture);
+
+    auto result = planner.plan_packs(config, items);
+    config.type = strategy_type::PARALLEL_FIRST_FIT;
+    (void)planner.plan_packs(config, items);
+    capture->wait_idle();
+    EXPECT_EQ(capture->captured(), 2u);
+    EXPECT_EQ(capture->dropped(), 0u);
+
+    trace_reader reader(path);
+    ASSERT_TRUE(reader.is_open());
+
+    trace_record record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.order, sort_order::SHORT_TO_LONG);
+    EXPECT_EQ(record.type, strategy_type::BLOCKING_FIRST_FIT);
+    EXPECT_EQ(record.max_items_per_pack, 6);
+    EXPECT_DOUBLE_EQ(record.max_weight_per_pack, 20.0);
+    EXPECT_DOUBLE_EQ(record.total_time, result.total_time);
+
+    // Items are recorded as submitted, not as sorted
+    ASSERT_EQ(record.items.size(), items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(record.items[i].to_string(), items[i].to_string());
+    }
+
+    const auto first_timestamp = record.timestamp_us;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.type, strategy_type::PARALLEL_FIRST_FIT);
+    EXPECT_GE(record.timestamp_us, first_timestamp);
+
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_FALSE(reader.has_error());
+}
+
+TEST_F(RequestTraceTest, AppendsAcrossInstances) {
+    pack_planner planner;
+    for (int run = 0; run < 2; ++run) {
+        planner.set_capture(std::make_shared<request_capture>(path));
+        (void)planner.plan_packs(config, items);
+    }
+    planner.set_capture(nullptr);
+
+    trace_reader reader(path);
+    trace_record record;
+    int count = 0;
+    while (reader.next(record)) ++count;
+    EXPECT_EQ(count, 2);
+    EXPECT_FALSE(reader.has_error());
+}
+
+TEST_F(RequestTraceTest, SampleRateZeroRecordsNothing) {
+    pack_planner planner;
+    auto capture = std::make_shared<request_capture>(path, 0.0);
+    planner.set_capture(capture);
+
+    for (int i = 0; i < 10; ++i) {
+        (void)planner.plan_packs(config, items);
+    }
+    EXPECT_EQ(capture->captured(), 0u);
+}
+
+TEST_F(RequestTraceTest, ReplayReportsEveryRequest) {
+    {
+        pack_planner planner;
+        planner.set_capture(std::make_shared<request_capture>(path));
+        for (int i = 0; i < 5; ++i) {
+            (void)planner.plan_packs(config, items);
+        }
+    }
+
+    replay_options options;
+    options.strategy = strategy_type::PARALLEL_FIRST_FIT;
+    auto report = replay_trace(path, options);
+    ASSERT_TRUE(report.has_value());
+    EXPECT_EQ(report->requests, 5u);
+    EXPECT_EQ(report->total_items, 5 * 17);
+    EXPECT_FALSE(report->trace_error);
+    EXPECT_GE(report->replayed.max, report->replayed.p50);
+
+    std::ostringstream output;
+    output_replay_report(*report, output);
+    EXPECT_NE(output.str().find("Requests: 5"), std::string::npos);
+}
+
+TEST_F(RequestTraceTest, TruncatedTraceIsReported) {
+    {
+        request_capture capture(path);
+        pack_planner planner;
+        auto result = planner.plan_packs(config, items);
+        ASSERT_TRUE(capture.record(config, items, result));
+        ASSERT_TRUE(capture.record(config, items, result));
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 5);
+
+    auto report = replay_trace(path, replay_options{});
+    ASSERT_TRUE(report.has_value());
+    EXPECT_EQ(report->requests, 1u);
+    EXPECT_TRUE(report->trace_error);
+}
+
+TEST_F(RequestTraceTest, FullQueueDropsInsteadOfBlocking) {
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);
+    std::size_t queued = 0;
+    {
+        request_capture capture(path, 1.0, 0, 1);
+        for (int i = 0; i < 200; ++i) {
+            queued += capture.record(config, items, result) ? 1 : 0;
+        }
+        capture.wait_idle();
+        EXPECT_EQ(capture.captured(), queued);
+        EXPECT_EQ(capture.captured() + capture.dropped(), 200u);
+    }
+
+    auto report = replay_trace(path, replay_options{});
+    ASSERT_TRUE(report.has_value());
+    EXPECT_EQ(report->requests, queued);
+    EXPECT_FALSE(report->trace_error);
+}
+
+TEST_F(RequestTraceTest, RecordsLengthAndVolumeLimits) {
+    config.max_length_per_pack = 250;
+    config.max_volume_per_pack = 3.5;
+    items.emplace_back(4, 120, 2, 1.5, 0.75f);
+    {
+        pack_planner planner;
+        planner.set_capture(std::make_shared<request_capture>(path));
+        (void)planner.plan_packs(config, items);
+    }
+
+    trace_reader reader(path);
+    trace_record record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.max_length_per_pack, 250);
+    EXPECT_DOUBLE_EQ(record.max_volume_per_pack, 3.5);
+    ASSERT_EQ(record.items.size(), items.size());
+    EXPECT_DOUBLE_EQ(record.items[3].get_volume(), 0.75);
+}
+
+TEST_F(RequestTraceTest, ReadsVersion1Traces) {
+    {
+        // Magic, then one version 1 record: header without length/volume, items without volume
+        std::ofstream file(path, std::ios::binary);
+        file.write("PPTRACE1", 8);
+        auto put = [&](const auto& value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        put(std::uint64_t{42});
+        put(std::uint8_t{static_cast<std::uint8_t>(sort_order::LONG_TO_SHORT)});
+        put(std::uint8_t{static_cast<std::uint8_t>(strategy_type::BLOCKING_FIRST_FIT)});
+        put(std::uint16_t{0});
+        put(std::int32_t{4});
+        put(std::int32_t{6});
+        put(20.0);
+        put(std::uint64_t{0});
+        put(1.0);
+        put(2.0);
+        put(3.0);
+        put(std::uint32_t{2});
+        for (int id : {7, 8}) {
+            put(std::int32_t{id});
+            put(std::int32_t{100 * id});
+            put(std::int32_t{id + 1});
+            put(1.25 * id);
+        }
+    }
+
+    trace_reader reader(path);
+    ASSERT_TRUE(reader.is_open());
+    trace_record record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.timestamp_us, 42u);
+    EXPECT_EQ(record.order, sort_order::LONG_TO_SHORT);
+    EXPECT_EQ(record.max_items_per_pack, 6);
+    EXPECT_EQ(record.max_length_per_pack, 0);
+    EXPECT_DOUBLE_EQ(record.max_volume_per_pack, 0.0);
+    EXPECT_DOUBLE_EQ(record.total_time, 3.0);
+    ASSERT_EQ(record.items.size(), 2u);
+    EXPECT_EQ(record.items[1].get_id(), 8);
+    EXPECT_EQ(record.items[1].get_length(), 800);
+    EXPECT_DOUBLE_EQ(record.items[1].get_weight(), 10.0);
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_FALSE(reader.has_error());
+
+    // A newer capture does not append to it
+    EXPECT_FALSE(request_capture(path).is_open());
+}
+
+TEST_F(RequestTraceTest, ItemCountBeyondFileIsMalformed) {
+    {
+        // A header claiming far more items than the file holds must not be allocated for
+        std::ofstream file(path, std::ios::binary);
+        file.write("PPTRACE2", 8);
+        auto put = [&](const auto& value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        put(std::uint64_t{42});
+        put(std::uint8_t{0});
+        put(std::uint8_t{0});
+        put(std::uint16_t{0});
+        put(std::int32_t{4});
+        put(std::int32_t{6});
+        put(20.0);
+        put(std::uint64_t{0});
+        put(1.0);
+        put(2.0);
+        put(3.0);
+        put(std::int32_t{0});
+        put(0.0);
+        put(std::uint32_t{1u << 29});
+        put(std::int32_t{1});
+    }
+
+    trace_reader reader(path);
+    ASSERT_TRUE(reader.is_open());
+    trace_record record;
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_TRUE(reader.has_error());
+}
+
+TEST_F(RequestTraceTest, RejectsForeignFile) {
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a trace";
+    }
+    EXPECT_FALSE(trace_reader(path).is_open());
+    EXPECT_FALSE(replay_trace(path, replay_options{}).has_value());
+}
+
+TEST(LatencySummaryTest, NearestRankPercentiles) {
+    std::vector<double> latencies;
+    for (int i = 100; i >= 1; --i) latencies.push_back(i);
+
+    auto summary = summarize_latencies(latencies);
+    EXPECT_DOUBLE_EQ(summary.mean, 50.5);
+    EXPECT_DOUBLE_EQ(summary.p50, 50.0);
+    EXPECT_DOUBLE_EQ(summary.p90, 90.0);
+    EXPECT_DOUBLE_EQ(summary.p99, 99.0);
+    EXPECT_DOUBLE_EQ(summary.max, 100.0);
+
+    std::vector<double> empty;
+    EXPECT_DOUBLE_EQ(summarize_latencies(empty).max, 0.0);
+}
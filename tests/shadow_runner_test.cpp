@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "pack_planner.h"
+#include "shadow_runner.h"
+
+// Shadow Runner Tests
+class ShadowRunnerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> length_dist(10, 1000);
+        std::uniform_int_distribution<int> quantity_dist(1, 30);
+        std::uniform_real_distribution<double> weight_dist(0.5, 8.0);
+
+        for (int i = 0; i < 8000; ++i) {
+            items.emplace_back(i + 1, length_dist(rng), quantity_dist(rng), weight_dist(rng));
+        }
+
+        config.order = sort_order::SHORT_TO_LONG;
+        config.max_items_per_pack = 25;
+        config.max_weight_per_pack = 90.0;
+        config.type = strategy_type::BLOCKING_FIRST_FIT;
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+};
+
+TEST_F(ShadowRunnerTest, SameStrategyHasNoQualityDelta) {
+    pack_planner planner;
+    auto shadow = std::make_shared<shadow_runner>(strategy_type::BLOCKING_FIRST_FIT);
+    planner.set_shadow(shadow);
+
+    for (int i = 0; i < 3; ++i) {
+        (void)planner.plan_packs(config, items);
+    }
+    shadow->wait_idle();
+
+    const auto metrics = shadow->snapshot();
+    EXPECT_EQ(metrics.submitted, 3u);
+    EXPECT_EQ(metrics.completed + metrics.dropped, 3u);
+    EXPECT_GT(metrics.completed, 0u);
+    EXPECT_EQ(metrics.pack_count_delta, 0);
+    EXPECT_DOUBLE_EQ(metrics.mean_utilization_delta(), 0.0);
+    EXPECT_EQ(metrics.candidate_fewer_packs, 0u);
+}
+
+TEST_F(ShadowRunnerTest, CandidateKeepsLengthAndVolumeLimits) {
+    // Volume makes packs close far earlier than units or weight would (few items, so no pack cap)
+    items.erase(items.begin() + 500, items.end());
+    for (auto& i : items) {
+        i = item(i.get_id(), i.get_length(), i.get_quantity(), i.get_weight(), 0.5f);
+    }
+    config.max_length_per_pack = 1000;
+    config.max_volume_per_pack = 4.0;
+
+    pack_planner planner;
+    auto shadow = std::make_shared<shadow_runner>(strategy_type::BLOCKING_FIRST_FIT);
+    planner.set_shadow(shadow);
+    (void)planner.plan_packs(config, items);
+    shadow->wait_idle();
+
+    const auto metrics = shadow->snapshot();
+    ASSERT_EQ(metrics.completed, 1u);
+    EXPECT_EQ(metrics.pack_count_delta, 0);
+    EXPECT_DOUBLE_EQ(metrics.mean_utilization_delta(), 0.0);
+}
+
+TEST_F(ShadowRunnerTest, CandidateKeepsPackCapsOfScreenedRequest) {
+    // Most lines are too heavy and get dropped; the primary still sizes its pack cap
+    // from all 8000 lines, and one unit per pack runs into that cap
+    for (std::size_t i = 2000; i < items.size(); ++i) {
+        items[i] = item(items[i].get_id(), items[i].get_length(), items[i].get_quantity(), 1000.0);
+    }
+    config.max_items_per_pack = 1;
+
+    pack_planner planner;
+    auto shadow = std::make_shared<shadow_runner>(strategy_type::BLOCKING_FIRST_FIT);
+    planner.set_shadow(shadow);
+    (void)planner.plan_packs(config, items);
+    shadow->wait_idle();
+
+    const auto metrics = shadow->snapshot();
+    ASSERT_EQ(metrics.completed, 1u);
+    EXPECT_EQ(metrics.pack_count_delta, 0);
+}
+
+TEST_F(ShadowRunnerTest, ResponseIsUnaffected) {
+    pack_planner reference_planner;
+    auto reference = reference_planner.plan_packs(config, items);
+
+    pack_planner planner;
+    auto shadow = std::make_shared<shadow_runner>(strategy_type::PARALLEL_FIRST_FIT, 1.0, 4);
+    planner.set_shadow(shadow);
+    auto result = planner.plan_packs(config, items);
+
+    std::ostringstream expected, actual;
+    reference_planner.output_results(reference, expected);
+    planner.output_results(result, actual);
+    EXPECT_EQ(actual.str(), expected.str());
+    EXPECT_EQ(result.total_items, reference.total_items);
+
+    shadow->wait_idle();
+    const auto metrics = shadow->snapshot();
+    EXPECT_EQ(metrics.completed, 1u);
+    EXPECT_EQ(metrics.candidate_name, "Parallel(4 threads)");
+}
+
+TEST_F(ShadowRunnerTest, FullQueueDropsInsteadOfBlocking) {
+    shadow_runner shadow(strategy_type::BLOCKING_FIRST_FIT, 1.0, 1, 1);
+    pack_planner planner;
+    auto primary = planner.plan_packs(config, items);
+
+    std::size_t accepted = 0;
+    for (int i = 0; i < 50; ++i) {
+        accepted += shadow.submit(config.limits(), std::vector<item>(items), primary) ? 1 : 0;
+    }
+    shadow.wait_idle();
+
+    const auto metrics = shadow.snapshot();
+    EXPECT_EQ(metrics.submitted, 50u);
+    EXPECT_EQ(metrics.completed, accepted);
+    EXPECT_EQ(metrics.dropped, 50u - accepted);
+}
+
+TEST_F(ShadowRunnerTest, SampleRateZeroShadowsNothing) {
+    pack_planner planner;
+    auto shadow = std::make_shared<shadow_runner>(strategy_type::PARALLEL_FIRST_FIT, 0.0);
+    planner.set_shadow(shadow);
+
+    for (int i = 0; i < 5; ++i) {
+        (void)planner.plan_packs(config, items);
+    }
+    shadow->wait_idle();
+    EXPECT_EQ(shadow->snapshot().submitted, 0u);
+
+    std::ostringstream output;
+    output_shadow_metrics(shadow->snapshot(), output);
+    EXPECT_NE(output.str().find("0 evaluated"), std::string::npos);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "simd_kernels.h"
+
+// SIMD Kernel Tests (the scalar path natively, the SIMD128 path under -msimd128)
+TEST(SimdKernelsTest, SumPositiveSkipsNonPositive) {
+    for (std::size_t n : {0u, 1u, 3u, 4u, 5u, 17u, 1000u}) {
+        std::vector<std::int32_t> values(n);
+        long long expected = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            values[i] = static_cast<std::int32_t>(i % 7) - 2;
+            expected += std::max(0, values[i]);
+        }
+        EXPECT_EQ(simd_kernels::sum_positive(values.data(), n), expected) << "n=" << n;
+    }
+
+    // Totals beyond int32 must not wrap
+    std::vector<std::int32_t> big(8, INT_MAX);
+    EXPECT_EQ(simd_kernels::sum_positive(big.data(), big.size()), 8LL * INT_MAX);
+}
+
+TEST(SimdKernelsTest, SumMatchesPairwiseLanes) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+    for (std::size_t n : {0u, 1u, 2u, 3u, 101u}) {
+        std::vector<double> values(n);
+        for (auto& v : values) v = dist(rng);
+
+        double lane0 = 0.0, lane1 = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            (i % 2 == 0 ? lane0 : lane1) += values[i];
+        }
+        EXPECT_DOUBLE_EQ(simd_kernels::sum(values.data(), n), lane0 + lane1) << "n=" << n;
+        EXPECT_NEAR(simd_kernels::sum(values.data(), n),
+                    std::accumulate(values.begin(), values.end(), 0.0), 1e-9);
+    }
+}
+
+TEST(SimdKernelsTest, ExclusivePrefixSum) {
+    for (std::size_t n : {0u, 1u, 4u, 7u, 64u, 65u}) {
+        std::vector<std::uint32_t> values(n);
+        for (std::size_t i = 0; i < n; ++i) values[i] = static_cast<std::uint32_t>(i * 3 + 1);
+
+        std::vector<std::uint32_t> expected(n);
+        std::exclusive_scan(values.begin(), values.end(), expected.begin(), 0u);
+        const std::uint32_t total = std::accumulate(values.begin(), values.end(), 0u);
+
+        EXPECT_EQ(simd_kernels::exclusive_prefix_sum(values.data(), n), total) << "n=" << n;
+        EXPECT_EQ(values, expected) << "n=" << n;
+    }
+}
+
+TEST(SimdKernelsTest, SortKeysGiveStableOrder) {
+    const std::vector<std::int32_t> lengths = {5, -3, 5, INT_MAX, 0, INT_MIN, -3, 5, 2};
+
+    for (bool descending : {false, true}) {
+        std::vector<std::uint64_t> keys(lengths.size());
+        simd_kernels::build_sort_keys(lengths.data(), lengths.size(), descending, keys.data());
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<std::size_t> order;
+        for (auto k : keys) order.push_back(static_cast<std::uint32_t>(k));
+
+        std::vector<std::size_t> expected(lengths.size());
+        std::iota(expected.begin(), expected.end(), 0);
+        std::stable_sort(expected.begin(), expected.end(), [&](std::size_t a, std::size_t b) {
+            return descending ? lengths[a] > lengths[b] : lengths[a] < lengths[b];
+        });
+        EXPECT_EQ(order, expected) << "descending=" << descending;
+    }
+}
@@ -1,4 +1,5 @@
 import createModule from './pack_planner_wasm.js';
+import createProfiler from './pack_planner_profiler.js';
 
 const Module = await createModule(); // Top-level await is OK in .mjs
 const planner = new Module.PackPlanner();
@@ -37,4 +38,103 @@ console.log("\n📊 Stats:", {
 // Quick assertions
 if (typeof stats.totalItems !== 'number') throw new Error("Invalid stats object.");
 
+// Columnar typed-array input must plan exactly like the row input
+const ids = Int32Array.from(items, (it) => it[0]);
+const lengths = Int32Array.from(items, (it) => it[1]);
+const quantities = Int32Array.from(items, (it) => it[2]);
+const weights = Float64Array.from(items, (it) => it[3]);
+
+const columnarPacks = planner.packItemsColumnar(ids, lengths, quantities, weights, 10, 10.0, 0, 0, 4);
+if (columnarPacks.size() !== rawPacks.size()) throw new Error("Columnar pack count differs.");
+for (let i = 0; i < rawPacks.size(); i++) {
+  if (columnarPacks.get(i) !== rawPacks.get(i)) throw new Error(`Columnar pack ${i} differs.`);
+}
+
+const columnarStats = planner.getPlanningStatsColumnar(ids, lengths, quantities, weights, 10, 10.0, 0, 0, 4);
+if (columnarStats.totalItems !== stats.totalItems) throw new Error("Columnar stats differ.");
+
+// Caller-filled buffer inside the WASM heap
+const buffer = new Module.ItemBuffer(items.length);
+buffer.ids().set(ids);
+buffer.lengths().set(lengths);
+buffer.quantities().set(quantities);
+buffer.weights().set(weights);
+const bufferStats = planner.getPlanningStatsFromBuffer(buffer, 10, 10.0, 0, 0, 4);
+if (bufferStats.packCount !== stats.packCount) throw new Error("ItemBuffer stats differ.");
+buffer.delete();
+console.log("\n🧮 Columnar and ItemBuffer input match row input");
+
+// Single-call plan: stats and typed-array pack columns from one planning run
+const planned = planner.planColumnar(ids, lengths, quantities, weights, 10, 10.0, 0, 0, 4);
+if (planned.packCount !== rawPacks.size()) throw new Error("plan pack count differs.");
+if (planned.packOffsets.length !== planned.packCount + 1) throw new Error("Bad packOffsets length.");
+if (planned.packOffsets[planned.packCount] !== planned.itemIds.length) throw new Error("Bad packOffsets end.");
+if (planned.totalItems !== stats.totalItems) throw new Error("plan stats differ.");
+if (!rawPacks.get(0).startsWith(`Pack Number: ${planned.packNumbers[0]}`)) throw new Error("plan pack numbers differ.");
+console.log("\n📐 plan() columns:", {
+  packOffsets: Array.from(planned.packOffsets),
+  itemIds: Array.from(planned.itemIds),
+});
+
+// JSON written directly by the planner, as one document and as NDJSON lines
+const json = JSON.parse(planner.planJsonColumnar(ids, lengths, quantities, weights, 10, 10.0, 0, 0, 4, false));
+if (json.packs.length !== planned.packCount) throw new Error("planJson pack count differs.");
+if (json.packs[0].packNumber !== planned.packNumbers[0]) throw new Error("planJson pack numbers differ.");
+if (json.metrics.totalItems !== stats.totalItems) throw new Error("planJson metrics differ.");
+const lines = planner.planJsonColumnar(ids, lengths, quantities, weights, 10, 10.0, 0, 0, 4, true)
+  .trim().split('\n').map((line) => JSON.parse(line));
+if (lines.length !== planned.packCount + 1 || !lines[lines.length - 1].metrics) throw new Error("Bad NDJSON lines.");
+console.log("\n🧾 planJson():", json.metrics);
+
+// Time-sliced session reaches the same packs as a one-shot plan
+const sessionBuffer = new Module.ItemBuffer();
+sessionBuffer.assign(ids, lengths, quantities, weights);
+let rejected = false;
+try {
+  sessionBuffer.assign(ids, lengths.subarray(1), quantities, weights);
+} catch (e) {
+  rejected = e instanceof RangeError;
+}
+if (!rejected || sessionBuffer.size() !== ids.length) throw new Error("assign accepted unequal columns.");
+const session = new Module.PlanningSession(sessionBuffer, 10, 10.0, 0);
+sessionBuffer.delete();
+let status;
+do {
+  status = session.step(1);
+  if (status.progress < 0 || status.progress > 1) throw new Error("Bad session progress.");
+} while (!status.done);
+const sliced = session.result();
+if (sliced.packCount !== planned.packCount) throw new Error("Session pack count differs.");
+session.delete();
+console.log("\n⏱️ PlanningSession finished:", { packCount: sliced.packCount });
+
+// Background plan on the persistent worker pool
+if (Module.prewarmWorkers() < 1) throw new Error("Worker pool failed to start.");
+const bgBuffer = new Module.ItemBuffer();
+bgBuffer.assign(ids, lengths, quantities, weights);
+const background = new Module.BackgroundPlan(bgBuffer, 10, 10.0, 0, 1, 4);
+bgBuffer.delete();
+while (!background.isDone()) {
+  await new Promise((resolve) => setTimeout(resolve, 1));
+}
+const bgResult = background.result();
+if (bgResult.totalItems !== stats.totalItems) throw new Error("BackgroundPlan stats differ.");
+background.delete();
+console.log("\n🧵 BackgroundPlan finished:", { packCount: bgResult.packCount });
+
+// Cost-model routing lives in the separately loaded profiler module
+const ProfilerModule = await createProfiler();
+if (Module.SystemProfiler !== undefined) throw new Error("Planner module still bundles the profiler.");
+const profiler = new ProfilerModule.SystemProfiler();
+const profile = profiler.profileSystem();
+if (!(profile.cpuScore > 0)) throw new Error("Calibration produced no throughput.");
+const small = profiler.routePlan(100, 0, 50.0, 10.0);
+const large = profiler.routePlan(10000000, 0, 50.0, 10.0);
+if (large.predictedClientMs < small.predictedClientMs) throw new Error("Cost model not monotonic.");
+profiler.delete();
+console.log("\n📈 Routing:", { small: small.recommendation, large: large.recommendation });
+
 console.log("\n✅ All checks passed.");
+
+// Pooled worker threads stay alive by design; end the process explicitly
+process.exit(0);
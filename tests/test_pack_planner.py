@@ -0,0 +1,131 @@
+"""Smoke test for the pack_planner Python extension (-DPACK_PLANNER_PYTHON=ON)."""
+
+import array
+import sys
+import threading
+
+import pack_planner
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+
+def columns(count):
+    ids = array.array("i", range(1000, 1000 + count))
+    lengths = array.array("i", (100 + (i * 37) % 900 for i in range(count)))
+    quantities = array.array("i", (1 + i % 9 for i in range(count)))
+    weights = array.array("d", (0.5 + (i % 7) * 0.75 for i in range(count)))
+    return ids, lengths, quantities, weights
+
+
+def check_plan(ids, lengths, quantities, weights, **options):
+    planned = pack_planner.plan(ids, lengths, quantities, weights, **options)
+
+    pack_index = list(planned["pack_index"])
+    item_index = list(planned["item_index"])
+    item_id = list(planned["item_id"])
+    quantity = list(planned["quantity"])
+    pack_weights = list(planned["pack_weights"])
+
+    if not (len(pack_index) == len(item_index) == len(item_id) == len(quantity)):
+        raise AssertionError("Line columns differ in length.")
+    if pack_index != sorted(pack_index) or (pack_index and pack_index[-1] != len(pack_weights) - 1):
+        raise AssertionError("Pack index is not dense and ordered.")
+    if any(ids[row] != line_id for row, line_id in zip(item_index, item_id)):
+        raise AssertionError("item_id does not match ids[item_index].")
+
+    # Every input unit is packed exactly once
+    packed = [0] * len(ids)
+    for row, q in zip(item_index, quantity):
+        packed[row] += q
+    if packed != list(quantities):
+        raise AssertionError("Packed quantities differ from the input.")
+    if sum(quantity) != planned["total_items"]:
+        raise AssertionError("total_items differs from the quantity column.")
+    return planned
+
+
+ids, lengths, quantities, weights = columns(500)
+for strategy in range(4):
+    for sort_order in range(6):
+        check_plan(ids, lengths, quantities, weights, max_items=12, max_weight=30.0,
+                   sort_order=sort_order, strategy=strategy)
+
+planned = check_plan(ids, lengths, quantities, weights)
+view = memoryview(planned["pack_weights"]) if np is None else planned["pack_weights"]
+if np is None and (view.format != "d" or not view.readonly):
+    raise AssertionError("Result columns must be read-only float64 buffers.")
+
+# 64-bit integer and float32 inputs are read in place as well
+check_plan(array.array("q", ids), array.array("q", lengths), array.array("q", quantities),
+           array.array("f", weights), max_items=12, max_weight=30.0)
+
+if np is not None:
+    frame = {
+        "id": np.arange(1000, 1500, dtype=np.int64),
+        "length": np.asarray(lengths, dtype=np.int64),
+        "quantity": np.asarray(quantities, dtype=np.int32),
+        "weight": np.asarray(weights),
+    }
+    planned = check_plan(frame["id"], frame["length"], frame["quantity"], frame["weight"])
+    if not isinstance(planned["pack_index"], np.ndarray):
+        raise AssertionError("Expected NumPy arrays when NumPy is installed.")
+
+for bad in ((ids, lengths[:10], quantities, weights), (ids, lengths, quantities, array.array("b", [1] * 500))):
+    try:
+        pack_planner.plan(*bad)
+    except (TypeError, ValueError):
+        pass
+    else:
+        raise AssertionError("Invalid columns were accepted.")
+
+# 64-bit values that do not fit the 32-bit item fields are rejected, not wrapped
+for column in range(3):
+    wide = [array.array("q", c) for c in (ids, lengths, quantities)]
+    wide[column][7] = 2**32 + 5
+    try:
+        pack_planner.plan(*wide, weights)
+    except OverflowError:
+        pass
+    else:
+        raise AssertionError("An out-of-range 64-bit value was accepted.")
+
+# Length and volume limits: no pack exceeds max_volume, and volumes must match the other columns
+volumes = array.array("d", (0.1 + (i % 5) * 0.1 for i in range(500)))
+planned = check_plan(ids, lengths, quantities, weights, max_length=1000, max_volume=2.0, volumes=volumes)
+pack_volumes = [0.0] * len(planned["pack_weights"])
+for pack, row, q in zip(planned["pack_index"], planned["item_index"], planned["quantity"]):
+    pack_volumes[pack] += q * volumes[row]
+if max(pack_volumes) > 2.0 + 1e-6:
+    raise AssertionError("A pack exceeds max_volume.")
+try:
+    pack_planner.plan(ids, lengths, quantities, weights, volumes=volumes[:10])
+except ValueError:
+    pass
+else:
+    raise AssertionError("A short volumes column was accepted.")
+
+# Plans release the GIL, so concurrent calls must stay correct
+errors = []
+big = columns(20000)
+
+
+def worker():
+    try:
+        check_plan(*big, max_items=60, max_weight=300.0)
+    except Exception as error:  # noqa: BLE001 - reported below
+        errors.append(error)
+
+
+threads = [threading.Thread(target=worker) for _ in range(4)]
+for thread in threads:
+    thread.start()
+for thread in threads:
+    thread.join()
+if errors:
+    raise errors[0]
+
+print("All checks passed.")
+sys.exit(0)
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "parallel_pack_strategy.h"
+#include "thread_pool.h"
+
+// Thread Pool Tests
+TEST(ThreadPoolTest, RunsEveryTaskOfABatch) {
+    thread_pool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+
+    std::vector<int> hits(1000, 0);
+    pool.run_batch(hits.size(), [&](size_t i) { hits[i]++; });
+    for (int h : hits) {
+        EXPECT_EQ(h, 1);
+    }
+}
+
+TEST(ThreadPoolTest, ReusesWorkersAcrossBatches) {
+    thread_pool pool(2);
+    std::mutex mutex;
+    std::set<std::thread::id> seen;
+
+    for (int round = 0; round < 50; ++round) {
+        pool.run_batch(8, [&](size_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.insert(std::this_thread::get_id());
+        });
+    }
+    // Two workers plus the calling thread, however many batches ran
+    EXPECT_LE(seen.size(), 3u);
+}
+
+TEST(ThreadPoolTest, NestedBatchesDoNotDeadlock) {
+    thread_pool pool(1);
+    std::atomic<int> total{0};
+
+    pool.run_batch(4, [&](size_t) {
+        pool.run_batch(4, [&](size_t) { total++; });
+    });
+    EXPECT_EQ(total.load(), 16);
+}
+
+TEST(ThreadPoolTest, ExceptionIsRethrownAfterTheWholeBatch) {
+    thread_pool pool(3);
+    std::vector<std::atomic<int>> hits(64);
+
+    // Tasks throw on workers and on the helping caller; the rest still run to completion
+    EXPECT_THROW(pool.run_batch(hits.size(), [&](size_t i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        hits[i]++;
+        if (i % 3 == 0) throw std::runtime_error("task " + std::to_string(i));
+    }), std::runtime_error);
+    for (const auto& h : hits) {
+        EXPECT_EQ(h.load(), 1);
+    }
+
+    // The pool survives and runs the next batch
+    std::atomic<int> total{0};
+    pool.run_batch(16, [&](size_t) { total++; });
+    EXPECT_EQ(total.load(), 16);
+}
+
+TEST(ThreadPoolTest, CallerRunsOnlyItsOwnBatch) {
+    thread_pool pool(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<std::thread::id> foreign_thread;
+    auto foreign = foreign_thread.get_future();
+
+    // Occupy the only worker, then queue another request's task ahead of the batch
+    pool.submit([released] { released.wait(); });
+    pool.submit([&] { foreign_thread.set_value(std::this_thread::get_id()); });
+
+    std::atomic<int> total{0};
+    pool.run_batch(4, [&](size_t) { total++; });
+    EXPECT_EQ(total.load(), 4);
+    EXPECT_EQ(foreign.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+
+    release.set_value();
+    ASSERT_EQ(foreign.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_NE(foreign.get(), std::this_thread::get_id());
+}
+
+TEST(ThreadPoolTest, SubmitRunsInBackground) {
+    thread_pool pool(1);
+    std::promise<int> promise;
+    auto future = promise.get_future();
+
+    pool.submit([&] { promise.set_value(42); });
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPoolTest, ParallelStrategyStableAcrossCalls) {
+    std::vector<item> items;
+    for (int i = 0; i < 20000; ++i) {
+        items.emplace_back(i, 100 + i % 900, 1 + i % 13, 0.5 + (i % 5));
+    }
+
+    parallel_pack_strategy strategy(4);
+    const auto first = strategy.pack_items(items, 20, 80.0);
+
+    int first_total = 0;
+    for (const auto& p : first) first_total += p.get_total_items();
+
+    for (int round = 0; round < 20; ++round) {
+        const auto packs = strategy.pack_items(items, 20, 80.0);
+        int total = 0;
+        for (const auto& p : packs) total += p.get_total_items();
+        EXPECT_EQ(packs.size(), first.size());
+        EXPECT_EQ(total, first_total);
+    }
+}